@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    AutoDJ.cpp
+    Created: 20 Oct 2026 2:14:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "AutoDJ.h"
+
+namespace
+{
+    const double minFadeSeconds = 4.0;
+    const double maxFadeSeconds = 16.0;
+    const int schedulerIntervalMs = 100;
+
+    /** crossfader position that plays only this deck */
+    float sideOf(int deck)
+    {
+        return deck == 0 ? 0.0f : 1.0f;
+    }
+}
+
+AutoDJ::AutoDJ(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& _mixer)
+    : decks{ &deckA, &deckB },
+      mixer(_mixer)
+{
+}
+
+AutoDJ::~AutoDJ()
+{
+    stopTimer();
+}
+
+void AutoDJ::addToQueue(const File& file)
+{
+    if (file.existsAsFile())
+        queue.add(file);
+}
+
+void AutoDJ::removeFromQueue(int index)
+{
+    queue.remove(index);
+}
+
+void AutoDJ::clearQueue()
+{
+    queue.clear();
+}
+
+void AutoDJ::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+
+    if (enabled)
+    {
+        // carry on from whichever deck is already playing
+        if (decks[1]->isPlaying() && !decks[0]->isPlaying())
+            liveDeck = 1;
+
+        startTimer(schedulerIntervalMs);
+        timerCallback();
+    }
+    else
+    {
+        stopTimer();
+
+        // a transition that hasn't started yet is dropped, one that has is left to finish
+        auto expected = (int) armed;
+        state.compare_exchange_strong(expected, (int) idle);
+        standbyFile = File();
+        standbyDeck = -1;
+    }
+}
+
+String AutoDJ::getStatusText() const
+{
+    if (!enabled)
+        return "Auto DJ off";
+
+    String text = "Auto DJ: " + String(queue.size()) + " queued";
+
+    switch (state.load())
+    {
+        case armed:  text << ", next " << standbyFile.getFileNameWithoutExtension(); break;
+        case fading: text << ", mixing"; break;
+        default:     if (standbyFile != File()) text << ", loading " << standbyFile.getFileNameWithoutExtension(); break;
+    }
+
+    return text;
+}
+
+void AutoDJ::prepareToPlay(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+}
+
+//==============================================================================
+void AutoDJ::timerCallback()
+{
+    if (state.load() != idle)
+        return;
+
+    auto live = liveDeck.load();
+    auto& liveTrack = *decks[live];
+
+    // the standby track has gone on air since the last tick
+    if (standbyDeck == live)
+    {
+        standbyFile = File();
+        standbyDeck = -1;
+    }
+
+    if (!liveTrack.isPlaying())
+    {
+        // nothing on air: play the standby track straight away, or fetch one
+        if (standbyFile != File() && decks[1 - live]->isLoaded())
+            startDeck(1 - live);
+        else if (!queue.isEmpty())
+            loadStandby();
+
+        return;
+    }
+
+    if (standbyFile == File())
+        loadStandby();
+    else
+        armTransition();
+}
+
+void AutoDJ::startDeck(int deck)
+{
+    auto& track = *decks[deck];
+    track.setPosition(track.hasMixPoints() ? track.getCueInSeconds() : 0.0);
+    mixer.setCrossfader(sideOf(deck));
+    track.start();
+
+    liveDeck = deck;
+    standbyFile = File();
+    standbyDeck = -1;
+}
+
+void AutoDJ::loadStandby()
+{
+    if (queue.isEmpty() || onLoadDeck == nullptr)
+        return;
+
+    standbyFile = queue.removeAndReturn(0);
+    standbyDeck = 1 - liveDeck.load();
+    onLoadDeck(standbyDeck, standbyFile);
+}
+
+void AutoDJ::armTransition()
+{
+    auto live = liveDeck.load();
+    auto& outgoing = *decks[live];
+    auto& incoming = *decks[1 - live];
+
+    if (!outgoing.hasMixPoints() || !incoming.hasMixPoints())
+        return;
+
+    // the fade covers the shorter of the incoming intro and the outgoing outro
+    auto intro = incoming.getIntroEndSeconds() - incoming.getCueInSeconds();
+    auto outro = outgoing.getCueOutSeconds() - outgoing.getOutroStartSeconds();
+    auto fadeSeconds = jlimit(minFadeSeconds, maxFadeSeconds, jmin(intro, outro));
+
+    // start early enough that the outgoing track is still playing when the fade ends
+    auto speed = jmax(0.01, outgoing.getSpeed());
+    auto trigger = jmin(outgoing.getOutroStartSeconds(), outgoing.getCueOutSeconds() - fadeSeconds * speed);
+
+    // cueing now gets the incoming windows buffered long before they're needed
+    incoming.cueAt(incoming.getCueInSeconds());
+
+    triggerSeconds = jmax(0.0, trigger);
+    fadeLength = jmax<int64>(1, (int64) (fadeSeconds * sampleRate));
+    state = armed;
+}
+
+//==============================================================================
+int AutoDJ::getNextSegment(int numSamplesLeft)
+{
+    auto live = liveDeck.load();
+
+    if (state.load() == armed)
+    {
+        auto& outgoing = *decks[live];
+        int64 samplesUntilTrigger = 0;
+
+        if (outgoing.isPlaying())
+            samplesUntilTrigger = (int64) std::ceil((triggerSeconds.load() - outgoing.getCurrentPosition())
+                                                    * sampleRate / jmax(0.01, outgoing.getSpeed()));
+
+        if (samplesUntilTrigger > 0)
+            return (int) jmin<int64>(numSamplesLeft, samplesUntilTrigger);
+
+        // the mix point is on this sample
+        auto expected = (int) armed;
+        if (!state.compare_exchange_strong(expected, (int) fading))
+            return numSamplesLeft;
+
+        fadePosition = 0;
+        fadeFrom = mixer.getCrossfader();
+        decks[1 - live]->start();
+    }
+
+    if (state.load() != fading)
+        return numSamplesLeft;
+
+    // the mixer ramps to this position over the segment, so it is exact at every boundary
+    auto length = fadeLength.load();
+    auto segment = (int) jmin<int64>(numSamplesLeft, length - fadePosition);
+    fadePosition += segment;
+
+    auto progress = (float) fadePosition / (float) length;
+    mixer.setCrossfader(fadeFrom + (sideOf(1 - live) - fadeFrom) * progress);
+
+    if (fadePosition >= length)
+    {
+        decks[live]->stop();
+        liveDeck = 1 - live;
+        state = idle;
+    }
+
+    return jmax(1, segment);
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    AutoDJ.h
+    Created: 20 Oct 2026 2:14:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+#include "DJMixer.h"
+
+//==============================================================================
+/*
+    A play queue and an automix scheduler for two decks, deck 0 on the left of
+    the crossfader and deck 1 on the right.
+
+    The message thread does the slow parts well ahead of time: as soon as one
+    deck is live, the next queued track is loaded onto the other deck, cued to
+    where it becomes audible so its windows are buffered, and once both tracks
+    are analysed the transition is armed from their intro and outro.
+
+    The audio thread then runs the transition itself. getNextSegment() tells
+    the engine how far it can render before the next event, so the incoming
+    deck starts on the exact sample the outgoing one reaches its mix point,
+    and the crossfader is moved at every segment boundary from there.
+    Starting and stopping a deck only sets its playing flag, which the deck
+    reads at the start of its next block, so nothing here waits on the audio
+    thread's own callback.
+*/
+class AutoDJ : private Timer
+{
+public:
+    AutoDJ(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& mixer);
+    ~AutoDJ() override;
+
+    void addToQueue(const File& file);
+    void removeFromQueue(int index);
+    void clearQueue();
+    const Array<File>& getQueue() const { return queue; }
+
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled; }
+
+    /** one line about what the scheduler is doing, for the status bar */
+    String getStatusText() const;
+
+    /** asks the UI to load a file onto a deck without starting it; called on the message thread */
+    std::function<void(int deck, const File& file)> onLoadDeck;
+
+    void prepareToPlay(double sampleRate);
+
+    /** audio thread: applies any event due now and returns how many of the
+        remaining samples can be rendered before the next one */
+    int getNextSegment(int numSamplesLeft);
+
+private:
+    enum State { idle, armed, fading };
+
+    void timerCallback() override;
+    void startDeck(int deck);
+    void loadStandby();
+    void armTransition();
+
+    DJAudioPlayer* decks[2];
+    DJMixer& mixer;
+
+    Array<File> queue;
+    File standbyFile;
+    int standbyDeck = -1;
+    bool enabled = false;
+
+    // shared with the audio thread
+    std::atomic<int> state{ idle };
+    std::atomic<int> liveDeck{ 0 };
+    std::atomic<double> triggerSeconds{ 0.0 };
+    std::atomic<int64> fadeLength{ 0 };
+    double sampleRate = 44100.0;
+
+    // audio thread only
+    int64 fadePosition = 0;
+    float fadeFrom = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoDJ)
+};
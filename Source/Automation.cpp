@@ -0,0 +1,644 @@
+/*
+  ==============================================================================
+
+    Automation.cpp
+    Created: 26 Oct 2026 11:24:37am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "Automation.h"
+#include "Tracer.h"
+
+namespace
+{
+    const char fileMagic[] = { 'O', 'T', 'O', 'A' };
+    const int fileVersion = 1;
+
+    // offline, how far ahead each playing deck is decoded before a block is rendered
+    const double renderAheadSeconds = 0.1;
+    const int renderBlockSize = 512;
+    const int bufferTimeoutMs = 5000;
+
+    using Action = Automation::Action;
+
+    enum class ValueKind { none, flag, level, time };
+
+    ValueKind getValueKind(Action action)
+    {
+        switch (action)
+        {
+            case Action::sync: case Action::reverse: case Action::pfl:
+                return ValueKind::flag;
+
+            case Action::queue: case Action::gain: case Action::speed:
+            case Action::crossfader: case Action::eq: case Action::filter: case Action::cueMix:
+                return ValueKind::level;
+
+            case Action::seek: case Action::cue: case Action::hotCueSet: case Action::scratchTo:
+                return ValueKind::time;
+
+            default:
+                return ValueKind::none;
+        }
+    }
+
+    bool hasIndex(Action action)
+    {
+        return action == Action::load || action == Action::queue || action == Action::hotCueSet
+            || action == Action::hotCueClear || action == Action::eq;
+    }
+
+    /** controls that report every position they pass through, so repeats are dropped */
+    bool isContinuous(Action action)
+    {
+        return getValueKind(action) == ValueKind::level && action != Action::queue;
+    }
+
+    void writeVarint(OutputStream& out, uint64 value)
+    {
+        while (value >= 0x80)
+        {
+            out.writeByte((char) ((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+
+        out.writeByte((char) value);
+    }
+
+    uint64 readVarint(InputStream& in)
+    {
+        uint64 value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            auto byte = (uint8) in.readByte();
+            value |= (uint64) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        return value;
+    }
+}
+
+//==============================================================================
+Automation::Automation(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& _mixer, MasterClock& _clock)
+    : MemoryBudget::Consumer("Automation", MemoryBudget::Cost::analyse),
+      decks{ &deckA, &deckB },
+      mixer(_mixer),
+      clock(_clock)
+{
+    addToBudget();
+}
+
+Automation::~Automation()
+{
+    removeFromBudget();
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+bool Automation::startRecording()
+{
+    if (playing.load() || recording.load())
+        return false;
+
+    // nothing reads the timeline while neither recording nor playing, so it can grow here
+    if (timeline.size() < (size_t) maxEvents)
+        timeline.resize((size_t) maxEvents);
+
+    {
+        const SpinLock::ScopedLockType sl(lock);
+        numEvents = 0;
+
+        for (auto& action : lastValues)
+            for (auto& deck : action)
+                for (auto& value : deck)
+                    value = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    numDropped = 0;
+    tracks.clear();
+    recordedSampleRate = clock.getSampleRate();
+    recordedLength = 0;
+    recordStart = clock.getSamplePosition();
+    recording = true;
+
+    // where everything stands now, so playback starts from the same place
+    for (int i = 0; i < numDecks; ++i)
+    {
+        auto& deck = *decks[i];
+
+        if (deck.isLoaded())
+        {
+            recordTrack(Action::load, i, deck.getLoadedURL(), 0.0);
+
+            for (int cue = 0; cue < CueWindowSource::maxCues; ++cue)
+                if (deck.hasHotCue(cue))
+                    append({ 0, deck.getHotCue(cue), (uint16) cue, Action::hotCueSet, (uint8) i });
+
+            append({ 0, deck.getCurrentPosition(), 0, Action::seek, (uint8) i });
+        }
+
+        append({ 0, deck.getGain(), 0, Action::gain, (uint8) i });
+        append({ 0, deck.getSpeedSetting(), 0, Action::speed, (uint8) i });
+        append({ 0, deck.isSyncEnabled() ? 1.0 : 0.0, 0, Action::sync, (uint8) i });
+        append({ 0, deck.isReverse() ? 1.0 : 0.0, 0, Action::reverse, (uint8) i });
+
+        for (int band = 0; band < DeckEQ::numBands; ++band)
+            append({ 0, mixer.getBandGain(i, (DeckEQ::Band) band), (uint16) band, Action::eq, (uint8) i });
+
+        append({ 0, mixer.getFilter(i), 0, Action::filter, (uint8) i });
+        append({ 0, mixer.isPfl(i) ? 1.0 : 0.0, 0, Action::pfl, (uint8) i });
+    }
+
+    append({ 0, mixer.getCrossfader(), 0, Action::crossfader, 0 });
+    append({ 0, mixer.getCueMix(), 0, Action::cueMix, 0 });
+
+    for (int i = 0; i < numDecks; ++i)
+    {
+        if (decks[i]->isMaster())
+            append({ 0, 0.0, 0, Action::master, (uint8) i });
+
+        if (decks[i]->isPlaying())
+            append({ 0, 0.0, 0, Action::play, (uint8) i });
+    }
+
+    DBG("Automation - Recording");
+    return true;
+}
+
+void Automation::stopRecording()
+{
+    if (!recording.exchange(false))
+        return;
+
+    recordedLength = jmax<int64>(0, clock.getSamplePosition() - recordStart);
+
+    // a change from the message thread may have been stamped just ahead of one from the audio thread
+    const SpinLock::ScopedLockType sl(lock);
+    std::stable_sort(timeline.begin(), timeline.begin() + numEvents,
+                     [](const Event& a, const Event& b) { return a.sample < b.sample; });
+
+    DBG("Automation - Recorded " + String(numEvents) + " events over " + String(getLengthSeconds(), 1) + " s"
+        + (numDropped.load() > 0 ? ", " + String(numDropped.load()) + " dropped" : String()));
+}
+
+void Automation::record(Action action, int deck, int index, double value)
+{
+    if (!recording.load())
+        return;
+
+    append({ jmax<int64>(0, clock.getSamplePosition() - recordStart), value, (uint16) index, action, (uint8) deck });
+}
+
+void Automation::recordTrack(Action action, int deck, const URL& url, double value)
+{
+    if (!recording.load())
+        return;
+
+    // only ever touched on the message thread
+    auto path = url.toString(false);
+    auto index = tracks.indexOf(path);
+
+    if (index < 0)
+    {
+        index = tracks.size();
+        tracks.add(path);
+    }
+
+    append({ jmax<int64>(0, clock.getSamplePosition() - recordStart), value, (uint16) index, action, (uint8) deck });
+}
+
+void Automation::append(const Event& event)
+{
+    if (event.deck >= DJMixer::maxDecks)
+        return;
+
+    const SpinLock::ScopedLockType sl(lock);
+
+    if (isContinuous(event.action))
+    {
+        auto& last = lastValues[(int) event.action][event.deck][jmin((int) event.index, DeckEQ::numBands - 1)];
+
+        if (last == event.value)
+            return;
+
+        last = event.value;
+    }
+
+    if (numEvents >= (int) timeline.size())
+    {
+        ++numDropped;
+        return;
+    }
+
+    timeline[(size_t) numEvents++] = event;
+}
+
+double Automation::getLengthSeconds() const
+{
+    return recordedSampleRate > 0.0 ? (double) recordedLength / recordedSampleRate : 0.0;
+}
+
+size_t Automation::getUsedBytes() const
+{
+    size_t trackBytes = 0;
+
+    for (auto& track : tracks)
+        trackBytes += (size_t) track.getNumBytesAsUTF8();
+
+    return timeline.capacity() * sizeof(Event) + trackBytes;
+}
+
+//==============================================================================
+bool Automation::save(const File& file) const
+{
+    TemporaryFile temp(file);
+
+    {
+        FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+            return false;
+
+        out.write(fileMagic, sizeof(fileMagic));
+        out.writeInt(fileVersion);
+        out.writeDouble(recordedSampleRate);
+        out.writeInt64(recordedLength);
+
+        out.writeInt(tracks.size());
+        for (auto& track : tracks)
+            out.writeString(track);
+
+        out.writeInt(numEvents);
+        int64 previous = 0;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto& event = timeline[(size_t) i];
+
+            writeVarint(out, (uint64) (event.sample - previous));
+            previous = event.sample;
+
+            out.writeByte((char) event.action);
+            out.writeByte((char) event.deck);
+
+            if (hasIndex(event.action))
+                out.writeCompressedInt(event.index);
+
+            switch (getValueKind(event.action))
+            {
+                case ValueKind::flag:  out.writeByte(event.value != 0.0 ? 1 : 0); break;
+                case ValueKind::level: out.writeFloat((float) event.value); break;
+                case ValueKind::time:  out.writeDouble(event.value); break;
+                case ValueKind::none:  break;
+            }
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    auto written = temp.overwriteTargetFileWithTemporary();
+    DBG("Automation - " + String(written ? "Wrote " : "Couldn't write ") + file.getFullPathName());
+    return written;
+}
+
+bool Automation::load(const File& file)
+{
+    if (recording.load() || playing.load())
+        return false;
+
+    FileInputStream in(file);
+
+    if (!in.openedOk())
+        return false;
+
+    char magic[sizeof(fileMagic)];
+
+    if (in.read(magic, sizeof(magic)) != (int) sizeof(magic) || memcmp(magic, fileMagic, sizeof(magic)) != 0
+        || in.readInt() != fileVersion)
+        return false;
+
+    auto sampleRate = in.readDouble();
+    auto length = in.readInt64();
+    auto numTracks = in.readInt();
+
+    if (sampleRate <= 0.0 || length < 0 || !isPositiveAndBelow(numTracks, 65536))
+        return false;
+
+    StringArray newTracks;
+    for (int i = 0; i < numTracks; ++i)
+        newTracks.add(in.readString());
+
+    auto count = in.readInt();
+
+    if (count < 0 || count > maxEvents)
+        return false;
+
+    std::vector<Event> newTimeline((size_t) count);
+    int64 sample = 0;
+
+    for (auto& event : newTimeline)
+    {
+        sample += (int64) readVarint(in);
+        auto action = (uint8) in.readByte();
+        auto deck = (uint8) in.readByte();
+
+        if (action >= (uint8) Action::numActions || deck >= DJMixer::maxDecks)
+            return false;
+
+        event.sample = sample;
+        event.action = (Action) action;
+        event.deck = deck;
+        event.index = hasIndex(event.action) ? (uint16) in.readCompressedInt() : 0;
+
+        switch (getValueKind(event.action))
+        {
+            case ValueKind::flag:  event.value = in.readByte() != 0 ? 1.0 : 0.0; break;
+            case ValueKind::level: event.value = in.readFloat(); break;
+            case ValueKind::time:  event.value = in.readDouble(); break;
+            case ValueKind::none:  event.value = 0.0; break;
+        }
+
+        if ((event.action == Action::load || event.action == Action::queue) && event.index >= numTracks)
+            return false;
+    }
+
+    if (in.getStatus().failed())
+        return false;
+
+    {
+        const SpinLock::ScopedLockType sl(lock);
+        std::swap(timeline, newTimeline);
+        numEvents = count;
+    }
+
+    // the old timeline is freed here, outside the lock
+    tracks = newTracks;
+    recordedSampleRate = sampleRate;
+    recordedLength = length;
+    numDropped = 0;
+
+    DBG("Automation - Loaded " + String(numEvents) + " events from " + file.getFileName());
+    return true;
+}
+
+//==============================================================================
+bool Automation::startPlayback()
+{
+    if (recording.load() || numEvents == 0)
+        return false;
+
+    cancelPendingUpdate();
+
+    const SpinLock::ScopedLockType sl(lock);
+    nextEvent = 0;
+    heldSamples = 0;
+    pendingLoad = -1;
+    outputRatio = clock.getSampleRate() / recordedSampleRate;
+    startPending = true;
+    playing = true;
+    return true;
+}
+
+void Automation::stopPlayback()
+{
+    playing = false;
+    pendingLoad = -1;
+    cancelPendingUpdate();
+}
+
+int64 Automation::toOutputSamples(int64 recordedSample) const
+{
+    return (int64) std::llround((double) recordedSample * outputRatio);
+}
+
+int Automation::applyEvents(int numSamplesLeft)
+{
+    if (!playing.load())
+        return numSamplesLeft;
+
+    const SpinLock::ScopedTryLockType sl(lock);
+
+    if (!sl.isLocked())
+        return numSamplesLeft;
+
+    auto now = clock.getSamplePosition();
+
+    if (startPending.exchange(false))
+        playbackStart = now;
+
+    // the timeline stands still while the message thread loads a track
+    if (pendingLoad.load() >= 0)
+    {
+        heldSamples += numSamplesLeft;
+        return numSamplesLeft;
+    }
+
+    auto position = now - playbackStart - heldSamples;
+
+    for (; nextEvent < numEvents; ++nextEvent)
+    {
+        auto& event = timeline[(size_t) nextEvent];
+        auto due = toOutputSamples(event.sample);
+
+        if (due > position)
+            return (int) jmin<int64>(numSamplesLeft, due - position);
+
+        if (!offline && (event.action == Action::load || event.action == Action::queue))
+        {
+            pendingLoad = nextEvent++;
+            triggerAsyncUpdate();
+            heldSamples += numSamplesLeft;
+            return numSamplesLeft;
+        }
+
+        if (event.action == Action::load || event.action == Action::queue)
+            applyTrack(event);
+        else
+            apply(event);
+    }
+
+    if (position >= toOutputSamples(recordedLength))
+        playing = false;
+
+    return numSamplesLeft;
+}
+
+void Automation::handleAsyncUpdate()
+{
+    auto index = pendingLoad.load();
+
+    if (index < 0 || !playing.load())
+        return;
+
+    auto event = timeline[(size_t) index];
+    applyTrack(event);
+
+    if (onDeckLoaded)
+        onDeckLoaded(event.deck);
+
+    pendingLoad = -1;
+}
+
+void Automation::apply(const Event& event)
+{
+    auto deck = (int) event.deck;
+    auto value = event.value;
+
+    // the mixer's events are by its own deck index
+    switch (event.action)
+    {
+        case Action::crossfader: mixer.setCrossfader((float) value); return;
+        case Action::eq:         mixer.setBandGain(deck, (DeckEQ::Band) event.index, (float) value); return;
+        case Action::filter:     mixer.setFilter(deck, (float) value); return;
+        case Action::pfl:        mixer.setPfl(deck, value != 0.0); return;
+        case Action::cueMix:     mixer.setCueMix((float) value); return;
+        default:                 break;
+    }
+
+    if (deck >= numDecks)
+        return;
+
+    auto& player = *decks[deck];
+
+    switch (event.action)
+    {
+        case Action::play:         player.start(); break;
+        case Action::stop:         player.stop(); break;
+        case Action::seek:         player.setPosition(value); break;
+        case Action::cue:          player.cueAt(value); break;
+        case Action::gain:         player.setGain(value); break;
+        case Action::speed:        player.setSpeed(value); break;
+        case Action::sync:         player.setSyncEnabled(value != 0.0); break;
+        case Action::master:       player.makeMaster(); break;
+        case Action::reverse:      player.setReverse(value != 0.0); break;
+        case Action::hotCueSet:    player.setHotCueAt(event.index, value); break;
+        case Action::hotCueClear:  player.clearHotCue(event.index); break;
+        case Action::scratchBegin: player.beginScratch(); break;
+        case Action::scratchTo:    player.scratchTo(value); break;
+        case Action::scratchEnd:   player.endScratch(); break;
+        default:                   break;
+    }
+}
+
+void Automation::applyTrack(const Event& event)
+{
+    if (event.deck >= numDecks || event.index >= tracks.size())
+        return;
+
+    TRACE_SPAN("Automation::applyTrack");
+
+    auto& player = *decks[event.deck];
+    URL url(tracks[event.index]);
+
+    if (event.action == Action::load)
+        player.loadURL(url);
+    else
+        player.queueNext(url, event.value);
+
+    if (!offline)
+        return;
+
+    // offline there is time to wait, so the tempo and beat grid are there before anything plays
+    player.waitUntilBuffered(renderAheadSeconds, bufferTimeoutMs);
+
+    while (player.isAnalysing())
+        Thread::sleep(5);
+}
+
+//==============================================================================
+int Automation::render(const File& automationFile, const File& outputFile, double sampleRate)
+{
+    std::cout << "OtoDecks automation render" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    MasterClock clock;
+    DJAudioPlayer deckA(formatManager), deckB(formatManager);
+    deckA.setMasterClock(&clock);
+    deckB.setMasterClock(&clock);
+    deckA.makeMaster();
+
+    DJMixer mixer;
+    mixer.addDeck(&deckA, DJMixer::CrossfaderSide::left);
+    mixer.addDeck(&deckB, DJMixer::CrossfaderSide::right);
+
+    Automation automation(deckA, deckB, mixer, clock);
+
+    if (!automation.load(automationFile))
+    {
+        std::cout << "FAILED: couldn't read " << automationFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (sampleRate <= 0.0)
+        sampleRate = automation.recordedSampleRate;
+
+    outputFile.deleteFile();
+    WavAudioFormat wav;
+    std::unique_ptr<FileOutputStream> stream(new FileOutputStream(outputFile));
+    std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+
+    if (writer == nullptr)
+    {
+        std::cout << "FAILED: couldn't write " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    stream.release(); // the writer owns it now
+
+    clock.prepareToPlay(sampleRate);
+    mixer.prepareToPlay(renderBlockSize, sampleRate);
+
+    automation.offline = true;
+    automation.startPlayback();
+
+    auto totalSamples = (int64) std::llround(automation.getLengthSeconds() * sampleRate);
+    std::cout << "  " << automation.getNumEvents() << " events, " << automation.getLengthSeconds() << " s at "
+              << sampleRate << " Hz" << std::endl;
+
+    AudioBuffer<float> block(2, renderBlockSize);
+    DJAudioPlayer* players[] = { &deckA, &deckB };
+
+    for (int64 rendered = 0; rendered < totalSamples;)
+    {
+        auto numSamples = (int) jmin<int64>(renderBlockSize, totalSamples - rendered);
+        block.clear();
+
+        // the read-ahead is in step with the render, so the same file renders the same every time
+        for (auto* player : players)
+            if (player->isPlaying())
+                player->waitUntilBuffered(renderAheadSeconds, bufferTimeoutMs);
+
+        // render up to each event so it lands on its own sample, as live
+        for (int done = 0; done < numSamples;)
+        {
+            auto numThisTime = automation.applyEvents(numSamples - done);
+            AudioSourceChannelInfo segment(&block, done, numThisTime);
+
+            clock.beginBlock(numThisTime);
+            mixer.getNextAudioBlock(segment);
+            clock.endBlock(numThisTime);
+
+            done += numThisTime;
+        }
+
+        writer->writeFromAudioSampleBuffer(block, 0, numSamples);
+        rendered += numSamples;
+    }
+
+    mixer.releaseResources();
+    writer.reset();
+
+    std::cout << "Wrote " << outputFile.getFullPathName() << std::endl;
+    return 0;
+}
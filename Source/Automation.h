@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    Automation.h
+    Created: 26 Oct 2026 11:24:37am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+#include "DJMixer.h"
+#include "MasterClock.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    Records every control change of a mix, and plays it back.
+
+    While recording, the decks and the mixer report each change as it is made,
+    from the GUI, MIDI or Auto DJ: loads, transport, seeks, gain, speed, sync,
+    hot cues, scratching, the crossfader, EQ, filters and PFL. Each is stamped
+    with the master clock's sample position, so a change made on the audio
+    thread lands on the sample it took effect. A change from the message thread
+    lands at the start of the next block, where the audio thread picks it up.
+    Recording starts with the decks' and mixer's state as events at sample 0.
+
+    Events go into a timeline preallocated when recording starts. A fader that
+    reports the value it already had adds nothing. The file is binary: sample
+    deltas as varints, and only the fields each kind of event uses.
+
+    Playback is applied by the audio thread, in the same loop as MIDI and Auto
+    DJ: applyEvents() applies what is due and says how far the engine can
+    render before the next event, so every event lands on its own sample. A
+    load can't be done on the audio thread; live, it is handed to the message
+    thread and the timeline waits for it, so later events move by however long
+    the load took. Cues and hot cues only leave a position for the deck's
+    background thread, so they are applied on the audio thread like the rest.
+    render() plays a file back offline with no such gaps, at any sample rate,
+    waiting for each deck's read-ahead and analysis as it goes.
+*/
+class Automation : private AsyncUpdater,
+                   private MemoryBudget::Consumer
+{
+public:
+    enum class Action : uint8
+    {
+        // decks
+        load, queue, play, stop, seek, cue, gain, speed, sync, master, reverse,
+        hotCueSet, hotCueClear, scratchBegin, scratchTo, scratchEnd,
+        // mixer, by the mixer's deck index
+        crossfader, eq, filter, pfl, cueMix,
+        numActions
+    };
+
+    struct Event
+    {
+        int64 sample;   // since recording started, at the recording's sample rate
+        double value;
+        uint16 index;   // hot cue, EQ band, or the track of a load or queue
+        Action action;
+        uint8 deck;
+    };
+
+    static constexpr int numDecks = 2;
+    static constexpr int maxEvents = 1 << 20;
+
+    Automation(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& mixer, MasterClock& clock);
+    ~Automation() override;
+
+    //==============================================================================
+    /** message thread: clears the timeline and records from the current state; false
+        while playing back */
+    bool startRecording();
+    void stopRecording();
+    bool isRecording() const { return recording.load(); }
+
+    /** any thread: called by the decks and the mixer for each change */
+    void record(Action action, int deck, int index, double value);
+    /** message thread: a load or queue, called by a deck with its track */
+    void recordTrack(Action action, int deck, const URL& url, double value);
+
+    int getNumEvents() const { return numEvents; }
+    /** events that didn't fit in the timeline */
+    int getNumDropped() const { return numDropped.load(); }
+    double getLengthSeconds() const;
+
+    //==============================================================================
+    bool save(const File& file) const;
+    /** message thread: replaces the timeline; false if the file can't be read, or
+        while recording or playing back */
+    bool load(const File& file);
+    static String getFileExtension() { return ".otoa"; }
+
+    //==============================================================================
+    /** message thread: plays the timeline from the start on the next block */
+    bool startPlayback();
+    void stopPlayback();
+    /** false once stopped or past the last event */
+    bool isPlayingBack() const { return playing.load(); }
+
+    /** audio thread: applies the events due now and returns how many of the
+        remaining samples can be rendered before the next one */
+    int applyEvents(int numSamplesLeft);
+
+    /** called on the message thread after playback has loaded a track onto a deck */
+    std::function<void(int deck)> onDeckLoaded;
+
+    /** headless: plays an automation file back through fresh decks and a mixer,
+        writing 32-bit float WAV at sampleRate, or at the recording's rate if that
+        is 0; returns the process exit code */
+    static int render(const File& automationFile, const File& outputFile, double sampleRate);
+
+    /** the timeline and the tracks it loads */
+    size_t getUsedBytes() const override;
+
+private:
+    void handleAsyncUpdate() override;
+    void apply(const Event& event);
+    /** a load or queue; offline, also waits for the deck to buffer and analyse */
+    void applyTrack(const Event& event);
+    void append(const Event& event);
+    int64 toOutputSamples(int64 recordedSample) const;
+
+    DJAudioPlayer* decks[numDecks];
+    DJMixer& mixer;
+    MasterClock& clock;
+
+    // guards the timeline; the audio thread only ever tries it while playing back
+    SpinLock lock;
+    std::vector<Event> timeline;
+    int numEvents = 0;
+    std::atomic<int> numDropped{ 0 };
+    StringArray tracks;
+    double recordedSampleRate = 44100.0;
+    int64 recordedLength = 0;
+    double lastValues[(int) Action::numActions][DJMixer::maxDecks][DeckEQ::numBands];
+
+    std::atomic<bool> recording{ false };
+    int64 recordStart = 0;
+
+    std::atomic<bool> playing{ false };
+    std::atomic<bool> startPending{ false };
+    std::atomic<int> pendingLoad{ -1 };
+    bool offline = false;
+    double outputRatio = 1.0;
+
+    // audio thread only, while playing back
+    int nextEvent = 0;
+    int64 playbackStart = 0;
+    int64 heldSamples = 0;  // rendered while a live load was waited for
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Automation)
+};
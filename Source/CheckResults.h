@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    CheckResults.h
+    Created: 27 Oct 2026 3:05:12pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    What one of the headless checks found, shared by all of them so they
+    report the same way.
+
+    Each failure is printed as "FAILED: ..." when it is found. finish() ends
+    the run with PASSED or FAILED and returns the process exit code, which is
+    what ctest goes by. A check that can't run on this machine, such as the
+    MIDI one without the ALSA sequencer, is skipped rather than failed.
+*/
+class CheckResults
+{
+public:
+    /** the exit code of a skipped check; ctest reports it as skipped, not failed */
+    static constexpr int skippedExitCode = 77;
+
+    /** counts and prints a failure unless condition holds; returns condition */
+    bool expect(bool condition, const String& message)
+    {
+        if (!condition)
+            fail(message);
+
+        return condition;
+    }
+
+    void fail(const String& message)
+    {
+        std::cout << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+
+    int getNumFailures() const { return failures; }
+    bool hasPassed() const { return failures == 0; }
+
+    /** prints PASSED or FAILED; returns the process exit code */
+    int finish() const
+    {
+        std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+
+    /** prints why the check can't run here; returns the process exit code */
+    static int skip(const String& reason)
+    {
+        std::cout << "SKIPPED: " << reason << std::endl;
+        return skippedExitCode;
+    }
+
+private:
+    int failures = 0;
+};
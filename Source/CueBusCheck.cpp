@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    CueBusCheck.cpp
+    Created: 27 Oct 2026 9:41:16am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "CueBusCheck.h"
+#include "DJMixer.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const int numBlocks = 200;
+    const float toneLevel = 0.25f;
+
+    // the first half settles the gain ramps and fills the limiter's delay
+    const int settleBlocks = numBlocks / 2;
+    const float silence = 1.0e-4f;
+    const float present = 0.1f;
+
+    /** pulls blocks from the mixer on its own thread, like a device with no hardware behind it */
+    class NullDevice : public Thread
+    {
+    public:
+        NullDevice(AudioSource& _source, int numOutputs)
+            : Thread("Null audio device"), source(_source), capture(numOutputs, (numBlocks - settleBlocks) * blockSize)
+        {
+        }
+
+        void run() override
+        {
+            AudioBuffer<float> block(capture.getNumChannels(), blockSize);
+
+            for (int i = 0; i < numBlocks && !threadShouldExit(); ++i)
+            {
+                block.clear();
+                source.getNextAudioBlock(AudioSourceChannelInfo(&block, 0, blockSize));
+
+                if (i >= settleBlocks)
+                    for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                        capture.copyFrom(channel, (i - settleBlocks) * blockSize, block, channel, 0, blockSize);
+            }
+        }
+
+        /** the loudest sample on a pair of outputs after the mixer settled */
+        float getPeak(int firstChannel) const
+        {
+            return jmax(capture.getMagnitude(firstChannel, 0, capture.getNumSamples()),
+                        capture.getMagnitude(firstChannel + 1, 0, capture.getNumSamples()));
+        }
+
+        /** the largest difference between the master and cue pairs */
+        float getCueDifference() const
+        {
+            auto largest = 0.0f;
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < capture.getNumSamples(); ++i)
+                    largest = jmax(largest, std::abs(capture.getSample(channel, i) - capture.getSample(channel + 2, i)));
+
+            return largest;
+        }
+
+    private:
+        AudioSource& source;
+        AudioBuffer<float> capture;
+    };
+
+    struct Case
+    {
+        const char* name;
+        int numOutputs;
+        bool pfl;
+        float crossfader;
+        float cueMix;
+    };
+
+    /** renders one case through a fresh mixer */
+    void check(CheckResults& results, const Case& setup)
+    {
+        std::cout << "  " << setup.name << std::endl;
+
+        ToneGeneratorAudioSource deckA, deckB;
+        deckA.setFrequency(440.0);
+        deckA.setAmplitude(toneLevel);
+        deckB.setAmplitude(0.0f);
+
+        DJMixer mixer;
+        mixer.addDeck(&deckA, DJMixer::CrossfaderSide::left);
+        mixer.addDeck(&deckB, DJMixer::CrossfaderSide::right);
+        mixer.setCrossfader(setup.crossfader);
+        mixer.setPfl(0, setup.pfl);
+        mixer.setCueMix(setup.cueMix);
+        mixer.prepareToPlay(blockSize, sampleRate);
+
+        NullDevice device(mixer, setup.numOutputs);
+        device.startThread();
+
+        if (!results.expect(device.waitForThreadToExit(10000), "the device thread never finished"))
+        {
+            device.stopThread(1000);
+            return;
+        }
+
+        mixer.releaseResources();
+
+        auto masterPeak = device.getPeak(0);
+        auto cueCentred = setup.crossfader < 1.0f;
+        std::cout << "    master peak " << masterPeak;
+
+        if (setup.numOutputs < 4)
+        {
+            std::cout << std::endl;
+            results.expect(!mixer.isCueBusRouted(), "the mixer reports a cue bus on two outputs");
+            results.expect(cueCentred ? masterPeak > present : masterPeak < silence, "PFL changed the master");
+            return;
+        }
+
+        auto cuePeak = device.getPeak(2);
+        std::cout << ", cue peak " << cuePeak << std::endl;
+        results.expect(mixer.isCueBusRouted(), "the mixer didn't route the cue bus to outputs 3-4");
+
+        if (setup.cueMix >= 1.0f)
+        {
+            results.expect(device.getCueDifference() < silence, "the cue pair doesn't match the master at a cue mix of 1");
+            return;
+        }
+
+        results.expect(cueCentred ? masterPeak > present : masterPeak < silence,
+                       cueCentred ? "deck A is missing from the master" : "PFL audio reached outputs 1-2");
+        results.expect(setup.pfl ? cuePeak > present : cuePeak < silence,
+                       setup.pfl ? "PFL audio is missing from outputs 3-4" : "the cue pair isn't silent with PFL off");
+    }
+}
+
+//==============================================================================
+int CueBusCheck::run()
+{
+    std::cout << "OtoDecks cue bus check, 4 output null device" << std::endl;
+
+    const Case cases[] = {
+        { "PFL on A, crossfader on B, all cue",         4, true,  1.0f, 0.0f },
+        { "PFL off, crossfader centred, all cue",       4, false, 0.5f, 0.0f },
+        { "PFL on A, crossfader centred, all master",   4, true,  0.5f, 1.0f },
+        { "2 outputs, PFL on A, crossfader on B",       2, true,  1.0f, 0.0f },
+    };
+
+    CheckResults results;
+
+    for (auto& setup : cases)
+        check(results, setup);
+
+    return results.finish();
+}
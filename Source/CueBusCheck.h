@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    CueBusCheck.h
+    Created: 27 Oct 2026 9:41:16am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of the mixer's headphone cue routing, started with
+    --cue-check.
+
+    A null device thread with four outputs pulls blocks from a DJMixer, the
+    way the app's device does. Deck A plays a tone and deck B is silent. With
+    the crossfader hard over to B and PFL on A, the tone must reach outputs
+    3-4 and nothing may reach 1-2. Then PFL off leaves the cue pair silent,
+    and a cue mix of all master copies the master into it. On a two output
+    device the mixer reports no cue bus and PFL must not leak into the master.
+*/
+class CueBusCheck
+{
+public:
+    /** runs every case, printing progress; returns the process exit code */
+    static int run();
+};
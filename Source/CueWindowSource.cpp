@@ -0,0 +1,501 @@
+/*
+  ==============================================================================
+
+    CueWindowSource.cpp
+    Created: 19 Oct 2026 10:12:40am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "CueWindowSource.h"
+
+namespace
+{
+    const double windowSeconds = 6.0;
+    const double cuePreRollSeconds = 0.25;
+    const double readAheadSeconds = 2.0;
+    const int stemBlockSamples = 1024;
+    // how often the background thread looks for a read-ahead to move, or a window to fill
+    const int timeSliceIntervalMs = 10;
+}
+
+CueWindowSource::CueWindowSource(AudioFormatReader* streamReader,
+                                 AudioFormatReader* _windowReader,
+                                 TimeSliceThread& backgroundThread)
+    : streamSource(new AudioFormatReaderSource(streamReader, true)),
+      windowReader(_windowReader),
+      thread(backgroundThread),
+      sourceSampleRate(streamReader->sampleRate),
+      totalLength(streamReader->lengthInSamples),
+      windowLength((int) (streamReader->sampleRate * windowSeconds)),
+      readAheadLength(jmax(32768, (int) (streamReader->sampleRate * readAheadSeconds))),
+      cuePreRoll((int) (streamReader->sampleRate * cuePreRollSeconds)),
+      numSourceChannels(2 * StemReader::getNumStems((int) streamReader->numChannels)),
+      numStems(numSourceChannels / 2)
+{
+    // one read-ahead buffer holds every stem, so they all come from the same decode
+    bufferedSource.reset(new BufferingAudioSource(streamSource.get(), thread, false, readAheadLength, numSourceChannels));
+
+    // every window is allocated up front so the background thread never has to
+    for (auto& window : windows)
+        window.buffer.setSize(numSourceChannels, windowLength);
+
+    if (numStems > 1)
+        stemBuffer.setSize(numSourceChannels, stemBlockSamples);
+
+    for (int stem = 0; stem < StemReader::maxStems; ++stem)
+    {
+        stemGains[stem] = 1.0f;
+        appliedStemGains[stem] = 1.0f;
+    }
+
+    thread.addTimeSliceClient(this);
+}
+
+CueWindowSource::~CueWindowSource()
+{
+    thread.removeTimeSliceClient(this);
+}
+
+void CueWindowSource::setCue(int index, int64 samplePosition)
+{
+    if (index < 0 || index >= maxCues)
+        return;
+
+    // picked up on the next time slice, so this is safe from the audio thread too
+    auto wanted = samplePosition < 0 ? -1 : jlimit<int64>(0, totalLength, samplePosition - cuePreRoll);
+    windows[index].wantedStart = wanted;
+}
+
+size_t CueWindowSource::getMemoryBytes() const
+{
+    auto frames = (size_t) windowLength * (size_t) (maxCues + 2) + (size_t) readAheadLength
+                + (size_t) stemBuffer.getNumSamples() + (size_t) crossfadeSamples;
+
+    return frames * (size_t) numSourceChannels * sizeof(float);
+}
+
+void CueWindowSource::setStemGain(int stem, float gain)
+{
+    if (isPositiveAndBelow(stem, numStems))
+        stemGains[stem] = jmax(0.0f, gain);
+}
+
+bool CueWindowSource::isResident(int64 samplePosition) const
+{
+    return findWindowFor(samplePosition) >= 0;
+}
+
+//==============================================================================
+void CueWindowSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    fadeBuffer.setSize(numSourceChannels, crossfadeSamples);
+    bufferedSource->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void CueWindowSource::releaseResources()
+{
+    bufferedSource->releaseResources();
+}
+
+void CueWindowSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    if (numStems == 1)
+    {
+        renderWithJump(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+        return;
+    }
+
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        auto numToRender = jmin(bufferToFill.numSamples - done, stemBuffer.getNumSamples());
+        renderWithJump(stemBuffer, 0, numToRender);
+        mixStems(*bufferToFill.buffer, bufferToFill.startSample + done, numToRender);
+        done += numToRender;
+    }
+}
+
+void CueWindowSource::renderWithJump(AudioBuffer<float>& dest, int startSample, int numSamples)
+{
+    auto jump = pendingJump.exchange(-1);
+
+    if (jump < 0)
+    {
+        render(dest, startSample, numSamples);
+        return;
+    }
+
+    // render a little of where we were, then fade it into where we're going
+    auto fadeLength = jmin(numSamples, fadeBuffer.getNumSamples());
+    if (fadeLength > 0)
+        render(fadeBuffer, 0, fadeLength);
+
+    switchTo(jump);
+    render(dest, startSample, numSamples);
+
+    auto numChannels = jmin(dest.getNumChannels(), fadeBuffer.getNumChannels());
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        dest.applyGainRamp(channel, startSample, fadeLength, 0.0f, 1.0f);
+        dest.addFromWithRamp(channel, startSample, fadeBuffer.getReadPointer(channel), fadeLength, 1.0f, 0.0f);
+    }
+}
+
+void CueWindowSource::mixStems(AudioBuffer<float>& dest, int startSample, int numSamples)
+{
+    // each gain ramps from where it was to where it's been set, so a mute doesn't click
+    float gains[StemReader::maxStems], steps[StemReader::maxStems];
+
+    for (int stem = 0; stem < StemReader::maxStems; ++stem)
+    {
+        auto target = stem < numStems ? stemGains[stem].load() : 0.0f;
+        gains[stem] = stem < numStems ? appliedStemGains[stem] : 0.0f;
+        steps[stem] = (target - gains[stem]) / (float) numSamples;
+        appliedStemGains[stem] = target;
+    }
+
+    auto numOutputs = jmin(2, dest.getNumChannels());
+
+    for (int side = 0; side < numOutputs; ++side)
+    {
+        // a missing stem reads the first one at zero gain, so every track takes the same loop
+        const float* stems[StemReader::maxStems];
+        for (int stem = 0; stem < StemReader::maxStems; ++stem)
+            stems[stem] = stemBuffer.getReadPointer(2 * (stem < numStems ? stem : 0) + side);
+
+        auto* out = dest.getWritePointer(side, startSample);
+
+        // branch free and unrolled across the stems, so the compiler vectorises it
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto t = (float) i;
+            out[i] = (gains[0] + steps[0] * t) * stems[0][i] + (gains[1] + steps[1] * t) * stems[1][i]
+                   + (gains[2] + steps[2] * t) * stems[2][i] + (gains[3] + steps[3] * t) * stems[3][i];
+        }
+    }
+
+    for (int channel = numOutputs; channel < dest.getNumChannels(); ++channel)
+        dest.copyFrom(channel, startSample, dest, 0, startSample, numSamples);
+}
+
+void CueWindowSource::setStartPosition(int64 samplePosition)
+{
+    samplePosition = jlimit<int64>(0, totalLength, samplePosition);
+    pendingJump = -1;
+    playPosition = samplePosition;
+    readAheadTarget = samplePosition;
+}
+
+bool CueWindowSource::waitUntilBuffered(int numSamples, uint32 timeoutMs)
+{
+    auto endTime = Time::getMillisecondCounter() + timeoutMs;
+
+    // the read-ahead has to be at the play position before its contents mean anything
+    while (readAheadTarget.load() >= 0)
+    {
+        if (Time::getMillisecondCounter() >= endTime)
+            return false;
+
+        Thread::sleep(1);
+    }
+
+    AudioSourceChannelInfo info; // only the length is looked at
+    info.numSamples = numSamples;
+    return bufferedSource->waitForNextAudioBlockReady(info, endTime - jmin(endTime, Time::getMillisecondCounter()));
+}
+
+void CueWindowSource::setNextReadPosition(int64 newPosition)
+{
+    pendingJump = jlimit<int64>(0, totalLength, newPosition);
+}
+
+int64 CueWindowSource::getNextReadPosition() const
+{
+    auto jump = pendingJump.load();
+    return jump >= 0 ? jump : playPosition.load();
+}
+
+int64 CueWindowSource::getTotalLength() const
+{
+    return totalLength;
+}
+
+//==============================================================================
+int CueWindowSource::findWindowFor(int64 samplePosition) const
+{
+    for (int i = 0; i < maxCues + 2; ++i)
+    {
+        auto& window = windows[i];
+        auto state = window.state.load();
+
+        if ((state == ready || state == playing)
+            && samplePosition >= window.start
+            && samplePosition < window.start + window.length)
+            return i;
+    }
+
+    return -1;
+}
+
+void CueWindowSource::switchTo(int64 samplePosition)
+{
+    releaseActiveWindow();
+
+    auto index = findWindowFor(samplePosition);
+
+    if (index >= 0)
+    {
+        auto& window = windows[index];
+        int expected = ready;
+
+        if (window.state.compare_exchange_strong(expected, playing))
+        {
+            // the window may have been refilled between the lookup and the claim
+            if (samplePosition >= window.start && samplePosition < window.start + window.length)
+                activeWindow = index;
+            else
+                window.state = ready;
+        }
+    }
+
+    // moved by the background thread, which is free to wait on the buffer's lock
+    if (activeWindow >= 0)
+        readAheadTarget = windows[activeWindow].start + windows[activeWindow].length;
+    else
+        readAheadTarget = samplePosition;
+
+    playPosition = samplePosition;
+}
+
+void CueWindowSource::releaseActiveWindow()
+{
+    if (activeWindow >= 0)
+    {
+        windows[activeWindow].state = ready;
+        activeWindow = -1;
+    }
+}
+
+void CueWindowSource::render(AudioBuffer<float>& dest, int startSample, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        auto position = playPosition.load();
+
+        if (activeWindow < 0)
+        {
+            // until the read-ahead has moved it holds audio from somewhere else; the play
+            // position waits for it, so nothing is skipped once it has
+            if (readAheadTarget.load() >= 0)
+            {
+                dest.clear(startSample, numSamples);
+                return;
+            }
+
+            bufferedSource->getNextAudioBlock(AudioSourceChannelInfo(&dest, startSample, numSamples));
+            playPosition = position + numSamples;
+            return;
+        }
+
+        auto& window = windows[activeWindow];
+        auto offset = (int) (position - window.start);
+        auto available = window.length - offset;
+
+        // setStartPosition may have moved the play position out of the window
+        if (offset < 0 || available <= 0)
+        {
+            releaseActiveWindow();
+            continue;
+        }
+
+        auto numToCopy = jmin(numSamples, available);
+        for (int channel = 0; channel < dest.getNumChannels(); ++channel)
+            dest.copyFrom(channel, startSample, window.buffer,
+                          jmin(channel, window.buffer.getNumChannels() - 1), offset, numToCopy);
+
+        playPosition = position + numToCopy;
+        startSample += numToCopy;
+        numSamples -= numToCopy;
+
+        // the read-ahead buffer was pointed at the end of this window when we jumped
+        if (numToCopy == available)
+            releaseActiveWindow();
+    }
+}
+
+bool CueWindowSource::claimWindowFor(int64 samplePosition)
+{
+    if (activeWindow >= 0)
+    {
+        auto& window = windows[activeWindow];
+        if (samplePosition >= window.start && samplePosition < window.start + window.length)
+            return true;
+
+        releaseActiveWindow();
+    }
+
+    auto index = findWindowFor(samplePosition);
+    if (index < 0)
+        return false;
+
+    int expected = ready;
+    if (!windows[index].state.compare_exchange_strong(expected, playing))
+        return false;
+
+    activeWindow = index;
+    return true;
+}
+
+void CueWindowSource::renderScratch(AudioBuffer<float>& dest, int startSample, int numSamples,
+                                    double& position, double startRate, double endRate)
+{
+    if (numStems == 1)
+    {
+        renderScratchChannels(dest, startSample, numSamples, position, startRate, endRate);
+        return;
+    }
+
+    // the rate keeps sliding evenly across the whole block, chunk by chunk
+    auto rateStep = numSamples > 0 ? (endRate - startRate) / numSamples : 0.0;
+
+    for (int done = 0; done < numSamples;)
+    {
+        auto numToRender = jmin(numSamples - done, stemBuffer.getNumSamples());
+        renderScratchChannels(stemBuffer, 0, numToRender, position,
+                              startRate + rateStep * done, startRate + rateStep * (done + numToRender));
+        mixStems(dest, startSample + done, numToRender);
+        done += numToRender;
+    }
+}
+
+void CueWindowSource::renderScratchChannels(AudioBuffer<float>& dest, int startSample, int numSamples,
+                                            double& position, double startRate, double endRate)
+{
+    auto numChannels = jmin(numSourceChannels, dest.getNumChannels());
+    auto rateStep = numSamples > 0 ? (endRate - startRate) / numSamples : 0.0;
+    auto lastSample = (double) jmax<int64>(0, totalLength - 1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto index = (int64) std::floor(position);
+
+        if (!claimWindowFor(index))
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                dest.setSample(channel, startSample + i, 0.0f);
+        }
+        else
+        {
+            // four point Catmull-Rom interpolation, clamped to the edges of the window
+            auto& window = windows[activeWindow];
+            auto offset = (int) (index - window.start);
+            auto last = window.length - 1;
+            int points[] = { jmax(0, offset - 1), offset, jmin(last, offset + 1), jmin(last, offset + 2) };
+            auto t = (float) (position - (double) index);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = window.buffer.getReadPointer(jmin(channel, window.buffer.getNumChannels() - 1));
+                auto y0 = data[points[0]], y1 = data[points[1]], y2 = data[points[2]], y3 = data[points[3]];
+
+                auto value = y1 + 0.5f * t * (y2 - y0 + t * (2.0f * y0 - 5.0f * y1 + 4.0f * y2 - y3
+                                                              + t * (3.0f * (y1 - y2) + y3 - y0)));
+                dest.setSample(channel, startSample + i, value);
+            }
+        }
+
+        position = jlimit(0.0, lastSample, position + startRate + rateStep * (i + 1));
+    }
+
+    for (int channel = numChannels; channel < dest.getNumChannels(); ++channel)
+        dest.copyFrom(channel, startSample, dest, 0, startSample, numSamples);
+
+    // steers the background refill of the playhead windows
+    playPosition = (int64) position;
+}
+
+//==============================================================================
+int CueWindowSource::useTimeSlice()
+{
+    moveReadAhead();
+
+    for (int i = 0; i < maxCues; ++i)
+    {
+        auto& window = windows[i];
+        auto wanted = window.wantedStart.load();
+        if (wanted != window.start && fillWindow(window, wanted))
+            return 1;
+    }
+
+    refreshPlayheadWindows();
+    return timeSliceIntervalMs;
+}
+
+void CueWindowSource::moveReadAhead()
+{
+    auto target = readAheadTarget.load();
+
+    if (target < 0)
+        return;
+
+    bufferedSource->setNextReadPosition(target);
+
+    // if the audio thread asked again meanwhile, that one is picked up next time
+    readAheadTarget.compare_exchange_strong(target, -1);
+}
+
+void CueWindowSource::refreshPlayheadWindows()
+{
+    auto maxStart = jmax<int64>(0, totalLength - windowLength);
+    auto wanted = jlimit<int64>(0, maxStart, playPosition.load() - windowLength / 2);
+    auto refreshDistance = windowLength / 6;
+
+    Window* candidate = nullptr;
+
+    for (int i = maxCues; i < maxCues + 2; ++i)
+    {
+        auto& window = windows[i];
+        auto state = window.state.load();
+
+        if ((state == ready || state == playing) && std::abs(window.start - wanted) < refreshDistance)
+            return;
+
+        if (state == playing)
+            continue;
+
+        if (candidate == nullptr || state == empty
+            || std::abs(window.start - wanted) > std::abs(candidate->start - wanted))
+            candidate = &window;
+    }
+
+    if (candidate != nullptr)
+        fillWindow(*candidate, wanted);
+}
+
+bool CueWindowSource::fillWindow(Window& window, int64 wantedStart)
+{
+    int expected = window.state.load();
+
+    if (expected == playing || expected == filling)
+        return false;
+
+    if (!window.state.compare_exchange_strong(expected, filling))
+        return false;
+
+    auto length = wantedStart < 0 ? 0 : (int) jmin<int64>(windowLength, totalLength - wantedStart);
+
+    if (length <= 0)
+    {
+        window.start = wantedStart;
+        window.length = 0;
+        window.state = empty;
+        return true;
+    }
+
+    windowReader->read(&window.buffer, 0, length, wantedStart, true, true);
+    window.start = wantedStart;
+    window.length = length;
+    window.state = ready;
+    return true;
+}
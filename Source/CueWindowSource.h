@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    CueWindowSource.h
+    Created: 19 Oct 2026 10:12:40am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "StemReader.h"
+
+//==============================================================================
+/*
+    Sits between the file reader and the deck's AudioTransportSource.
+
+    Normal playback is streamed through a BufferingAudioSource. On top of that a
+    few windows of fully decoded audio are kept resident: one per hot cue and
+    two around the playhead. A seek that lands inside a resident window is
+    served straight from memory, with a short crossfade from the old position,
+    while the read-ahead buffer is repositioned to the end of that window in
+    the background. A seek outside every window asks for the read-ahead buffer
+    to be repositioned and plays silence until it has refilled, rather than
+    reading the file on the audio thread. The reposition itself is done by the
+    background thread, as BufferingAudioSource locks to move.
+
+    Scratching reads the same playhead windows at a fractional position that
+    can move either way at any speed, so changing direction never touches the
+    decoder. The playhead windows follow the scratch position, and audio that
+    isn't resident yet plays as silence rather than blocking.
+
+    A stem track is read, buffered and windowed with all its channels, one
+    decode for every stem. The stems are only summed to stereo on the way out,
+    each at its own gain.
+
+    All decoding happens on the supplied TimeSliceThread; the audio thread only
+    copies samples.
+*/
+class CueWindowSource : public PositionableAudioSource,
+                        private TimeSliceClient
+{
+public:
+    /** Takes ownership of both readers. streamReader feeds the read-ahead
+        buffer, windowReader is only used to decode the resident windows.
+    */
+    CueWindowSource(AudioFormatReader* streamReader,
+                    AudioFormatReader* windowReader,
+                    TimeSliceThread& backgroundThread);
+    ~CueWindowSource() override;
+
+    static constexpr int maxCues = 4;
+
+    /** keep the audio around samplePosition resident, or pass -1 to drop the cue */
+    void setCue(int index, int64 samplePosition);
+
+    /** true if a jump to this position would be served from memory */
+    bool isResident(int64 samplePosition) const;
+
+    double getSampleRate() const { return sourceSampleRate; }
+
+    /** the decoded windows, the read-ahead and the scratch buffers, all allocated up front */
+    size_t getMemoryBytes() const;
+
+    /** 1 for an ordinary stereo track */
+    int getNumStems() const { return numStems; }
+    /** how loud a stem is mixed in, 0 to mute it; the change is ramped over the next block */
+    void setStemGain(int stem, float gain);
+
+    /** before playback starts, from any thread: begin here, without the crossfade a seek gets */
+    void setStartPosition(int64 samplePosition);
+
+    /** blocks until the read-ahead has been moved to the play position and holds the next
+        numSamples from there; false if the timeout passed first */
+    bool waitUntilBuffered(int numSamples, uint32 timeoutMs);
+
+    /** Audio thread only. Renders from the resident windows starting at position
+        (in source samples), moving by a rate that slides from startRate to endRate
+        across the block; negative rates play backwards. position is advanced to
+        where the block ends. Resume normal playback with setNextReadPosition.
+    */
+    void renderScratch(AudioBuffer<float>& dest, int startSample, int numSamples,
+                       double& position, double startRate, double endRate);
+
+    //==============================================================================
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(int64 newPosition) override;
+    int64 getNextReadPosition() const override;
+    int64 getTotalLength() const override;
+    bool isLooping() const override { return false; }
+
+private:
+    enum WindowState { empty, filling, ready, playing };
+
+    struct Window
+    {
+        AudioBuffer<float> buffer;
+        std::atomic<int64> wantedStart{ -1 };
+        std::atomic<int> state{ empty };
+        std::atomic<int64> start{ -1 };   // only written while filling
+        std::atomic<int> length{ 0 };
+    };
+
+    int useTimeSlice() override;
+    /** background thread: moves the read-ahead buffer where the audio thread asked */
+    void moveReadAhead();
+    bool fillWindow(Window& window, int64 wantedStart);
+    void refreshPlayheadWindows();
+
+    int findWindowFor(int64 samplePosition) const;
+    void switchTo(int64 samplePosition);
+    void releaseActiveWindow();
+    void render(AudioBuffer<float>& dest, int startSample, int numSamples);
+    /** render, fading across a jump if one is pending; dest has a channel per source channel */
+    void renderWithJump(AudioBuffer<float>& dest, int startSample, int numSamples);
+    bool claimWindowFor(int64 samplePosition);
+    /** the scratch renderer proper, for every source channel dest has room for */
+    void renderScratchChannels(AudioBuffer<float>& dest, int startSample, int numSamples,
+                               double& position, double startRate, double endRate);
+    /** sums the stems in stemBuffer into the first two channels of dest, in one pass */
+    void mixStems(AudioBuffer<float>& dest, int startSample, int numSamples);
+
+    std::unique_ptr<AudioFormatReaderSource> streamSource;
+    std::unique_ptr<BufferingAudioSource> bufferedSource;
+    std::unique_ptr<AudioFormatReader> windowReader;
+    TimeSliceThread& thread;
+
+    const double sourceSampleRate;
+    const int64 totalLength;
+    const int windowLength;
+    const int readAheadLength;
+    const int cuePreRoll;
+    const int numSourceChannels;
+    const int numStems;
+
+    // cue windows first, then the two playhead windows
+    Window windows[maxCues + 2];
+    int activeWindow = -1;
+
+    std::atomic<int64> pendingJump{ -1 };
+    std::atomic<int64> playPosition{ 0 };
+    // where the read-ahead buffer should move to, -1 once the background thread has moved it
+    std::atomic<int64> readAheadTarget{ -1 };
+
+    AudioBuffer<float> fadeBuffer;
+    static constexpr int crossfadeSamples = 256;
+
+    // stem tracks render every stem here before they're mixed down
+    AudioBuffer<float> stemBuffer;
+    std::atomic<float> stemGains[StemReader::maxStems];
+    float appliedStemGains[StemReader::maxStems];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CueWindowSource)
+};
@@ -1,111 +1,819 @@
-/*
-==============================================================================
-
-DJAudioPlayer.cpp
-Created: 13 Mar 2020 4:22:22pm
-Author:  matthew
-
-==============================================================================
-*/
-
-#include "DJAudioPlayer.h"
-
-DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager) 
-: formatManager(_formatManager)
-{
-
-}
-DJAudioPlayer::~DJAudioPlayer()
-{
-
-}
-
-void DJAudioPlayer::prepareToPlay (int samplesPerBlockExpected, double sampleRate) 
-{
-    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-void DJAudioPlayer::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
-{
-    resampleSource.getNextAudioBlock(bufferToFill);
-
-}
-void DJAudioPlayer::releaseResources()
-{
-    transportSource.releaseResources();
-    resampleSource.releaseResources();
-}
-
-void DJAudioPlayer::loadURL(URL audioURL)
-{
-    auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
-    if (reader != nullptr) // good file!
-    {       
-        std::unique_ptr<AudioFormatReaderSource> newSource (new AudioFormatReaderSource (reader, 
-true)); 
-        transportSource.setSource (newSource.get(), 0, nullptr, reader->sampleRate);             
-        readerSource.reset (newSource.release());          
-    }
-}
-void DJAudioPlayer::setGain(double gain)
-{
-    if (gain < 0 || gain > 1.0)
-    {
-        std::cout << "DJAudioPlayer::setGain gain should be between 0 and 1" << std::endl;
-    }
-    else {
-        transportSource.setGain(gain);
-    }
-   
-}
-void DJAudioPlayer::setSpeed(double ratio)
-{
-  if (ratio < 0 || ratio > 100.0)
-    {
-        std::cout << "DJAudioPlayer::setSpeed ratio should be between 0 and 100" << std::endl;
-    }
-    else {
-        resampleSource.setResamplingRatio(ratio);
-    }
-}
-void DJAudioPlayer::setPosition(double posInSecs)
-{
-    transportSource.setPosition(posInSecs);
-}
-
-void DJAudioPlayer::setPositionRelative(double pos)
-{
-    if (readerSource)
-    {
-        transportSource.setPosition(pos * transportSource.getLengthInSeconds());
-    }
-
-     if (pos < 0 || pos > 1.0)
-    {
-        std::cout << "DJAudioPlayer::setPositionRelative pos should be between 0 and 1" << std::endl;
-    }
-    else {
-        double posInSecs = transportSource.getLengthInSeconds() * pos;
-        setPosition(posInSecs);
-    }
-}
-
-
-void DJAudioPlayer::start()
-{
-    transportSource.start();
-}
-void DJAudioPlayer::stop()
-{
-  transportSource.stop();
-}
-
-double DJAudioPlayer::getPositionRelative()
-{
-    return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
-}
-
-bool DJAudioPlayer::isPlaying()
-{
-    return transportSource.isPlaying();
-}
+/*
+==============================================================================
+
+DJAudioPlayer.cpp
+Created: 13 Mar 2020 4:22:22pm
+Author:  matthew
+
+==============================================================================
+*/
+
+#include "DJAudioPlayer.h"
+#include "Tracer.h"
+#include "HttpTrackStream.h"
+#include "Automation.h"
+
+namespace
+{
+    // phase errors above this (in beats) are fixed with a jump when sync is engaged
+    const double snapThreshold = 0.02;
+    // blocks over which the remaining phase error is made up, and the most we bend the speed to do it
+    const double correctionBlocks = 8.0;
+    const double maxCorrection = 0.02;
+
+    // the fastest a hand can spin the record, in multiples of normal speed
+    const double maxScratchRate = 8.0;
+    // how long the motor takes to bring the platter from standstill to speed
+    const double motorSeconds = 0.1;
+
+    // a stopped deck fades out over this much of its last block, as the transport did
+    const int stopFadeSamples = 256;
+    // how soon the message thread notices the audio thread has moved on to a queued track
+    const int handoverPollMs = 50;
+}
+
+DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager) 
+: MemoryBudget::Consumer("Decks", MemoryBudget::Cost::decode),
+  formatManager(_formatManager)
+{
+    for (auto& cue : hotCues)
+        cue = -1.0;
+
+    resetStems();
+    readAheadThread.startThread();
+    startTimer(handoverPollMs);
+    addToBudget();
+}
+DJAudioPlayer::~DJAudioPlayer()
+{
+    removeFromBudget();
+    analysisPool.removeAllJobs(true, 2000);
+    stopTimer();
+    transportSource.setSource(nullptr);
+    readerSource.reset();
+    queuedSource.reset();
+    readAheadThread.stopThread(1000);
+}
+
+void DJAudioPlayer::prepareToPlay (int samplesPerBlockExpected, double sampleRate) 
+{
+    outputSampleRate = sampleRate;
+    blockSize = samplesPerBlockExpected;
+    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    effectsRack.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+void DJAudioPlayer::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
+{
+    // the beat position is read before the block so timed effects line up with it, and the
+    // playhead too, so the GUI extrapolates from the block's first sample
+    auto beatPosition = getBeatPosition();
+    auto blockStartSeconds = transportSource.getCurrentPosition();
+    auto lengthSeconds = transportSource.getLengthInSeconds();
+
+    auto shouldPlay = playing.load();
+
+    if (!renderPlatter(bufferToFill))
+    {
+        if (shouldPlay)
+        {
+            applySync(bufferToFill.numSamples);
+            resampleSource.getNextAudioBlock(bufferToFill);
+
+            // the transport stops itself at the end of the track
+            if (!transportSource.isPlaying())
+            {
+                playing = false;
+                reachedEnd = true;
+            }
+        }
+        else if (wasPlaying)
+        {
+            // only the fade is pulled, so a stop moves the playhead by the same amount whatever the block size
+            auto fadeLength = jmin(stopFadeSamples, bufferToFill.numSamples);
+            resampleSource.getNextAudioBlock(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample, fadeLength));
+
+            for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+                bufferToFill.buffer->applyGainRamp(channel, bufferToFill.startSample, fadeLength, 1.0f, 0.0f);
+
+            bufferToFill.buffer->clear(bufferToFill.startSample + fadeLength, bufferToFill.numSamples - fadeLength);
+        }
+        else
+        {
+            bufferToFill.clearActiveBufferRegion();
+        }
+    }
+
+    wasPlaying = playing.load();
+
+    effectsRack.process(bufferToFill, getEffectiveBpm(), beatPosition);
+
+    // the GUI draws from this instead of asking the transport
+    auto rate = platterEngaged ? platterSpeed : (wasPlaying ? currentSpeed.load() : 0.0);
+    playheadClock.publish(blockStartSeconds, lengthSeconds, rate);
+}
+void DJAudioPlayer::releaseResources()
+{
+    transportSource.releaseResources();
+    resampleSource.releaseResources();
+    effectsRack.releaseResources();
+}
+
+void DJAudioPlayer::loadURL(URL audioURL)
+{
+    TRACE_SPAN("DJAudioPlayer::loadURL");
+
+    // takes any switch the audio thread has made, so the source below is replaced whole
+    clearQueued();
+
+    auto* reader = StemReader::createReaderFor(formatManager, audioURL);
+    if (reader != nullptr) // good file!
+    {       
+        // a second reader decodes the hot cue windows so it never fights the streaming one
+        auto* windowReader = StemReader::createReaderFor(formatManager, audioURL);
+        if (windowReader == nullptr)
+        {
+            delete reader;
+            return;
+        }
+
+        auto trim = findTrim(audioURL, reader->lengthInSamples);
+        auto sourceSampleRate = reader->sampleRate;
+        std::unique_ptr<CueWindowSource> newSource (new CueWindowSource (reader, windowReader, readAheadThread));
+        playing = false; // a new track is loaded stopped
+        transportSource.setSource (nullptr);
+
+        std::unique_ptr<CueWindowSource> previous;
+
+        {
+            // the platter and the hot cues read the source directly, so they must not see the
+            // swap half done; the old source is deleted after, so the lock is only held briefly
+            const SpinLock::ScopedLockType sl (sourceLock);
+            gaplessSource.setCurrent (newSource.get(), trim);
+            previous = std::move (readerSource);
+            readerSource = std::move (newSource);
+            platterEngaged = false;
+        }
+
+        previous.reset();
+
+        transportSource.setSource (&gaplessSource, 0, nullptr, sourceSampleRate);
+        armTransport();
+
+        for (auto& cue : hotCues)
+            cue = -1.0;
+
+        resetStems();
+        loadedURL = audioURL;
+        startAnalysis(audioURL);
+
+        if (automation != nullptr)
+            automation->recordTrack(Automation::Action::load, automationDeck, audioURL, 0.0);
+    }
+}
+
+bool DJAudioPlayer::queueNext(URL audioURL, double crossfadeMs)
+{
+    clearQueued();
+
+    if (readerSource == nullptr)
+        return false;
+
+    std::unique_ptr<AudioFormatReader> reader (StemReader::createReaderFor(formatManager, audioURL));
+    std::unique_ptr<AudioFormatReader> windowReader (StemReader::createReaderFor(formatManager, audioURL));
+
+    if (reader == nullptr || windowReader == nullptr)
+        return false;
+
+    // the transport corrects for one source rate, so only a track at the same rate can follow on
+    if (reader->sampleRate != readerSource->getSampleRate())
+    {
+        DBG("DJAudioPlayer::queueNext - " + audioURL.getFileName() + " is at a different sample rate, load it instead");
+        return false;
+    }
+
+    auto trim = findTrim(audioURL, reader->lengthInSamples);
+    auto crossfadeSamples = (int) (crossfadeMs * reader->sampleRate / 1000.0);
+
+    // prepared and positioned now, so the read-ahead thread fills it while this track plays out
+    queuedSource.reset (new CueWindowSource (reader.release(), windowReader.release(), readAheadThread));
+    queuedSource->prepareToPlay (blockSize, outputSampleRate);
+    queuedSource->setStartPosition (trim.start);
+    queuedURL = audioURL;
+
+    gaplessSource.setQueued (queuedSource.get(), trim, crossfadeSamples);
+
+    if (automation != nullptr)
+        automation->recordTrack(Automation::Action::queue, automationDeck, audioURL, crossfadeMs);
+
+    return true;
+}
+
+void DJAudioPlayer::clearQueued()
+{
+    if (queuedSource != nullptr)
+    {
+        if (gaplessSource.cancelQueued())
+        {
+            queuedSource.reset();
+            return;
+        }
+
+        // the audio thread got there first and may still be inside the block that switches;
+        // it flags the switch before that block ends, and nothing can switch after this
+        while (!gaplessSource.hasSwitched())
+            Thread::yield();
+    }
+
+    // once the audio thread has switched, the queued source is the one playing
+    takeHandover();
+}
+
+void DJAudioPlayer::timerCallback()
+{
+    takeHandover();
+
+    if (reachedEnd.exchange(false))
+        armTransport();
+}
+
+void DJAudioPlayer::takeHandover()
+{
+    if (!gaplessSource.takeSwitch())
+        return;
+
+    std::unique_ptr<CueWindowSource> finished;
+
+    {
+        const SpinLock::ScopedLockType sl (sourceLock);
+        finished = std::move (readerSource);
+        readerSource = std::move (queuedSource);
+    }
+
+    // the audio thread has already left it, and it's deleted outside the lock
+    finished.reset();
+
+    for (auto& cue : hotCues)
+        cue = -1.0;
+
+    // the queued source started with its stems at full level
+    resetStems();
+    loadedURL = queuedURL;
+    startAnalysis(queuedURL);
+
+    if (onTrackChanged)
+        onTrackChanged(queuedURL);
+}
+
+void DJAudioPlayer::armTransport()
+{
+    // only pulled while the deck is playing, so a started transport doesn't move on its own
+    if (readerSource != nullptr && !transportSource.isPlaying())
+        transportSource.start();
+}
+
+GaplessSource::Trim DJAudioPlayer::findTrim(const URL& audioURL, int64 decodedLength)
+{
+    if (!audioURL.getFileName().endsWithIgnoreCase(".mp3"))
+        return {};
+
+    auto stream = HttpTrackStream::createInputStreamFor(audioURL);
+    return stream != nullptr ? GaplessSource::findEncoderTrim(*stream, decodedLength) : GaplessSource::Trim();
+}
+
+void DJAudioPlayer::startAnalysis(const URL& audioURL)
+{
+    // the beat grid arrives later, from the analysis pool; a job still finishing the
+    // last track is told to stop, not waited for, and what it finds is thrown away
+    analysisPool.removeAllJobs(true, 0);
+    int generation;
+
+    {
+        const ScopedLock sl(analysisLock);
+        generation = ++analysisGeneration;
+        bpm = 0.0;
+        cueOut = 0.0;
+    }
+
+    // a stem track is analysed as the full mix
+    if (auto* analysisReader = StemReader::createReaderFor(formatManager, audioURL, true))
+    {
+        analysisPool.addJob(new TrackAnalysisJob(analysisReader, [this, generation](const TrackAnalysis& analysis)
+            {
+                const ScopedLock sl(analysisLock);
+
+                if (generation == analysisGeneration)
+                    applyAnalysis(analysis);
+            }), true);
+    }
+}
+
+void DJAudioPlayer::setAnalysis(const TrackAnalysis& analysis)
+{
+    // the background job is stopped, not waited for; its result no longer matches the stamp
+    analysisPool.removeAllJobs(true, 0);
+
+    const ScopedLock sl(analysisLock);
+    ++analysisGeneration;
+    applyAnalysis(analysis);
+}
+
+void DJAudioPlayer::applyAnalysis(const TrackAnalysis& analysis)
+{
+    firstBeat = analysis.firstBeatSeconds;
+    bpm = analysis.bpm;
+
+    key = analysis.key;
+    loudnessDb = analysis.loudnessDb;
+    energy = analysis.energy;
+
+    cueIn = analysis.cueInSeconds;
+    introEnd = analysis.introEndSeconds;
+    outroStart = analysis.outroStartSeconds;
+    cueOut = analysis.cueOutSeconds;
+}
+
+int DJAudioPlayer::getNumStems() const
+{
+    return readerSource != nullptr ? readerSource->getNumStems() : 1;
+}
+
+void DJAudioPlayer::setStemGain(int stem, float gain)
+{
+    if (!isPositiveAndBelow(stem, StemReader::maxStems))
+        return;
+
+    stemGains[stem] = jlimit(0.0f, 1.0f, gain);
+    applyStemGains();
+}
+
+float DJAudioPlayer::getStemGain(int stem) const
+{
+    return isPositiveAndBelow(stem, StemReader::maxStems) ? stemGains[stem] : 0.0f;
+}
+
+void DJAudioPlayer::setStemMuted(int stem, bool shouldBeMuted)
+{
+    if (!isPositiveAndBelow(stem, StemReader::maxStems))
+        return;
+
+    stemMuted[stem] = shouldBeMuted;
+    applyStemGains();
+}
+
+bool DJAudioPlayer::isStemMuted(int stem) const
+{
+    return isPositiveAndBelow(stem, StemReader::maxStems) && stemMuted[stem];
+}
+
+void DJAudioPlayer::resetStems()
+{
+    for (int stem = 0; stem < StemReader::maxStems; ++stem)
+    {
+        stemGains[stem] = 1.0f;
+        stemMuted[stem] = false;
+    }
+}
+
+void DJAudioPlayer::applyStemGains()
+{
+    if (readerSource == nullptr)
+        return;
+
+    for (int stem = 0; stem < readerSource->getNumStems(); ++stem)
+        readerSource->setStemGain(stem, stemMuted[stem] ? 0.0f : stemGains[stem]);
+}
+
+bool DJAudioPlayer::waitUntilBuffered(double seconds, int timeoutMs)
+{
+    if (readerSource == nullptr)
+        return false;
+
+    return readerSource->waitUntilBuffered((int) (seconds * readerSource->getSampleRate()), (uint32) timeoutMs);
+}
+
+void DJAudioPlayer::setGain(double gain)
+{
+    if (gain < 0 || gain > 1.0)
+    {
+        std::cout << "DJAudioPlayer::setGain gain should be between 0 and 1" << std::endl;
+    }
+    else {
+        transportSource.setGain(gain);
+
+        if (automation != nullptr)
+            automation->record(Automation::Action::gain, automationDeck, 0, gain);
+    }
+   
+}
+void DJAudioPlayer::setSpeed(double ratio)
+{
+  if (ratio < 0 || ratio > 100.0)
+    {
+        std::cout << "DJAudioPlayer::setSpeed ratio should be between 0 and 100" << std::endl;
+    }
+    else {
+        userSpeed = ratio; // picked up by the audio thread in applySync
+
+        if (automation != nullptr)
+            automation->record(Automation::Action::speed, automationDeck, 0, ratio);
+    }
+}
+void DJAudioPlayer::setPosition(double posInSecs)
+{
+    transportSource.setPosition(posInSecs);
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::seek, automationDeck, 0, posInSecs);
+}
+
+void DJAudioPlayer::cueAt(double posInSecs)
+{
+    if (MessageManager::existsAndIsCurrentThread())
+        takeHandover();
+
+    auto cued = false;
+
+    if (!isPlaying())
+    {
+        // a stopped deck doesn't pull from its source, so the source can be moved directly
+        const SpinLock::ScopedLockType sl (sourceLock);
+
+        if (auto* source = gaplessSource.getCurrent())
+        {
+            source->setStartPosition((int64) (posInSecs * source->getSampleRate()));
+            cued = true;
+        }
+    }
+
+    if (!cued)
+    {
+        setPosition(posInSecs);
+        return;
+    }
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::cue, automationDeck, 0, posInSecs);
+}
+
+void DJAudioPlayer::setPositionRelative(double pos)
+{
+    if (readerSource)
+    {
+        transportSource.setPosition(pos * transportSource.getLengthInSeconds());
+    }
+
+     if (pos < 0 || pos > 1.0)
+    {
+        std::cout << "DJAudioPlayer::setPositionRelative pos should be between 0 and 1" << std::endl;
+    }
+    else {
+        double posInSecs = transportSource.getLengthInSeconds() * pos;
+        setPosition(posInSecs);
+    }
+}
+
+void DJAudioPlayer::setHotCue(int index)
+{
+    setHotCueAt(index, transportSource.getCurrentPosition());
+}
+
+void DJAudioPlayer::setHotCueAt(int index, double seconds)
+{
+    // cues belong to the track that is playing now; on the message thread a switch to the
+    // queued track is taken first, on the audio thread the current source is already it
+    if (MessageManager::existsAndIsCurrentThread())
+        takeHandover();
+
+    if (index < 0 || index >= CueWindowSource::maxCues || seconds < 0.0)
+        return;
+
+    {
+        const SpinLock::ScopedLockType sl (sourceLock);
+        auto* source = gaplessSource.getCurrent();
+
+        if (source == nullptr)
+            return;
+
+        hotCues[index] = seconds;
+        source->setCue(index, (int64) (seconds * source->getSampleRate()));
+    }
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::hotCueSet, automationDeck, index, seconds);
+}
+
+void DJAudioPlayer::clearHotCue(int index)
+{
+    if (MessageManager::existsAndIsCurrentThread())
+        takeHandover();
+
+    if (index < 0 || index >= CueWindowSource::maxCues)
+        return;
+
+    {
+        const SpinLock::ScopedLockType sl (sourceLock);
+        auto* source = gaplessSource.getCurrent();
+
+        if (source == nullptr)
+            return;
+
+        hotCues[index] = -1.0;
+        source->setCue(index, -1);
+    }
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::hotCueClear, automationDeck, index, 0.0);
+}
+
+bool DJAudioPlayer::hasHotCue(int index) const
+{
+    return index >= 0 && index < CueWindowSource::maxCues && hotCues[index] >= 0.0;
+}
+
+void DJAudioPlayer::jumpToHotCue(int index)
+{
+    takeHandover();
+
+    if (readerSource != nullptr && hasHotCue(index))
+        setPosition(hotCues[index]);
+}
+
+void DJAudioPlayer::setMasterClock(MasterClock* clock)
+{
+    masterClock = clock;
+}
+
+void DJAudioPlayer::setAutomation(Automation* newAutomation, int deck)
+{
+    automation = newAutomation;
+    automationDeck = deck;
+}
+
+void DJAudioPlayer::setSyncEnabled(bool shouldSync)
+{
+    snapPending = shouldSync;
+    syncEnabled = shouldSync;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::sync, automationDeck, 0, shouldSync ? 1.0 : 0.0);
+}
+
+bool DJAudioPlayer::isSyncEnabled() const
+{
+    return syncEnabled;
+}
+
+void DJAudioPlayer::makeMaster()
+{
+    if (masterClock != nullptr)
+        masterClock->setMaster(this);
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::master, automationDeck, 0, 0.0);
+}
+
+bool DJAudioPlayer::isMaster() const
+{
+    return masterClock != nullptr && masterClock->getMaster() == this;
+}
+
+bool DJAudioPlayer::hasBeatGrid() const
+{
+    return bpm.load() > 0.0;
+}
+
+double DJAudioPlayer::getBpm() const
+{
+    return bpm;
+}
+
+double DJAudioPlayer::getEffectiveBpm() const
+{
+    return bpm.load() * currentSpeed.load();
+}
+
+double DJAudioPlayer::getBeatPosition() const
+{
+    return (transportSource.getCurrentPosition() - firstBeat.load()) * bpm.load() / 60.0;
+}
+
+bool DJAudioPlayer::hasMixPoints() const
+{
+    return cueOut.load() > 0.0;
+}
+
+TrackAnalysis DJAudioPlayer::getAnalysis() const
+{
+    TrackAnalysis analysis;
+    analysis.bpm = bpm;
+    analysis.firstBeatSeconds = firstBeat;
+    analysis.cueInSeconds = cueIn;
+    analysis.introEndSeconds = introEnd;
+    analysis.outroStartSeconds = outroStart;
+    analysis.cueOutSeconds = cueOut;
+    analysis.key = key;
+    analysis.loudnessDb = loudnessDb;
+    analysis.energy = energy;
+    return analysis;
+}
+
+void DJAudioPlayer::applySync(int numSamples)
+{
+    auto speed = userSpeed.load();
+
+    if (syncEnabled && !isMaster() && hasBeatGrid() && playing.load() && masterClock != nullptr)
+    {
+        auto deckBpm = bpm.load();
+        speed = masterClock->getTempo() / deckBpm;
+
+        auto error = MasterClock::wrapPhase(masterClock->getBeatPosition() - getBeatPosition());
+
+        if (snapPending.exchange(false) && std::abs(error) > snapThreshold)
+        {
+            // line the grids up in one jump rather than drifting into phase
+            transportSource.setPosition(transportSource.getCurrentPosition() + error * 60.0 / deckBpm);
+        }
+        else if (numSamples > 0)
+        {
+            // make up the rest as a fractional change of speed, spread over the next few blocks
+            auto errorSamples = error * 60.0 / deckBpm * outputSampleRate;
+            auto correction = errorSamples / (speed * numSamples * correctionBlocks);
+            speed *= 1.0 + jlimit(-maxCorrection, maxCorrection, correction);
+        }
+    }
+
+    if (speed != currentSpeed.load())
+    {
+        resampleSource.setResamplingRatio(speed);
+        currentSpeed = speed;
+    }
+}
+
+void DJAudioPlayer::setEffectEnabled(EffectsRack::Effect effect, bool shouldBeEnabled)
+{
+    effectsRack.setEnabled(effect, shouldBeEnabled);
+}
+
+bool DJAudioPlayer::isEffectEnabled(EffectsRack::Effect effect) const
+{
+    return effectsRack.isEnabled(effect);
+}
+
+void DJAudioPlayer::setEffectMix(EffectsRack::Effect effect, float mix)
+{
+    effectsRack.setMix(effect, mix);
+}
+
+void DJAudioPlayer::setEffectAmount(EffectsRack::Effect effect, float amount)
+{
+    effectsRack.setAmount(effect, amount);
+}
+
+void DJAudioPlayer::beginScratch()
+{
+    handOffset = 0.0;
+    touchPending = true;
+    scratching = true;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::scratchBegin, automationDeck, 0, 0.0);
+}
+
+void DJAudioPlayer::scratchTo(double secondsFromTouch)
+{
+    handOffset = secondsFromTouch;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::scratchTo, automationDeck, 0, secondsFromTouch);
+}
+
+void DJAudioPlayer::endScratch()
+{
+    scratching = false;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::scratchEnd, automationDeck, 0, 0.0);
+}
+
+void DJAudioPlayer::setReverse(bool shouldReverse)
+{
+    reverse = shouldReverse;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::reverse, automationDeck, 0, shouldReverse ? 1.0 : 0.0);
+}
+
+bool DJAudioPlayer::renderPlatter(const AudioSourceChannelInfo& bufferToFill)
+{
+    if (!platterEngaged && !scratching.load() && !reverse.load())
+        return false;
+
+    const SpinLock::ScopedTryLockType sl (sourceLock);
+
+    auto* source = gaplessSource.getCurrent();
+
+    if (!sl.isLocked() || source == nullptr)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return true;
+    }
+
+    auto numSamples = bufferToFill.numSamples;
+    auto sourceRatio = source->getSampleRate() / outputSampleRate;
+    auto motorRate = playing.load() ? userSpeed.load() * sourceRatio : 0.0;
+
+    if (!platterEngaged)
+    {
+        platterEngaged = true;
+        platterPosition = (double) source->getNextReadPosition();
+        platterRate = reverse.load() && !scratching.load() ? -motorRate : motorRate;
+    }
+
+    // the record stops where the hand lands on it
+    if (touchPending.exchange(false))
+        platterAnchor = platterPosition;
+
+    double targetRate;
+
+    if (scratching.load())
+    {
+        // the record stays under the hand: head for where the hand has put it by the end of this block
+        auto handPosition = platterAnchor + handOffset.load() * source->getSampleRate();
+        auto limit = maxScratchRate * sourceRatio;
+        targetRate = jlimit(-limit, limit, (handPosition - platterPosition) / jmax(1, numSamples));
+    }
+    else
+    {
+        // the motor pulls the platter back up to speed, or round to the other direction
+        auto wanted = reverse.load() ? -motorRate : motorRate;
+        auto maxChange = jmax(motorRate, sourceRatio) * numSamples / (motorSeconds * outputSampleRate);
+        auto change = wanted - platterRate;
+        targetRate = std::abs(change) <= maxChange ? wanted : platterRate + (change > 0.0 ? maxChange : -maxChange);
+
+        if (targetRate == wanted && (!reverse.load() || wanted == 0.0))
+        {
+            // back at normal speed going forwards, or at rest: hand over to the transport with a short crossfade
+            source->setNextReadPosition((int64) platterPosition);
+            platterEngaged = false;
+            return false;
+        }
+    }
+
+    source->renderScratch(*bufferToFill.buffer, bufferToFill.startSample, numSamples,
+                                platterPosition, platterRate, targetRate);
+    platterRate = targetRate;
+    platterSpeed = targetRate / sourceRatio;
+
+    // the transport applies the deck gain on the normal path
+    bufferToFill.buffer->applyGain(bufferToFill.startSample, numSamples, transportSource.getGain());
+
+    return true;
+}
+
+void DJAudioPlayer::start()
+{
+    // the transport is re-armed after the end of a track by the timer; on the
+    // message thread there's no need to wait for it
+    if (MessageManager::existsAndIsCurrentThread())
+        armTransport();
+
+    playing = true;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::play, automationDeck, 0, 0.0);
+}
+void DJAudioPlayer::stop()
+{
+  playing = false;
+
+  if (automation != nullptr)
+      automation->record(Automation::Action::stop, automationDeck, 0, 0.0);
+}
+
+double DJAudioPlayer::getPositionRelative()
+{
+    auto length = transportSource.getLengthInSeconds();
+    return length > 0.0 ? transportSource.getCurrentPosition() / length : 0.0;
+}
+
+bool DJAudioPlayer::isPlaying()
+{
+    return playing.load();
+}
+
+double DJAudioPlayer::getCurrentPosition() const
+{
+    return transportSource.getCurrentPosition();
+}
+
+double DJAudioPlayer::getLengthInSeconds() const
+{
+    return transportSource.getLengthInSeconds();
+}
+
+size_t DJAudioPlayer::getUsedBytes() const
+{
+    return (readerSource != nullptr ? readerSource->getMemoryBytes() : 0)
+         + (queuedSource != nullptr ? queuedSource->getMemoryBytes() : 0);
+}
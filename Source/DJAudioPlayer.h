@@ -1,49 +1,240 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.h
-    Created: 13 Mar 2020 4:22:22pm
-    Author:  matthew
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include "../JuceLibraryCode/JuceHeader.h"
-
-class DJAudioPlayer : public AudioSource {
-  public:
-
-    DJAudioPlayer(AudioFormatManager& _formatManager);
-    ~DJAudioPlayer();
-
-    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-
-    void loadURL(URL audioURL);
-    void setGain(double gain);
-    void setSpeed(double ratio);
-    void setPosition(double posInSecs);
-    void setPositionRelative(double pos);
-    
-
-    void start();
-    void stop();
-
-    /** get the relative position of the playhead */
-    double getPositionRelative();
-    bool isPlaying();
-
-private:
-    AudioFormatManager& formatManager;
-    std::unique_ptr<AudioFormatReaderSource> readerSource;
-    AudioTransportSource transportSource; 
-    ResamplingAudioSource resampleSource{&transportSource, false, 2};
-
-};
-
-
-
-
+/*
+  ==============================================================================
+
+    DJAudioPlayer.h
+    Created: 13 Mar 2020 4:22:22pm
+    Author:  matthew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "CueWindowSource.h"
+#include "MasterClock.h"
+#include "TrackAnalyser.h"
+#include "EffectsRack.h"
+#include "PlayheadClock.h"
+#include "GaplessSource.h"
+#include "StemReader.h"
+#include "MemoryBudget.h"
+
+class Automation;
+
+class DJAudioPlayer : public AudioSource,
+                      private Timer,
+                      private MemoryBudget::Consumer {
+  public:
+
+    DJAudioPlayer(AudioFormatManager& _formatManager);
+    ~DJAudioPlayer();
+
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+
+    void loadURL(URL audioURL);
+    /** open the next track in the background and carry straight on with it when this one
+        ends, overlapping the two by crossfadeMs; false if it can't follow gaplessly */
+    bool queueNext(URL audioURL, double crossfadeMs = 0.0);
+    void clearQueued();
+    bool hasQueued() const { return queuedSource != nullptr; }
+    /** the track waiting to follow on, or an empty URL */
+    URL getQueuedURL() const { return hasQueued() ? queuedURL : URL(); }
+    /** called on the message thread when a queued track has taken over */
+    std::function<void(const URL&)> onTrackChanged;
+    /** blocks until the next few seconds of the loaded track are decoded; false on timeout */
+    bool waitUntilBuffered(double seconds, int timeoutMs);
+    void setGain(double gain);
+    double getGain() const { return transportSource.getGain(); }
+    void setSpeed(double ratio);
+    /** the speed asked for, before sync bends it */
+    double getSpeedSetting() const { return userSpeed; }
+    void setPosition(double posInSecs);
+    void setPositionRelative(double pos);
+    /** while stopped: start from here, with the read-ahead and playhead windows filling
+        from this point now rather than when play is pressed; safe on the audio thread */
+    void cueAt(double posInSecs);
+
+    /** store hot cue index at the current playhead; the audio around it is kept decoded */
+    void setHotCue(int index);
+    /** store hot cue index at a time in the track rather than at the playhead; like
+        clearHotCue, safe on the audio thread, where it goes with the source playing now */
+    void setHotCueAt(int index, double seconds);
+    void clearHotCue(int index);
+    bool hasHotCue(int index) const;
+    /** where a hot cue is stored in seconds, or -1 */
+    double getHotCue(int index) const { return hasHotCue(index) ? hotCues[index].load() : -1.0; }
+    /** jump to a stored hot cue, served from memory without seeking the decoder */
+    void jumpToHotCue(int index);
+
+    /** share the engine's master clock with this deck */
+    void setMasterClock(MasterClock* clock);
+    /** follow the master clock's tempo and beat phase */
+    void setSyncEnabled(bool shouldSync);
+    bool isSyncEnabled() const;
+    /** make this deck the one the master clock follows */
+    void makeMaster();
+    bool isMaster() const;
+
+    /** false until the background analysis of the loaded track has finished */
+    bool hasBeatGrid() const;
+    double getBpm() const;
+    /** tempo at the current playback speed */
+    double getEffectiveBpm() const;
+    /** beats since the grid anchor, safe to call from the audio thread */
+    double getBeatPosition() const;
+
+    /** false until the analysis has found the track's intro and outro */
+    bool hasMixPoints() const;
+    /** where the track becomes audible, reaches full level, starts dropping away and goes silent */
+    double getCueInSeconds() const { return cueIn; }
+    double getIntroEndSeconds() const { return introEnd; }
+    double getOutroStartSeconds() const { return outroStart; }
+    double getCueOutSeconds() const { return cueOut; }
+
+    /** the loaded track's full analysis, once it has finished; check hasMixPoints first */
+    TrackAnalysis getAnalysis() const;
+    /** use an analysis kept from before; the background one is stopped and its result dropped */
+    void setAnalysis(const TrackAnalysis& analysis);
+    /** the track that's loaded, local or remote; empty when nothing is */
+    URL getLoadedURL() const { return loadedURL; }
+    /** the file that's loaded, if it came from one */
+    File getLoadedFile() const { return loadedURL.isLocalFile() ? loadedURL.getLocalFile() : File(); }
+
+    /** stems of the loaded track, 1 for an ordinary one; each has its own gain and mute */
+    int getNumStems() const;
+    void setStemGain(int stem, float gain);
+    float getStemGain(int stem) const;
+    void setStemMuted(int stem, bool shouldBeMuted);
+    bool isStemMuted(int stem) const;
+
+    /** insert effects, applied after the resampler */
+    void setEffectEnabled(EffectsRack::Effect effect, bool shouldBeEnabled);
+    bool isEffectEnabled(EffectsRack::Effect effect) const;
+    void setEffectMix(EffectsRack::Effect effect, float mix);
+    void setEffectAmount(EffectsRack::Effect effect, float amount);
+
+    /** hand on the record: from now on the playhead follows scratchTo instead of the motor */
+    void beginScratch();
+    /** move the hand, in seconds of audio relative to where the record was touched */
+    void scratchTo(double secondsFromTouch);
+    /** let go; playback picks up again at the deck's speed */
+    void endScratch();
+    bool isScratching() const { return scratching; }
+
+    /** play backwards at the current speed */
+    void setReverse(bool shouldReverse);
+    bool isReverse() const { return reverse; }
+
+    /** any thread, and never waits: the deck starts or stops at the start of the next
+        block it renders, so MIDI, Auto DJ and automation can call them on the audio thread */
+    void start();
+    void stop();
+
+    /** get the relative position of the playhead, 0 when nothing is loaded */
+    double getPositionRelative();
+    /** the playhead as last published by the audio thread, for the GUI to interpolate */
+    const PlayheadClock& getPlayheadClock() const { return playheadClock; }
+    /** what lies between this deck and the speakers, so the playhead shows what is heard */
+    void setOutputLatency(double seconds) { playheadClock.setOutputLatency(seconds); }
+    bool isPlaying();
+    bool isLoaded() const { return readerSource != nullptr; }
+
+    /** playhead and length in seconds of the track, safe to call from the audio thread */
+    double getCurrentPosition() const;
+    double getLengthInSeconds() const;
+    /** the resampling ratio used for the last block */
+    double getSpeed() const { return currentSpeed; }
+
+    /** the loaded and queued tracks' buffers, pinned in the memory budget while they're loaded */
+    size_t getUsedBytes() const override;
+
+    /** reports each control change to automation, as the given deck, while it records */
+    void setAutomation(Automation* newAutomation, int deck);
+    /** true while the loaded track's tempo and mix points are still being found */
+    bool isAnalysing() const { return analysisPool.getNumJobs() > 0; }
+
+private:
+    AudioFormatManager& formatManager;
+    TimeSliceThread readAheadThread{"Deck read-ahead"};
+    std::unique_ptr<CueWindowSource> readerSource;
+    std::unique_ptr<CueWindowSource> queuedSource;
+    URL queuedURL;
+    GaplessSource gaplessSource;
+    std::atomic<double> hotCues[CueWindowSource::maxCues];
+    AudioTransportSource transportSource; 
+    ResamplingAudioSource resampleSource{&transportSource, false, 2};
+    EffectsRack effectsRack;
+
+    /** pick this block's resampling ratio: the user's speed, or whatever keeps us on the clock */
+    void applySync(int numSamples);
+    /** a new track's stems start at full level, unmuted */
+    void resetStems();
+    void applyStemGains();
+    /** the encoder padding to skip, if the decoder for this file leaves it in */
+    GaplessSource::Trim findTrim(const URL& audioURL, int64 decodedLength);
+    /** analyse the track in the background for its beat grid, key and mix points */
+    void startAnalysis(const URL& audioURL);
+    void applyAnalysis(const TrackAnalysis& analysis);
+    /** message thread: after the audio thread has moved on to the queued track, take
+        ownership of it and delete the one it left; does nothing if it hasn't */
+    void takeHandover();
+    /** polls for a switch and for the end of a track, which the audio thread only flags;
+        the transport is re-armed once it has stopped at the end */
+    void timerCallback() override;
+    /** message thread: the transport is kept started whenever a track is loaded, and the
+        deck's own playing flag decides whether it is pulled, so start and stop never wait */
+    void armTransport();
+    /** renders a block at a signed, per-sample varying rate straight from the decoded windows;
+        returns false once the platter is back at normal forward speed */
+    bool renderPlatter(const AudioSourceChannelInfo& bufferToFill);
+
+    MasterClock* masterClock = nullptr;
+    double outputSampleRate = 44100.0;
+    int blockSize = 512;
+    std::atomic<double> bpm{ 0.0 };
+    std::atomic<double> firstBeat{ 0.0 };
+    std::atomic<double> userSpeed{ 1.0 };
+    std::atomic<double> currentSpeed{ 1.0 };
+    std::atomic<bool> syncEnabled{ false };
+    std::atomic<bool> snapPending{ false };
+    std::atomic<double> cueIn{ 0.0 }, introEnd{ 0.0 }, outroStart{ 0.0 }, cueOut{ 0.0 };
+    std::atomic<int> key{ -1 };
+    std::atomic<double> loudnessDb{ -100.0 }, energy{ 0.0 };
+    URL loadedURL;
+    float stemGains[StemReader::maxStems];
+    bool stemMuted[StemReader::maxStems];
+
+    // the platter: scratching and reverse bypass the transport and resampler
+    SpinLock sourceLock;
+    std::atomic<bool> scratching{ false };
+    std::atomic<bool> reverse{ false };
+    std::atomic<bool> touchPending{ false };
+    std::atomic<double> handOffset{ 0.0 };
+    bool platterEngaged = false;
+    double platterPosition = 0.0;
+    double platterAnchor = 0.0;
+    double platterRate = 0.0;
+    double platterSpeed = 0.0;   // platterRate in seconds of track per second
+
+    PlayheadClock playheadClock;
+
+    std::atomic<bool> playing{ false };
+    std::atomic<bool> reachedEnd{ false };
+    bool wasPlaying = false;    // audio thread only
+
+    ThreadPool analysisPool{ 1 };
+    // bumped whenever the loaded track's analysis is replaced, so an older job's result is dropped
+    CriticalSection analysisLock;
+    int analysisGeneration = 0;
+
+    Automation* automation = nullptr;
+    int automationDeck = 0;
+
+};
+
+
+
+
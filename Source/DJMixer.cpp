@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+    DJMixer.cpp
+    Created: 19 Oct 2026 4:10:31pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "DJMixer.h"
+#include "Automation.h"
+
+DJMixer::DJMixer()
+{
+    for (auto& deck : decks)
+        for (auto& gain : deck.bandGains)
+            gain = 1.0f;
+}
+
+DJMixer::~DJMixer()
+{
+}
+
+int DJMixer::addDeck(AudioSource* deck, CrossfaderSide side)
+{
+    jassert(numDecks < maxDecks);
+
+    if (numDecks >= maxDecks)
+        return -1;
+
+    decks[numDecks].source = deck;
+    decks[numDecks].side = side;
+    return numDecks++;
+}
+
+void DJMixer::setCrossfader(float position)
+{
+    crossfader = jlimit(0.0f, 1.0f, position);
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::crossfader, 0, 0, crossfader.load());
+}
+
+void DJMixer::setCrossfaderCurve(CrossfaderCurve newCurve)
+{
+    curve = (int) newCurve;
+}
+
+void DJMixer::setBandGain(int deck, DeckEQ::Band band, float gain)
+{
+    if (!isPositiveAndBelow(deck, numDecks))
+        return;
+
+    decks[deck].bandGains[band] = gain;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::eq, deck, band, gain);
+}
+
+float DJMixer::getBandGain(int deck, DeckEQ::Band band) const
+{
+    return isPositiveAndBelow(deck, numDecks) ? decks[deck].bandGains[band].load() : 1.0f;
+}
+
+void DJMixer::setPfl(int deck, bool shouldListen)
+{
+    if (!isPositiveAndBelow(deck, numDecks))
+        return;
+
+    decks[deck].pfl = shouldListen;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::pfl, deck, 0, shouldListen ? 1.0 : 0.0);
+}
+
+bool DJMixer::isPfl(int deck) const
+{
+    return isPositiveAndBelow(deck, numDecks) && decks[deck].pfl.load();
+}
+
+void DJMixer::setCueMix(float mix)
+{
+    cueMix = jlimit(0.0f, 1.0f, mix);
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::cueMix, 0, 0, cueMix.load());
+}
+
+void DJMixer::setFilter(int deck, float amount)
+{
+    if (!isPositiveAndBelow(deck, numDecks))
+        return;
+
+    decks[deck].filter = amount;
+
+    if (automation != nullptr)
+        automation->record(Automation::Action::filter, deck, 0, amount);
+}
+
+float DJMixer::getFilter(int deck) const
+{
+    return isPositiveAndBelow(deck, numDecks) ? decks[deck].filter.load() : 0.0f;
+}
+
+float DJMixer::crossfaderGain(float position, CrossfaderSide side, CrossfaderCurve curve)
+{
+    if (side == CrossfaderSide::thru)
+        return 1.0f;
+
+    // distance travelled towards the other side
+    auto away = side == CrossfaderSide::left ? position : 1.0f - position;
+
+    switch (curve)
+    {
+        case CrossfaderCurve::linear:        return 1.0f - away;
+        case CrossfaderCurve::constantPower: return std::cos(away * MathConstants<float>::halfPi);
+        case CrossfaderCurve::cut:           return jlimit(0.0f, 1.0f, (1.0f - away) * 16.0f);
+    }
+
+    return 1.0f;
+}
+
+//==============================================================================
+void DJMixer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    for (int i = 0; i < numDecks; ++i)
+        decks[i].source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    lanes.setSize(DeckEQ::numLanes, samplesPerBlockExpected);
+    lanes.clear();
+
+    if (cueOnlySource != nullptr)
+    {
+        cueOnlySource->prepareToPlay(samplesPerBlockExpected, sampleRate);
+        cueOnlyBuffer.setSize(2, samplesPerBlockExpected);
+    }
+
+    eq.prepare(sampleRate);
+    limiter.prepare(sampleRate, samplesPerBlockExpected);
+
+    for (auto& tap : deckTaps)
+        tap.prepare(sampleRate);
+
+    masterTap.prepare(sampleRate);
+    loadMeasurer.reset(sampleRate, samplesPerBlockExpected);
+}
+
+void DJMixer::releaseResources()
+{
+    for (int i = 0; i < numDecks; ++i)
+        decks[i].source->releaseResources();
+
+    if (cueOnlySource != nullptr)
+        cueOnlySource->releaseResources();
+}
+
+void DJMixer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    auto numSamples = bufferToFill.numSamples;
+
+    // the device is allowed to hand us more than it promised
+    if (numSamples > lanes.getNumSamples())
+        lanes.setSize(DeckEQ::numLanes, numSamples, false, true, true);
+
+    for (int i = 0; i < numDecks; ++i)
+    {
+        // a two channel view onto this deck's lanes, no copy and no allocation
+        AudioBuffer<float> deckLanes(lanes.getArrayOfWritePointers() + i * 2, 2, numSamples);
+        decks[i].source->getNextAudioBlock(AudioSourceChannelInfo(&deckLanes, 0, numSamples));
+    }
+
+    AudioProcessLoadMeasurer::ScopedTimer timer(loadMeasurer, numSamples);
+
+    auto position = crossfader.load();
+    auto currentCurve = (CrossfaderCurve) curve.load();
+
+    for (int i = 0; i < numDecks; ++i)
+    {
+        for (int band = 0; band < DeckEQ::numBands; ++band)
+            eq.setBandGain(i, (DeckEQ::Band) band, decks[i].bandGains[band]);
+
+        eq.setFilter(i, decks[i].filter);
+    }
+
+    eq.process(lanes, numSamples);
+
+    for (int i = 0; i < numDecks; ++i)
+        deckTaps[i].push(lanes.getReadPointer(i * 2), lanes.getReadPointer(i * 2 + 1), numSamples);
+
+    bufferToFill.clearActiveBufferRegion();
+
+    // outputs 1-2 carry the master, 3-4 the headphone cue when the device has them
+    auto* output = bufferToFill.buffer;
+    auto hasCueOutputs = output->getNumChannels() >= 4;
+    cueBusRouted = hasCueOutputs;
+
+    auto numMasterChannels = jmin(2, output->getNumChannels());
+    auto step = 1.0f / (float) jmax(1, numSamples);
+
+    for (int i = 0; i < numDecks; ++i)
+    {
+        auto& deck = decks[i];
+        auto gain = crossfaderGain(position, deck.side, currentCurve);
+        auto cueGain = deck.pfl.load() ? 1.0f : 0.0f;
+
+        // one pass over the deck's lanes feeds both buses
+        for (int channel = 0; channel < numMasterChannels; ++channel)
+        {
+            auto* in = lanes.getReadPointer(i * 2 + channel);
+            auto* master = output->getWritePointer(channel, bufferToFill.startSample);
+            auto masterGain = deck.lastGain, masterStep = (gain - deck.lastGain) * step;
+
+            if (hasCueOutputs)
+            {
+                auto* cue = output->getWritePointer(channel + 2, bufferToFill.startSample);
+                auto pflGain = deck.lastCueGain, pflStep = (cueGain - deck.lastCueGain) * step;
+
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    master[sample] += masterGain * in[sample];
+                    cue[sample] += pflGain * in[sample];
+                    masterGain += masterStep;
+                    pflGain += pflStep;
+                }
+            }
+            else
+            {
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    master[sample] += masterGain * in[sample];
+                    masterGain += masterStep;
+                }
+            }
+        }
+
+        deck.lastGain = gain;
+        deck.lastCueGain = cueGain;
+    }
+
+    if (hasCueOutputs)
+    {
+        // blend the finished master into the headphones
+        auto blend = cueMix.load();
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto* master = output->getReadPointer(channel, bufferToFill.startSample);
+            auto* cue = output->getWritePointer(channel + 2, bufferToFill.startSample);
+            auto from = lastCueMix, blendStep = (blend - lastCueMix) * step;
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                cue[sample] += from * (master[sample] - cue[sample]);
+                from += blendStep;
+            }
+        }
+
+        lastCueMix = blend;
+    }
+
+    // headroom for the master, with the cue delayed alongside it
+    limiter.process(*output, bufferToFill.startSample, numSamples);
+
+    if (numMasterChannels > 0)
+        masterTap.push(output->getReadPointer(0, bufferToFill.startSample),
+                       output->getReadPointer(numMasterChannels - 1, bufferToFill.startSample), numSamples);
+
+    if (cueOnlySource != nullptr)
+    {
+        // rendered even with nowhere to go, so it still runs out and stops
+        if (numSamples > cueOnlyBuffer.getNumSamples())
+            cueOnlyBuffer.setSize(2, numSamples, false, true, true);
+
+        cueOnlySource->getNextAudioBlock(AudioSourceChannelInfo(&cueOnlyBuffer, 0, numSamples));
+
+        if (hasCueOutputs)
+            for (int channel = 0; channel < 2; ++channel)
+                output->addFrom(channel + 2, bufferToFill.startSample, cueOnlyBuffer, channel, 0, numSamples);
+    }
+}
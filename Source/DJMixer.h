@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    DJMixer.h
+    Created: 19 Oct 2026 4:10:31pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckEQ.h"
+#include "MasterLimiter.h"
+#include "MeterTap.h"
+
+class Automation;
+
+//==============================================================================
+/*
+    Replaces the MixerAudioSource: renders every deck into its own lanes, runs
+    them through the shared DeckEQ and sums them through the crossfader.
+
+    When the output buffer has four channels, channels 3-4 carry a headphone
+    cue bus: the decks with PFL on, blended with the master. Master and cue
+    are summed in the same pass over each deck's lanes. A cue-only source,
+    like the library preview, is added to the headphones after the blend and
+    never reaches the master.
+
+    The master then goes through a look-ahead limiter. Its latency is
+    reported by getLatencySamples, and the cue bus is delayed to match.
+
+    Each deck after its EQ, and the master after the limiter, are copied into
+    a MeterTap for the meters to read.
+
+    The setters are called from the message thread and picked up at the start
+    of the next block.
+*/
+class DJMixer : public AudioSource
+{
+public:
+    static constexpr int maxDecks = DeckEQ::maxDecks;
+
+    enum class CrossfaderSide { left, right, thru };
+    enum class CrossfaderCurve { linear, constantPower, cut };
+
+    DJMixer();
+    ~DJMixer() override;
+
+    /** add a deck before the audio device starts; returns its index */
+    int addDeck(AudioSource* deck, CrossfaderSide side);
+    int getNumDecks() const { return numDecks; }
+
+    /** 0 is hard left, 1 is hard right */
+    void setCrossfader(float position);
+    float getCrossfader() const { return crossfader.load(); }
+    void setCrossfaderCurve(CrossfaderCurve curve);
+
+    void setBandGain(int deck, DeckEQ::Band band, float gain);
+    float getBandGain(int deck, DeckEQ::Band band) const;
+    void setFilter(int deck, float amount);
+    float getFilter(int deck) const;
+
+    /** pre-fader listen: send this deck to the cue bus */
+    void setPfl(int deck, bool shouldListen);
+    bool isPfl(int deck) const;
+    /** 0 is cue only, 1 is master only in the headphones */
+    void setCueMix(float mix);
+    float getCueMix() const { return cueMix.load(); }
+    /** a source heard only in the headphones; set before the audio device starts */
+    void setCueOnlySource(AudioSource* source) { cueOnlySource = source; }
+    /** false when the device has no outputs for the cue bus */
+    bool isCueBusRouted() const { return cueBusRouted.load(); }
+
+    /** master bus limiter, for its ceiling, look-ahead and gain reduction */
+    MasterLimiter& getLimiter() { return limiter; }
+    /** how much later the outputs are than the decks, from the limiter */
+    int getLatencySamples() const { return limiter.getLatencySamples(); }
+
+    /** each deck's signal after the EQ, before the crossfader */
+    MeterTap& getDeckTap(int deck) { return deckTaps[deck]; }
+    /** the master as it leaves the limiter */
+    MeterTap& getMasterTap() { return masterTap; }
+
+    /** share of the block duration spent in the mixer, smoothed */
+    double getProcessingLoad() const { return loadMeasurer.getLoadAsProportion(); }
+
+    /** reports each control change to automation while it records; nullptr for none */
+    void setAutomation(Automation* newAutomation) { automation = newAutomation; }
+
+    //==============================================================================
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    static float crossfaderGain(float position, CrossfaderSide side, CrossfaderCurve curve);
+
+private:
+    struct DeckSlot
+    {
+        AudioSource* source = nullptr;
+        CrossfaderSide side = CrossfaderSide::thru;
+        std::atomic<float> bandGains[DeckEQ::numBands];
+        std::atomic<float> filter{ 0.0f };
+        std::atomic<bool> pfl{ false };
+        float lastGain = 1.0f;
+        float lastCueGain = 0.0f;
+    };
+
+    DeckSlot decks[maxDecks];
+    int numDecks = 0;
+
+    std::atomic<float> crossfader{ 0.5f };
+    std::atomic<int> curve{ (int) CrossfaderCurve::constantPower };
+    std::atomic<float> cueMix{ 0.0f };
+    float lastCueMix = 0.0f;
+    std::atomic<bool> cueBusRouted{ false };
+
+    AudioSource* cueOnlySource = nullptr;
+    Automation* automation = nullptr;
+    AudioBuffer<float> cueOnlyBuffer;
+
+    DeckEQ eq;
+    MasterLimiter limiter;
+    MeterTap deckTaps[maxDecks];
+    MeterTap masterTap;
+    AudioBuffer<float> lanes;
+    AudioProcessLoadMeasurer loadMeasurer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DJMixer)
+};
@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    DeckEQ.cpp
+    Created: 19 Oct 2026 3:22:47pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "DeckEQ.h"
+
+namespace
+{
+    const double lowCrossover = 250.0;
+    const double highCrossover = 2500.0;
+    const double butterworthQ = MathConstants<double>::sqrt2 * 0.5;
+
+    // fourth order Butterworth, as two second order sections
+    const double filterQs[2] = { 0.5412, 1.3066 };
+    const float filterDeadZone = 0.02f;
+    const double lowPassTop = 20000.0, lowPassBottom = 80.0;
+    const double highPassBottom = 20.0, highPassTop = 8000.0;
+
+    // coefficients are re-designed at most this often while the filter glides
+    const int subBlockSize = 16;
+    const double gainSmoothingSeconds = 0.01;
+    const double filterGlideSeconds = 0.05;
+}
+
+//==============================================================================
+void DeckEQ::Biquad::setIdentity(int lane)
+{
+    b0[lane] = 1.0f;
+    b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.0f;
+}
+
+void DeckEQ::Biquad::setLowPass(int lane, double sampleRate, double frequency, double q)
+{
+    auto w0 = MathConstants<double>::twoPi * frequency / sampleRate;
+    auto cosW0 = std::cos(w0);
+    auto alpha = std::sin(w0) / (2.0 * q);
+    auto a0 = 1.0 + alpha;
+
+    b0[lane] = (float) ((1.0 - cosW0) * 0.5 / a0);
+    b1[lane] = (float) ((1.0 - cosW0) / a0);
+    b2[lane] = b0[lane];
+    a1[lane] = (float) (-2.0 * cosW0 / a0);
+    a2[lane] = (float) ((1.0 - alpha) / a0);
+}
+
+void DeckEQ::Biquad::setHighPass(int lane, double sampleRate, double frequency, double q)
+{
+    auto w0 = MathConstants<double>::twoPi * frequency / sampleRate;
+    auto cosW0 = std::cos(w0);
+    auto alpha = std::sin(w0) / (2.0 * q);
+    auto a0 = 1.0 + alpha;
+
+    b0[lane] = (float) ((1.0 + cosW0) * 0.5 / a0);
+    b1[lane] = (float) (-(1.0 + cosW0) / a0);
+    b2[lane] = b0[lane];
+    a1[lane] = (float) (-2.0 * cosW0 / a0);
+    a2[lane] = (float) ((1.0 - alpha) / a0);
+}
+
+void DeckEQ::Biquad::setAllPass(int lane, double sampleRate, double frequency, double q)
+{
+    auto w0 = MathConstants<double>::twoPi * frequency / sampleRate;
+    auto cosW0 = std::cos(w0);
+    auto alpha = std::sin(w0) / (2.0 * q);
+    auto a0 = 1.0 + alpha;
+
+    b0[lane] = (float) ((1.0 - alpha) / a0);
+    b1[lane] = (float) (-2.0 * cosW0 / a0);
+    b2[lane] = 1.0f;
+    a1[lane] = b1[lane];
+    a2[lane] = b0[lane];
+}
+
+void DeckEQ::Biquad::clear()
+{
+    std::fill(std::begin(z1), std::end(z1), 0.0f);
+    std::fill(std::begin(z2), std::end(z2), 0.0f);
+}
+
+void DeckEQ::Biquad::process(float* samples) noexcept
+{
+    // transposed direct form II, one iteration per lane
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto in = samples[lane];
+        auto out = b0[lane] * in + z1[lane];
+        z1[lane] = b1[lane] * in - a1[lane] * out + z2[lane];
+        z2[lane] = b2[lane] * in - a2[lane] * out;
+        samples[lane] = out;
+    }
+}
+
+//==============================================================================
+DeckEQ::DeckEQ()
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        std::fill(std::begin(gains[band]), std::end(gains[band]), 1.0f);
+        std::fill(std::begin(targetGains[band]), std::end(targetGains[band]), 1.0f);
+    }
+
+    std::fill(std::begin(filterAmount), std::end(filterAmount), 0.0f);
+    std::fill(std::begin(targetFilterAmount), std::end(targetFilterAmount), 0.0f);
+
+    prepare(sampleRate);
+}
+
+void DeckEQ::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    designCrossovers();
+    for (int deck = 0; deck < maxDecks; ++deck)
+        designFilter(deck);
+
+    reset();
+}
+
+void DeckEQ::reset()
+{
+    for (auto* biquad : { &lowPass[0], &lowPass[1], &lowAllPass, &restHighPass[0], &restHighPass[1],
+                          &midLowPass[0], &midLowPass[1], &highHighPass[0], &highHighPass[1],
+                          &filter[0], &filter[1] })
+        biquad->clear();
+}
+
+void DeckEQ::setBandGain(int deck, Band band, float gain)
+{
+    if (isPositiveAndBelow(deck, maxDecks) && isPositiveAndBelow((int) band, (int) numBands))
+        targetGains[band][deck] = jmax(0.0f, gain);
+}
+
+void DeckEQ::setFilter(int deck, float amount)
+{
+    if (isPositiveAndBelow(deck, maxDecks))
+        targetFilterAmount[deck] = jlimit(-1.0f, 1.0f, amount);
+}
+
+void DeckEQ::designCrossovers()
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            lowPass[stage].setLowPass(lane, sampleRate, lowCrossover, butterworthQ);
+            restHighPass[stage].setHighPass(lane, sampleRate, lowCrossover, butterworthQ);
+            midLowPass[stage].setLowPass(lane, sampleRate, highCrossover, butterworthQ);
+            highHighPass[stage].setHighPass(lane, sampleRate, highCrossover, butterworthQ);
+        }
+
+        // matches the phase of the upper crossover, so low + mid + high stays flat
+        lowAllPass.setAllPass(lane, sampleRate, highCrossover, butterworthQ);
+    }
+}
+
+void DeckEQ::designFilter(int deck)
+{
+    auto amount = filterAmount[deck];
+    auto sweep = (std::abs(amount) - filterDeadZone) / (1.0f - filterDeadZone);
+    auto nyquistLimit = sampleRate * 0.45;
+
+    for (int lane = deck * 2; lane < deck * 2 + 2; ++lane)
+    {
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            if (sweep <= 0.0f)
+                filter[stage].setIdentity(lane);
+            else if (amount < 0.0f)
+                filter[stage].setLowPass(lane, sampleRate,
+                                         jmin(nyquistLimit, lowPassTop * std::pow(lowPassBottom / lowPassTop, (double) sweep)),
+                                         filterQs[stage]);
+            else
+                filter[stage].setHighPass(lane, sampleRate,
+                                          jmin(nyquistLimit, highPassBottom * std::pow(highPassTop / highPassBottom, (double) sweep)),
+                                          filterQs[stage]);
+        }
+    }
+}
+
+//==============================================================================
+void DeckEQ::process(AudioBuffer<float>& lanes, int numSamples)
+{
+    jassert(lanes.getNumChannels() >= numLanes);
+    ScopedNoDenormals noDenormals;
+
+    float* data[numLanes];
+    for (int lane = 0; lane < numLanes; ++lane)
+        data[lane] = lanes.getWritePointer(lane);
+
+    auto gainSmoothingSamples = (float) (sampleRate * gainSmoothingSeconds);
+    auto maxFilterStep = (float) (subBlockSize / (sampleRate * filterGlideSeconds));
+
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        auto numThisTime = jmin(subBlockSize, numSamples - start);
+
+        for (int deck = 0; deck < maxDecks; ++deck)
+        {
+            auto distance = targetFilterAmount[deck] - filterAmount[deck];
+            if (distance != 0.0f)
+            {
+                filterAmount[deck] += jlimit(-maxFilterStep, maxFilterStep, distance);
+                designFilter(deck);
+            }
+        }
+
+        alignas(32) float gainSteps[numBands][numLanes];
+        auto fraction = jmin(1.0f, numThisTime / gainSmoothingSamples) / numThisTime;
+        for (int band = 0; band < numBands; ++band)
+            for (int lane = 0; lane < numLanes; ++lane)
+                gainSteps[band][lane] = (targetGains[band][lane / 2] - gains[band][lane]) * fraction;
+
+        for (int i = start; i < start + numThisTime; ++i)
+        {
+            alignas(32) float x[numLanes], lowBand[numLanes], midBand[numLanes], highBand[numLanes];
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                x[lane] = lowBand[lane] = midBand[lane] = data[lane][i];
+
+            lowPass[0].process(lowBand);
+            lowPass[1].process(lowBand);
+            lowAllPass.process(lowBand);
+
+            restHighPass[0].process(midBand);
+            restHighPass[1].process(midBand);
+            std::copy(std::begin(midBand), std::end(midBand), highBand);
+
+            midLowPass[0].process(midBand);
+            midLowPass[1].process(midBand);
+            highHighPass[0].process(highBand);
+            highHighPass[1].process(highBand);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                gains[low][lane] += gainSteps[low][lane];
+                gains[mid][lane] += gainSteps[mid][lane];
+                gains[high][lane] += gainSteps[high][lane];
+
+                x[lane] = gains[low][lane] * lowBand[lane]
+                        + gains[mid][lane] * midBand[lane]
+                        + gains[high][lane] * highBand[lane];
+            }
+
+            filter[0].process(x);
+            filter[1].process(x);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                data[lane][i] = x[lane];
+        }
+    }
+}
+
+//==============================================================================
+void DeckEQ::benchmark()
+{
+    const double rate = 48000.0;
+    const double secondsOfAudio = 20.0;
+
+    std::cout << "Deck EQ and filter, " << rate / 1000.0 << " kHz, " << maxDecks << " stereo decks" << std::endl;
+
+    Random random(20261019);
+
+    for (auto size : { 16, 32, 64, 128, 256, 512 })
+    {
+        DeckEQ eq;
+        eq.prepare(rate);
+
+        AudioBuffer<float> lanes(numLanes, size);
+        auto numBlocks = (int) (rate * secondsOfAudio) / size;
+        auto blocksPerSweep = jmax(1, (int) (rate * 0.25) / size);
+        int64 ticks = 0;
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+                for (int n = 0; n < size; ++n)
+                    lanes.setSample(lane, n, random.nextFloat() - 0.5f);
+
+            // the filters glide and the gains ramp the whole time, the most work there is
+            if (i % blocksPerSweep == 0)
+            {
+                auto up = (i / blocksPerSweep) % 2 == 0;
+
+                for (int deck = 0; deck < maxDecks; ++deck)
+                {
+                    eq.setFilter(deck, up ? 0.8f : -0.8f);
+
+                    for (int band = 0; band < numBands; ++band)
+                        eq.setBandGain(deck, (Band) band, up ? 0.0f : 1.0f);
+                }
+            }
+
+            auto start = Time::getHighResolutionTicks();
+            eq.process(lanes, size);
+            ticks += Time::getHighResolutionTicks() - start;
+        }
+
+        auto seconds = Time::highResolutionTicksToSeconds(ticks);
+        std::cout << "  " << String(size).paddedLeft(' ', 3) << " samples: "
+                  << String(seconds * 1.0e6 / numBlocks, 2) << " us per block, "
+                  << String(seconds * 1.0e6 / numBlocks / maxDecks, 2) << " us per deck, "
+                  << String(100.0 * seconds / secondsOfAudio / maxDecks, 3) << "% of one core per deck" << std::endl;
+    }
+}
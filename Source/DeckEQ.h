@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    DeckEQ.h
+    Created: 19 Oct 2026 3:22:47pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Three-band kill EQ and sweepable HP/LP filter for every deck at once.
+
+    Each lane is one channel of one deck, and every biquad keeps its
+    coefficients and state as one array per term across the lanes, so the
+    per-sample loops run over all lanes together and compile to SIMD.
+
+    The bands come from two Linkwitz-Riley crossovers. The low band also goes
+    through the upper crossover's allpass, so the bands sum flat at unity and
+    a band at zero gain is really gone. Band gains ramp per sample, and the
+    filter cutoff glides and is re-designed every few samples.
+
+    Not thread safe: the mixer owns it and drives it from the audio thread.
+*/
+class DeckEQ
+{
+public:
+    static constexpr int maxDecks = 4;
+    static constexpr int numLanes = maxDecks * 2;
+
+    enum Band { low, mid, high, numBands };
+
+    DeckEQ();
+
+    void prepare(double sampleRate);
+    void reset();
+
+    /** linear gain, 0 kills the band and 1 leaves it alone */
+    void setBandGain(int deck, Band band, float gain);
+    /** -1 is a fully closed low pass, 0 is off, +1 is a fully closed high pass */
+    void setFilter(int deck, float amount);
+
+    /** filters lanes in place; channel n of the buffer is lane n */
+    void process(AudioBuffer<float>& lanes, int numSamples);
+
+    /** times process at small block sizes with every deck sweeping, and prints the
+        cost of each block and each deck's share of it */
+    static void benchmark();
+
+private:
+    struct Biquad
+    {
+        alignas(32) float b0[numLanes], b1[numLanes], b2[numLanes], a1[numLanes], a2[numLanes];
+        alignas(32) float z1[numLanes], z2[numLanes];
+
+        void setIdentity(int lane);
+        void setLowPass(int lane, double sampleRate, double frequency, double q);
+        void setHighPass(int lane, double sampleRate, double frequency, double q);
+        void setAllPass(int lane, double sampleRate, double frequency, double q);
+        void clear();
+
+        void process(float* samples) noexcept;
+    };
+
+    void designCrossovers();
+    void designFilter(int deck);
+
+    double sampleRate = 44100.0;
+
+    Biquad lowPass[2], lowAllPass, restHighPass[2], midLowPass[2], highHighPass[2];
+    Biquad filter[2];
+
+    alignas(32) float gains[numBands][numLanes];
+    float targetGains[numBands][maxDecks];
+    float filterAmount[maxDecks];
+    float targetFilterAmount[maxDecks];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckEQ)
+};
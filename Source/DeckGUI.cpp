@@ -1,233 +1,524 @@
-﻿#include "../JuceLibraryCode/JuceHeader.h"
-#include "DeckGUI.h"
-
-//==============================================================================
-
-DeckGUI::DeckGUI(int trackNum,
-    DJAudioPlayer* _player,
-    AudioFormatManager& formatManagerToUse,
-    AudioThumbnailCache& cacheToUse)
-    : trackNumber(trackNum),
-      player(_player),
-    formatManager(formatManagerToUse),
-    waveformDisplay(formatManagerToUse, cacheToUse)
-{
-    waveformDisplay.addChangeListener(this); //listener For draging song position using mouse!
-
-    // Set label properties
-    trackLabel.setFont(Font(18.0f, Font::bold));
-    trackLabel.setJustificationType(Justification::centred);
-    trackLabel.setColour(Label::textColourId, Colours::white);
-
-    // Assign Track Name based on track number
-    trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
-
-    // Add label to the component
-    addAndMakeVisible(trackLabel);
-
-    // Set button texts with symbols for better UX
-     // Initialize buttons with default styles
-    customizeButton(playButton, "Play");
-    customizeButton(stopButton, "Stop");
-    customizeButton(loadButton, "Load Track");
-
-    // Add components to the UI
-    addAndMakeVisible(playButton);
-    addAndMakeVisible(stopButton);
-    addAndMakeVisible(loadButton);
-    addAndMakeVisible(volSlider);
-    addAndMakeVisible(speedSlider);
-    addAndMakeVisible(waveformDisplay);
-
-    // Assign event listeners
-    playButton.addListener(this);
-    stopButton.addListener(this);
-    loadButton.addListener(this);
-    volSlider.addListener(this);
-    speedSlider.addListener(this);
-
-    // Slider appearance customization
-    volSlider.setRange(0.0, 1.0);
-    speedSlider.setRange(0.1, 4.0); // Updated speed range for better control
-
-    volSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 80, 20);
-    speedSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 80, 20);
-
-    volSlider.setColour(Slider::thumbColourId, Colours::cyan);
-    speedSlider.setColour(Slider::thumbColourId, Colours::orange);
-
-    volSlider.setColour(Slider::trackColourId, Colours::darkcyan);
-    speedSlider.setColour(Slider::trackColourId, Colours::darkorange);
-
-    startTimer(30); // Updates every 30ms for smoother animation
-
-    DBG("DeckGUI initialized.");
-}
-
-DeckGUI::~DeckGUI()
-{
-    stopTimer();
-}
-
-void DeckGUI::paint(Graphics& g)
-{
-    // Create a gradient background from dark to light
-    ColourGradient backgroundGradient(Colours::black, 0, 0, Colours::darkblue, getWidth(), getHeight(), false);
-    g.setGradientFill(backgroundGradient);
-    g.fillAll();
-
-    // Draw a subtle border
-    g.setColour(Colours::darkgrey);
-    g.drawRect(getLocalBounds(), 2);
-}
-
-void DeckGUI::resized()
-{
-    auto bounds = getLocalBounds().reduced(10); // Add padding around elements
-
-    // Label - Reserve a small portion at the top
-    auto labelArea = bounds.removeFromTop(30);
-    trackLabel.setBounds(labelArea);
-
-    // Increase Waveform Display height to use extra space (55% of total height)
-    auto waveformArea = bounds.removeFromTop(bounds.getHeight() * 0.55);
-    waveformDisplay.setBounds(waveformArea);
-
-    // Sliders - Placed below waveform with spacing
-    auto sliderHeight = 40;
-    volSlider.setBounds(bounds.removeFromTop(sliderHeight).reduced(5));
-    speedSlider.setBounds(bounds.removeFromTop(sliderHeight).reduced(5));
-
-    // Play & Stop Buttons - Side by side with padding
-    auto buttonArea = bounds.removeFromTop(50);
-    playButton.setBounds(buttonArea.removeFromLeft(buttonArea.getWidth() / 2).reduced(8));
-    stopButton.setBounds(buttonArea.reduced(8));
-
-    // Load Track Directly Button - Below Play/Stop
-    loadButton.setBounds(bounds.removeFromTop(50).reduced(8));
-}
-
-// Function to style buttons
-void DeckGUI::customizeButton(TextButton& button, String buttonText)
-{
-    button.setButtonText(buttonText);
-    button.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));  // Dark grey base color
-    button.setColour(TextButton::textColourOffId, Colours::white);
-    button.setColour(TextButton::textColourOnId, Colours::white);
-    button.setColour(TextButton::buttonOnColourId, Colours::orange);  // Highlight on press
-
-    // Adding Hover Effect
-    //button.onMouseEnter = [&]() { button.setColour(TextButton::buttonColourId, Colour::fromRGB(70, 70, 70)); };
-    //button.onMouseExit = [&]() { button.setColour(TextButton::buttonColourId, Colour::fromRGB(50, 50, 50)); };
-}
-
-
-
-
-
-
-
-void DeckGUI::buttonClicked(Button* button)
-{
-    if (button == &playButton)
-    {
-        DBG("▶️ Play button clicked!");
-        player->start();
-
-        // 🔹 Check if player is actually playing
-        DBG("🎵 Is player playing? " + String(player->isPlaying() ? "YES" : "NO"));
-    }
-
-    if (button == &stopButton)
-    {
-        DBG("⏹ Stop button clicked!");
-        player->stop();
-    }
-
-    if (button == &loadButton)
-    {
-        auto fileChooserFlags =
-            FileBrowserComponent::canSelectFiles;
-        fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
-            {
-                File chosenFile = chooser.getResult();
-                if (chosenFile.exists()) {
-                    player->loadURL(URL{ chooser.getResult() });
-                    waveformDisplay.loadURL(URL{ chooser.getResult() });
-                }
-            });
-    }
-}
-
-
-void DeckGUI::sliderValueChanged(Slider* slider)
-{
-    if (slider == &volSlider)
-    {
-        player->setGain(slider->getValue());
-    }
-
-    if (slider == &speedSlider)
-    {
-        player->setSpeed(slider->getValue());
-    }
-
-}
-
-bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
-{
-    return true;
-}
-
-void DeckGUI::filesDropped(const StringArray& files, int x, int y)
-{
-    if (files.size() == 1)
-    {
-        player->loadURL(URL{ File{files[0]} });
-    }
-}
-
-void DeckGUI::timerCallback()
-{
-    if (!waveformDisplay.isMouseButtonDown())  // Prevents override during user interaction
-    {
-        waveformDisplay.setPositionRelative(player->getPositionRelative());
-    }
-
-}
-
-void DeckGUI::loadTrack(const File& file)
-{
-    DBG("✅ DeckGUI - Loading track: " + file.getFullPathName());
-
-    if (!file.existsAsFile())
-    {
-        DBG("❌ DeckGUI - Error: File does not exist! " + file.getFullPathName());
-        return;
-    }
-
-    player->stop();  // Stop any existing playback
-    player->loadURL(URL(file));  // Load the new track
-    waveformDisplay.loadURL(URL(file));  // Update waveform display
-
-    DBG("▶️ Auto-playing track...");
-    player->start();  // ✅ Automatically start playing
-
-    DBG("✅ DeckGUI - Track successfully loaded and playing: " + file.getFileName());
-}
-
-
-void DeckGUI::changeListenerCallback(ChangeBroadcaster* source)
-{
-    DBG("Seeking to changeListenerCallback: ");
-
-    if (source == &waveformDisplay)  // Ensure it's coming from waveform
-    {
-        double newPos = waveformDisplay.getPosition();
-        DBG("Seeking to: " + String(newPos));
-
-        player->setPositionRelative(newPos); // ✅ Actually seek in audio
-    }
-
-}
-
+﻿#include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckGUI.h"
+#include "Tracer.h"
+#include "HttpTrackStream.h"
+
+namespace
+{
+    /** a track's file name without its extension, for the label */
+    String getTrackName(const URL& url)
+    {
+        return URL::removeEscapeChars(url.getFileName()).upToLastOccurrenceOf(".", false, false);
+    }
+}
+
+//==============================================================================
+
+DeckGUI::DeckGUI(int trackNum,
+    DJAudioPlayer* _player,
+    AudioFormatManager& formatManagerToUse,
+    AudioThumbnailCache& cacheToUse)
+    : trackNumber(trackNum),
+      player(_player),
+    formatManager(formatManagerToUse),
+    waveformDisplay(formatManagerToUse, cacheToUse)
+{
+    waveformDisplay.addChangeListener(this); //listener For draging song position using mouse!
+
+    // Set label properties
+    trackLabel.setFont(Font(18.0f, Font::bold));
+    trackLabel.setJustificationType(Justification::centred);
+    trackLabel.setColour(Label::textColourId, Colours::white);
+
+    // Assign Track Name based on track number
+    trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
+
+    // Add label to the component
+    addAndMakeVisible(trackLabel);
+
+    // A queued track has taken over without a gap - Show it
+    player->onTrackChanged = [this](const URL& url)
+    {
+        waveformDisplay.loadURL(url);
+        trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
+        refreshCueButtons();
+    };
+
+    // Set button texts with symbols for better UX
+     // Initialize buttons with default styles
+    customizeButton(playButton, "Play");
+    customizeButton(stopButton, "Stop");
+    customizeButton(loadButton, "Load Track");
+
+    for (int i = 0; i < CueWindowSource::maxCues; ++i)
+    {
+        customizeButton(cueButtons[i], "CUE " + String(i + 1));
+        cueButtons[i].setTooltip("Click to set or jump, shift-click to clear");
+        addAndMakeVisible(cueButtons[i]);
+        cueButtons[i].addListener(this);
+    }
+
+    // Tempo sync - Follow the master clock, or become the deck it follows
+    customizeButton(syncButton, "SYNC");
+    customizeButton(masterButton, "MASTER");
+    syncButton.setClickingTogglesState(true);
+    masterButton.setClickingTogglesState(true);
+    addAndMakeVisible(syncButton);
+    addAndMakeVisible(masterButton);
+    syncButton.addListener(this);
+    masterButton.addListener(this);
+
+    // Jog - Dragging the waveform scratches instead of seeking, REV plays backwards
+    customizeButton(jogButton, "JOG");
+    customizeButton(reverseButton, "REV");
+    jogButton.setClickingTogglesState(true);
+    reverseButton.setClickingTogglesState(true);
+    addAndMakeVisible(jogButton);
+    addAndMakeVisible(reverseButton);
+    jogButton.addListener(this);
+    reverseButton.addListener(this);
+
+    waveformDisplay.onScratchStart = [this] { player->beginScratch(); };
+    waveformDisplay.onScratchMove = [this](double seconds) { player->scratchTo(seconds); };
+    waveformDisplay.onScratchEnd = [this] { player->endScratch(); };
+
+    bpmLabel.setJustificationType(Justification::centred);
+    bpmLabel.setColour(Label::textColourId, Colours::orange);
+    addAndMakeVisible(bpmLabel);
+
+    // Effects - One toggle per effect, the two knobs drive every enabled effect
+    for (int i = 0; i < EffectsRack::numEffects; ++i)
+    {
+        customizeButton(effectButtons[i], EffectsRack::getEffectName((EffectsRack::Effect) i));
+        effectButtons[i].setClickingTogglesState(true);
+        addAndMakeVisible(effectButtons[i]);
+        effectButtons[i].addListener(this);
+    }
+
+    for (auto* knob : { &effectMixSlider, &effectAmountSlider })
+    {
+        knob->setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+        knob->setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+        knob->setRange(0.0, 1.0);
+        knob->setValue(0.5, dontSendNotification);
+        knob->setColour(Slider::rotarySliderFillColourId, Colours::orange);
+        addAndMakeVisible(knob);
+        knob->addListener(this);
+    }
+    effectMixSlider.setTooltip("Effect dry/wet");
+    effectAmountSlider.setTooltip("Effect time, size or depth");
+
+    // Stems - A mute toggle and a level knob each, only enabled when a stem track is loaded
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        customizeButton(stemButtons[i], StemReader::getStemName(i));
+        stemButtons[i].setClickingTogglesState(true);
+        stemButtons[i].setTooltip("Mute this stem");
+        addAndMakeVisible(stemButtons[i]);
+        stemButtons[i].addListener(this);
+
+        stemSliders[i].setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+        stemSliders[i].setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+        stemSliders[i].setRange(0.0, 1.0);
+        stemSliders[i].setValue(1.0, dontSendNotification);
+        stemSliders[i].setColour(Slider::rotarySliderFillColourId, Colours::cyan);
+        addAndMakeVisible(stemSliders[i]);
+        stemSliders[i].addListener(this);
+    }
+    refreshStemControls();
+
+    // Add components to the UI
+    addAndMakeVisible(playButton);
+    addAndMakeVisible(stopButton);
+    addAndMakeVisible(loadButton);
+    addAndMakeVisible(volSlider);
+    addAndMakeVisible(speedSlider);
+    addAndMakeVisible(waveformDisplay);
+
+    // Assign event listeners
+    playButton.addListener(this);
+    stopButton.addListener(this);
+    loadButton.addListener(this);
+    volSlider.addListener(this);
+    speedSlider.addListener(this);
+
+    // Slider appearance customization
+    volSlider.setRange(0.0, 1.0);
+    speedSlider.setRange(0.1, 4.0); // Updated speed range for better control
+
+    volSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 80, 20);
+    speedSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 80, 20);
+
+    volSlider.setColour(Slider::thumbColourId, Colours::cyan);
+    speedSlider.setColour(Slider::thumbColourId, Colours::orange);
+
+    volSlider.setColour(Slider::trackColourId, Colours::darkcyan);
+    speedSlider.setColour(Slider::trackColourId, Colours::darkorange);
+
+    startTimerHz(60); // Playhead follows the display refresh rate
+
+    DBG("DeckGUI initialized.");
+}
+
+DeckGUI::~DeckGUI()
+{
+    stopTimer();
+}
+
+void DeckGUI::paint(Graphics& g)
+{
+    TRACE_SPAN("DeckGUI::paint");
+
+    // Create a gradient background from dark to light
+    ColourGradient backgroundGradient(Colours::black, 0, 0, Colours::darkblue, getWidth(), getHeight(), false);
+    g.setGradientFill(backgroundGradient);
+    g.fillAll();
+
+    // Draw a subtle border
+    g.setColour(Colours::darkgrey);
+    g.drawRect(getLocalBounds(), 2);
+}
+
+void DeckGUI::resized()
+{
+    auto bounds = getLocalBounds().reduced(10); // Add padding around elements
+
+    // Label - Reserve a small portion at the top
+    auto labelArea = bounds.removeFromTop(30);
+    trackLabel.setBounds(labelArea);
+
+    // Waveform Display gets whatever the fixed rows below leave over
+    auto controlsHeight = 2 * 40 + 4 * 40 + 2 * 50;
+    auto waveformArea = bounds.removeFromTop(jmax(60, bounds.getHeight() - controlsHeight));
+    waveformDisplay.setBounds(waveformArea);
+
+    // Sliders - Placed below waveform with spacing
+    auto sliderHeight = 40;
+    volSlider.setBounds(bounds.removeFromTop(sliderHeight).reduced(5));
+    speedSlider.setBounds(bounds.removeFromTop(sliderHeight).reduced(5));
+
+    // Hot cue buttons - One row, equal widths
+    auto cueArea = bounds.removeFromTop(40);
+    auto cueWidth = cueArea.getWidth() / CueWindowSource::maxCues;
+    for (auto& cueButton : cueButtons)
+        cueButton.setBounds(cueArea.removeFromLeft(cueWidth).reduced(4));
+
+    // Sync row - Master, Sync, Jog, Reverse and the current tempo
+    auto syncArea = bounds.removeFromTop(40);
+    auto syncWidth = syncArea.getWidth() / 5;
+    masterButton.setBounds(syncArea.removeFromLeft(syncWidth).reduced(4));
+    syncButton.setBounds(syncArea.removeFromLeft(syncWidth).reduced(4));
+    jogButton.setBounds(syncArea.removeFromLeft(syncWidth).reduced(4));
+    reverseButton.setBounds(syncArea.removeFromLeft(syncWidth).reduced(4));
+    bpmLabel.setBounds(syncArea.reduced(4));
+
+    // Effects row - Toggles then the mix and amount knobs
+    auto effectArea = bounds.removeFromTop(40);
+    auto effectWidth = effectArea.getWidth() / (EffectsRack::numEffects + 2);
+    for (auto& effectButton : effectButtons)
+        effectButton.setBounds(effectArea.removeFromLeft(effectWidth).reduced(2));
+    effectMixSlider.setBounds(effectArea.removeFromLeft(effectWidth));
+    effectAmountSlider.setBounds(effectArea);
+
+    // Stems row - Each stem's mute with its level knob beside it
+    auto stemArea = bounds.removeFromTop(40);
+    auto stemWidth = stemArea.getWidth() / StemReader::maxStems;
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        auto cell = stemArea.removeFromLeft(stemWidth);
+        stemSliders[i].setBounds(cell.removeFromRight(cell.getHeight()));
+        stemButtons[i].setBounds(cell.reduced(2));
+    }
+
+    // Play & Stop Buttons - Side by side with padding
+    auto buttonArea = bounds.removeFromTop(50);
+    playButton.setBounds(buttonArea.removeFromLeft(buttonArea.getWidth() / 2).reduced(8));
+    stopButton.setBounds(buttonArea.reduced(8));
+
+    // Load Track Directly Button - Below Play/Stop
+    loadButton.setBounds(bounds.removeFromTop(50).reduced(8));
+}
+
+// Function to style buttons
+void DeckGUI::customizeButton(TextButton& button, String buttonText)
+{
+    button.setButtonText(buttonText);
+    button.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));  // Dark grey base color
+    button.setColour(TextButton::textColourOffId, Colours::white);
+    button.setColour(TextButton::textColourOnId, Colours::white);
+    button.setColour(TextButton::buttonOnColourId, Colours::orange);  // Highlight on press
+
+    // Adding Hover Effect
+    //button.onMouseEnter = [&]() { button.setColour(TextButton::buttonColourId, Colour::fromRGB(70, 70, 70)); };
+    //button.onMouseExit = [&]() { button.setColour(TextButton::buttonColourId, Colour::fromRGB(50, 50, 50)); };
+}
+
+
+
+
+
+
+
+void DeckGUI::buttonClicked(Button* button)
+{
+    if (button == &playButton)
+    {
+        DBG("▶️ Play button clicked!");
+        player->start();
+
+        // 🔹 Check if player is actually playing
+        DBG("🎵 Is player playing? " + String(player->isPlaying() ? "YES" : "NO"));
+    }
+
+    if (button == &stopButton)
+    {
+        DBG("⏹ Stop button clicked!");
+        player->stop();
+    }
+
+    if (button == &loadButton)
+    {
+        auto fileChooserFlags =
+            FileBrowserComponent::canSelectFiles;
+        fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
+            {
+                File chosenFile = chooser.getResult();
+                if (chosenFile.exists()) {
+                    player->loadURL(URL{ chooser.getResult() });
+                    waveformDisplay.loadURL(URL{ chooser.getResult() });
+                    trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
+                    refreshCueButtons();
+                }
+            });
+    }
+
+    if (button == &syncButton)
+    {
+        player->setSyncEnabled(syncButton.getToggleState());
+    }
+
+    if (button == &masterButton)
+    {
+        player->makeMaster();
+    }
+
+    if (button == &jogButton)
+    {
+        waveformDisplay.setJogMode(jogButton.getToggleState());
+    }
+
+    if (button == &reverseButton)
+    {
+        player->setReverse(reverseButton.getToggleState());
+    }
+
+    for (int i = 0; i < EffectsRack::numEffects; ++i)
+    {
+        if (button == &effectButtons[i])
+            player->setEffectEnabled((EffectsRack::Effect) i, button->getToggleState());
+    }
+
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        if (button == &stemButtons[i])
+            player->setStemMuted(i, button->getToggleState());
+    }
+
+    for (int i = 0; i < CueWindowSource::maxCues; ++i)
+    {
+        if (button != &cueButtons[i])
+            continue;
+
+        if (ModifierKeys::getCurrentModifiers().isShiftDown())
+            player->clearHotCue(i);
+        else if (player->hasHotCue(i))
+            player->jumpToHotCue(i);
+        else
+            player->setHotCue(i);
+
+        refreshCueButtons();
+    }
+}
+
+void DeckGUI::refreshCueButtons()
+{
+    for (int i = 0; i < CueWindowSource::maxCues; ++i)
+    {
+        auto colour = player->hasHotCue(i) ? Colours::darkorange : Colour::fromRGB(90, 10, 70);
+
+        // this runs on every timer tick, so only repaint buttons that changed
+        if (cueButtons[i].findColour(TextButton::buttonColourId) != colour)
+            cueButtons[i].setColour(TextButton::buttonColourId, colour);
+    }
+}
+
+
+void DeckGUI::refreshStemControls()
+{
+    auto numStems = player->getNumStems();
+
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        // a track with one stem is an ordinary track, with nothing to separate
+        auto hasStem = numStems > 1 && i < numStems;
+
+        if (stemButtons[i].isEnabled() != hasStem)
+        {
+            stemButtons[i].setEnabled(hasStem);
+            stemSliders[i].setEnabled(hasStem);
+        }
+
+        stemButtons[i].setToggleState(player->isStemMuted(i), dontSendNotification);
+
+        if (!stemSliders[i].isMouseButtonDown())
+            stemSliders[i].setValue(player->getStemGain(i), dontSendNotification);
+    }
+}
+
+void DeckGUI::sliderValueChanged(Slider* slider)
+{
+    if (slider == &volSlider)
+    {
+        player->setGain(slider->getValue());
+    }
+
+    if (slider == &speedSlider)
+    {
+        player->setSpeed(slider->getValue());
+    }
+
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        if (slider == &stemSliders[i])
+            player->setStemGain(i, (float) slider->getValue());
+    }
+
+    for (int i = 0; i < EffectsRack::numEffects; ++i)
+    {
+        if (slider == &effectMixSlider)
+            player->setEffectMix((EffectsRack::Effect) i, (float) slider->getValue());
+
+        if (slider == &effectAmountSlider)
+            player->setEffectAmount((EffectsRack::Effect) i, (float) slider->getValue());
+    }
+
+}
+
+bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
+{
+    return true;
+}
+
+void DeckGUI::filesDropped(const StringArray& files, int x, int y)
+{
+    if (files.size() == 1)
+        loadDropped(URL{ File{ files[0] } });
+}
+
+bool DeckGUI::isInterestedInTextDrag(const String& text)
+{
+    return HttpTrackStream::isRemote(URL{ text.trim() });
+}
+
+void DeckGUI::textDropped(const String& text, int x, int y)
+{
+    loadDropped(URL{ text.trim() });
+}
+
+void DeckGUI::loadDropped(const URL& url)
+{
+    // Dropped on a playing deck, it follows on without a gap instead of cutting in
+    if (player->isPlaying() && player->queueNext(url))
+    {
+        trackLabel.setText("Track: " + String(trackNumber) + "  |  Next: " + getTrackName(url), dontSendNotification);
+        return;
+    }
+
+    player->loadURL(url);
+    waveformDisplay.loadURL(url);
+    trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
+    refreshCueButtons();
+}
+
+void DeckGUI::showLoadedTrack()
+{
+    if (!player->isLoaded())
+        return;
+
+    // The waveform comes straight from the on-disk cache when it has been drawn before
+    waveformDisplay.loadURL(player->getLoadedURL());
+    volSlider.setValue(player->getGain(), dontSendNotification);
+    speedSlider.setValue(player->getSpeedSetting(), dontSendNotification);
+    reverseButton.setToggleState(player->isReverse(), dontSendNotification);
+
+    auto queued = player->getQueuedURL();
+    trackLabel.setText("Track: " + String(trackNumber) + (queued.isEmpty() ? String() : "  |  Next: " + getTrackName(queued)),
+                       dontSendNotification);
+
+    refreshCueButtons();
+    refreshStemControls();
+}
+
+void DeckGUI::timerCallback()
+{
+    if (!waveformDisplay.isMouseButtonDown())  // Prevents override during user interaction
+    {
+        // Interpolated from what the audio thread last published, never read from the transport
+        waveformDisplay.setPositionRelative(player->getPlayheadClock().getPositionRelative());
+    }
+
+    // The other deck, or a MIDI controller, may have changed these since the last tick
+    masterButton.setToggleState(player->isMaster(), dontSendNotification);
+    syncButton.setToggleState(player->isSyncEnabled(), dontSendNotification);
+    refreshCueButtons();
+    refreshStemControls();
+    bpmLabel.setText(player->hasBeatGrid() ? String(player->getEffectiveBpm(), 1) + " BPM" : "--- BPM",
+                     dontSendNotification);
+
+}
+
+void DeckGUI::loadTrack(const File& file, bool autoStart)
+{
+    TRACE_SPAN("DeckGUI::loadTrack");
+
+    DBG("✅ DeckGUI - Loading track: " + file.getFullPathName());
+
+    if (!file.existsAsFile())
+    {
+        DBG("❌ DeckGUI - Error: File does not exist! " + file.getFullPathName());
+        return;
+    }
+
+    player->stop();  // Stop any existing playback
+    player->loadURL(URL(file));  // Load the new track, dropping anything queued
+    trackLabel.setText("Track: " + String(trackNumber), dontSendNotification);
+    waveformDisplay.loadURL(URL(file));  // Update waveform display
+    refreshCueButtons();
+
+    if (!autoStart)
+    {
+        DBG("✅ DeckGUI - Track cued: " + file.getFileName());
+        return;
+    }
+
+    DBG("▶️ Auto-playing track...");
+    player->start();  // ✅ Automatically start playing
+
+    DBG("✅ DeckGUI - Track successfully loaded and playing: " + file.getFileName());
+}
+
+
+void DeckGUI::changeListenerCallback(ChangeBroadcaster* source)
+{
+    DBG("Seeking to changeListenerCallback: ");
+
+    if (source == &waveformDisplay)  // Ensure it's coming from waveform
+    {
+        double newPos = waveformDisplay.getPosition();
+        DBG("Seeking to: " + String(newPos));
+
+        player->setPositionRelative(newPos); // ✅ Actually seek in audio
+    }
+
+}
+
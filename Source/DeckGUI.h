@@ -1,80 +1,107 @@
-/*
-  ==============================================================================
-
-    DeckGUI.h
-    Created: 13 Mar 2020 6:44:48pm
-    Author:  matthew
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include "../JuceLibraryCode/JuceHeader.h"
-#include "DJAudioPlayer.h"
-#include "WaveformDisplay.h"
-
-//==============================================================================
-/*
-*/
-class DeckGUI    : public Component,
-                   public Button::Listener, 
-                   public Slider::Listener, 
-                   public FileDragAndDropTarget, 
-                   public Timer,
-                   public ChangeListener // New: Listen for waveform changes
-{
-public:
-    DeckGUI(int trackNum,
-           DJAudioPlayer* player,
-           AudioFormatManager & 	formatManagerToUse,
-           AudioThumbnailCache & 	cacheToUse );
-    ~DeckGUI();
-
-    void changeListenerCallback(ChangeBroadcaster* source) override;
-
-    void paint (Graphics&) override;
-    void resized() override;
-
-     /** implement Button::Listener */
-    void buttonClicked (Button *) override;
-
-    /** implement Slider::Listener */
-    void sliderValueChanged (Slider *slider) override;
-
-    bool isInterestedInFileDrag (const StringArray &files) override;
-    void filesDropped (const StringArray &files, int x, int y) override; 
-
-    void timerCallback() override; 
-
-    void loadTrack(const File& file);
-
-    void customizeButton(TextButton& button, String buttonText);
-
-private:
-
-
-    Label trackLabel; // Label for track name
-    int trackNumber;
-    juce::FileChooser fChooser{"Select a file..."};
-
-
-    TextButton playButton{"PLAY"};
-    TextButton stopButton{"STOP"};
-    TextButton loadButton{"LOAD"};
-  
-    Slider volSlider; 
-    Slider speedSlider;
-    //Slider posSlider;
-
-    WaveformDisplay waveformDisplay;
-
-    DJAudioPlayer* player; 
-
-    AudioTransportSource transportSource; // Added transport source
-    std::unique_ptr<AudioFormatReaderSource> audioFormatReaderSource; // Smart pointer for audio source
-    AudioFormatManager& formatManager; // Reference to format manager
-
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckGUI)
-};
+/*
+  ==============================================================================
+
+    DeckGUI.h
+    Created: 13 Mar 2020 6:44:48pm
+    Author:  matthew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+#include "WaveformDisplay.h"
+
+//==============================================================================
+/*
+*/
+class DeckGUI    : public Component,
+                   public Button::Listener, 
+                   public Slider::Listener, 
+                   public FileDragAndDropTarget, 
+                   public TextDragAndDropTarget, // Links to tracks on a media server
+                   public Timer,
+                   public ChangeListener // New: Listen for waveform changes
+{
+public:
+    DeckGUI(int trackNum,
+           DJAudioPlayer* player,
+           AudioFormatManager & 	formatManagerToUse,
+           AudioThumbnailCache & 	cacheToUse );
+    ~DeckGUI();
+
+    void changeListenerCallback(ChangeBroadcaster* source) override;
+
+    void paint (Graphics&) override;
+    void resized() override;
+
+     /** implement Button::Listener */
+    void buttonClicked (Button *) override;
+
+    /** implement Slider::Listener */
+    void sliderValueChanged (Slider *slider) override;
+
+    bool isInterestedInFileDrag (const StringArray &files) override;
+    void filesDropped (const StringArray &files, int x, int y) override; 
+
+    /** an http or https link dropped from a browser streams onto the deck */
+    bool isInterestedInTextDrag (const String& text) override;
+    void textDropped (const String& text, int x, int y) override;
+
+    void timerCallback() override; 
+
+    /** load a track onto this deck, starting it unless it is being cued for later */
+    void loadTrack(const File& file, bool autoStart = true);
+
+    void customizeButton(TextButton& button, String buttonText);
+
+    /** colour the hot cue buttons by whether their cue is stored */
+    void refreshCueButtons();
+
+    /** enable a stem's controls if the loaded track has that stem, and show its mute */
+    void refreshStemControls();
+
+    /** load a dropped track, or queue it to follow on if this deck is playing */
+    void loadDropped(const URL& url);
+
+    /** show what the player was given without this deck, as when a session is resumed */
+    void showLoadedTrack();
+
+private:
+
+
+    Label trackLabel; // Label for track name
+    int trackNumber;
+    juce::FileChooser fChooser{"Select a file..."};
+
+
+    TextButton playButton{"PLAY"};
+    TextButton stopButton{"STOP"};
+    TextButton loadButton{"LOAD"};
+    TextButton cueButtons[CueWindowSource::maxCues];
+    TextButton syncButton{"SYNC"};
+    TextButton masterButton{"MASTER"};
+    TextButton jogButton{"JOG"};
+    TextButton reverseButton{"REV"};
+    Label bpmLabel;
+    TextButton effectButtons[EffectsRack::numEffects];
+    Slider effectMixSlider;
+    Slider effectAmountSlider;
+    TextButton stemButtons[StemReader::maxStems];
+    Slider stemSliders[StemReader::maxStems];
+  
+    Slider volSlider; 
+    Slider speedSlider;
+    //Slider posSlider;
+
+    WaveformDisplay waveformDisplay;
+
+    DJAudioPlayer* player; 
+
+    AudioFormatManager& formatManager; // Reference to format manager
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckGUI)
+};
@@ -0,0 +1,476 @@
+/*
+  ==============================================================================
+
+    DuplicateFinder.cpp
+    Created: 21 Oct 2026 2:41:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "DuplicateFinder.h"
+#include "Tracer.h"
+
+namespace
+{
+    const double fingerprintRate = 11025.0;
+    const double excerptStartSeconds = 30.0;
+    const double excerptSeconds = 30.0;
+
+    const int fftOrder = 10;
+    const int fftSize = 1 << fftOrder;
+    const int hopSize = fftSize / 2;                        // about 46 ms at the fingerprint rate
+    const int bandEdges[] = { 10, 20, 40, 80, 160, 256, 372 }; // FFT bins, about 100 Hz to 4 kHz
+    const int numBands = 6;
+    const float silenceLevel = 0.1f;
+
+    const int fanOut = 3;           // targets paired with each peak
+    const int maxTargetFrames = 63; // fits the 6 bits the hash gives the time difference
+
+    const int minMatches = 12;
+    const float minMatchShare = 0.1f;
+
+    /** keeps one hash in eight, decided by the hash so every copy keeps the same ones */
+    bool keepHash(uint32 hash)
+    {
+        return ((hash * 2654435761u) >> 29) == 0;
+    }
+}
+
+//==============================================================================
+/** fingerprints a list of files on the pool thread, handing each one back under the lock */
+class DuplicateFinder::FingerprintJob : public ThreadPoolJob
+{
+public:
+    FingerprintJob(DuplicateFinder& _owner, std::vector<File> _files)
+        : ThreadPoolJob("Library fingerprints"), owner(_owner), files(std::move(_files))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        for (auto& file : files)
+        {
+            if (shouldExit())
+                return jobHasFinished;
+
+            std::vector<Landmark> landmarks;
+            std::unique_ptr<AudioFormatReader> reader(owner.formatManager.createReaderFor(file));
+
+            if (reader != nullptr)
+                landmarks = fingerprint(*reader, [this] { return shouldExit(); });
+
+            if (shouldExit())
+                return jobHasFinished;
+
+            const ScopedLock sl(owner.resultsLock);
+            owner.results.add({ file, std::move(landmarks) });
+            --owner.numPending;
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    DuplicateFinder& owner;
+    std::vector<File> files;
+};
+
+//==============================================================================
+DuplicateFinder::DuplicateFinder()
+    : MemoryBudget::Consumer("Library metadata", MemoryBudget::Cost::analyse)
+{
+    formatManager.registerBasicFormats();
+    cacheFile = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("music_library_fingerprints.bin");
+    loadCache();
+    addToBudget();
+}
+
+DuplicateFinder::~DuplicateFinder()
+{
+    removeFromBudget();
+    pool.removeAllJobs(true, 5000);
+}
+
+void DuplicateFinder::fingerprintMissing(const std::vector<File>& candidates)
+{
+    std::vector<File> missing;
+
+    for (auto& file : candidates)
+    {
+        auto path = file.getFullPathName();
+
+        if (trackByPath.contains(path) || queuedPaths.contains(path))
+            continue;
+
+        queuedPaths.set(path, true);
+        missing.push_back(file);
+    }
+
+    if (missing.empty())
+        return;
+
+    DBG("DuplicateFinder - Fingerprinting " + String((int) missing.size()) + " new tracks");
+    numPending += (int) missing.size();
+    pool.addJob(new FingerprintJob(*this, std::move(missing)), true);
+}
+
+bool DuplicateFinder::collectResults()
+{
+    TRACE_SPAN("DuplicateFinder::collectResults");
+
+    Array<std::pair<File, std::vector<Landmark>>> arrived;
+
+    {
+        const ScopedLock sl(resultsLock);
+        arrived.swapWith(results);
+    }
+
+    Array<std::pair<File, std::vector<Landmark>>> added;
+
+    for (auto& row : arrived)
+    {
+        queuedPaths.remove(row.first.getFullPathName());
+
+        if (indexOf(row.first) >= 0)
+            continue;
+
+        // match before indexing, so a track doesn't find itself
+        auto matches = findMatches(row.second);
+        auto track = addTrack(row.first, row.second);
+
+        for (auto other : matches)
+        {
+            link(track, other);
+            DBG("DuplicateFinder - " + row.first.getFileName() + " matches " + files[(size_t) other].getFileName());
+        }
+
+        added.add(row);
+    }
+
+    appendToCache(added);
+    return !arrived.isEmpty();
+}
+
+int DuplicateFinder::getNumPending() const
+{
+    return numPending.load();
+}
+
+size_t DuplicateFinder::getUsedBytes() const
+{
+    size_t numPostings = 0;
+    for (auto count : numLandmarks)
+        numPostings += (size_t) count;
+
+    // a bucket per hash: its key, its vector and the hash table's node around them
+    auto bytesPerBucket = sizeof(uint32) + sizeof(std::vector<Posting>) + 2 * sizeof(void*);
+
+    return numPostings * sizeof(Posting) + index.size() * bytesPerBucket
+         + files.size() * (MemoryBudget::bytesPerPath + sizeof(int) + sizeof(Array<int>));
+}
+
+std::map<String, File> DuplicateFinder::findDuplicatesIn(const std::vector<File>& candidates) const
+{
+    std::map<String, File> duplicateOf;
+    HashMap<int, int> positionOfTrack;
+
+    for (int i = 0; i < (int) candidates.size(); ++i)
+    {
+        auto track = indexOf(candidates[(size_t) i]);
+
+        if (track < 0)
+            continue;
+
+        // the first copy in the list stays unflagged, later ones point back at it
+        for (auto other : duplicates[(size_t) track])
+        {
+            if (positionOfTrack.contains(other))
+            {
+                duplicateOf[candidates[(size_t) i].getFullPathName()] = candidates[(size_t) positionOfTrack[other]];
+                break;
+            }
+        }
+
+        if (!positionOfTrack.contains(track))
+            positionOfTrack.set(track, i);
+    }
+
+    return duplicateOf;
+}
+
+//==============================================================================
+std::vector<DuplicateFinder::Landmark> DuplicateFinder::fingerprint(AudioFormatReader& reader, std::function<bool()> shouldExit)
+{
+    TRACE_SPAN("DuplicateFinder::fingerprint");
+
+    std::vector<Landmark> landmarks;
+
+    if (reader.sampleRate <= 0.0 || reader.lengthInSamples <= 0)
+        return landmarks;
+
+    // skip the intro, unless the track is too short for that, then take the middle
+    auto excerptLength = (int64) (excerptSeconds * reader.sampleRate);
+    auto start = jmin((int64) (excerptStartSeconds * reader.sampleRate),
+                      jmax((int64) 0, reader.lengthInSamples - excerptLength) / 2);
+    auto numSamples = jmin(excerptLength, reader.lengthInSamples - start);
+
+    // mono, averaged down to about the fingerprint rate
+    auto factor = jmax(1, roundToInt(reader.sampleRate / fingerprintRate));
+    auto blockSize = factor * 4096;
+    AudioBuffer<float> block(2, blockSize);
+    std::vector<float> mono;
+    mono.reserve((size_t) (numSamples / factor));
+    MemoryBudget::Tally::Scoped scratch(MemoryBudget::getInstance().getAnalysisScratch(), (2 * (size_t) blockSize + mono.capacity()) * sizeof(float));
+
+    for (int64 position = 0; position < numSamples; position += blockSize)
+    {
+        if (shouldExit())
+            return {};
+
+        auto numToRead = (int) jmin((int64) blockSize, numSamples - position);
+        numToRead -= numToRead % factor;
+
+        if (numToRead == 0)
+            break;
+
+        reader.read(&block, 0, numToRead, start + position, true, true);
+
+        for (int i = 0; i < numToRead; i += factor)
+        {
+            auto sum = 0.0f;
+
+            for (int k = 0; k < factor; ++k)
+                sum += block.getSample(0, i + k) + block.getSample(1, i + k);
+
+            mono.push_back(sum / (float) (2 * factor));
+        }
+    }
+
+    // the loudest bin of each band, when it stands above the frame's other bands
+    struct Peak
+    {
+        int frame;
+        int bin;
+    };
+
+    std::vector<Peak> peaks;
+    dsp::FFT fft(fftOrder);
+    dsp::WindowingFunction<float> window((size_t) fftSize, dsp::WindowingFunction<float>::hann);
+    std::vector<float> frameData((size_t) fftSize * 2);
+
+    for (int frame = 0; (size_t) (frame * hopSize + fftSize) <= mono.size(); ++frame)
+    {
+        std::fill(frameData.begin(), frameData.end(), 0.0f);
+        std::copy(mono.begin() + frame * hopSize, mono.begin() + frame * hopSize + fftSize, frameData.begin());
+        window.multiplyWithWindowingTable(frameData.data(), (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(frameData.data());
+
+        float bandPeak[numBands];
+        int bandBin[numBands];
+        auto mean = 0.0f;
+
+        for (int band = 0; band < numBands; ++band)
+        {
+            bandPeak[band] = 0.0f;
+            bandBin[band] = bandEdges[band];
+
+            for (int bin = bandEdges[band]; bin < bandEdges[band + 1]; ++bin)
+            {
+                if (frameData[(size_t) bin] > bandPeak[band])
+                {
+                    bandPeak[band] = frameData[(size_t) bin];
+                    bandBin[band] = bin;
+                }
+            }
+
+            mean += bandPeak[band] / (float) numBands;
+        }
+
+        if (mean < silenceLevel)
+            continue;
+
+        for (int band = 0; band < numBands; ++band)
+            if (bandPeak[band] >= mean)
+                peaks.push_back({ frame, bandBin[band] });
+    }
+
+    // pair each peak with the next few after it: both frequencies and the gap make the hash
+    for (size_t anchor = 0; anchor < peaks.size(); ++anchor)
+    {
+        auto paired = 0;
+
+        for (auto target = anchor + 1; target < peaks.size() && paired < fanOut; ++target)
+        {
+            auto gap = peaks[target].frame - peaks[anchor].frame;
+
+            if (gap == 0)
+                continue;
+
+            if (gap > maxTargetFrames)
+                break;
+
+            ++paired;
+            auto hash = (uint32) peaks[anchor].bin << 15 | (uint32) peaks[target].bin << 6 | (uint32) gap;
+
+            if (keepHash(hash))
+                landmarks.push_back({ hash, (uint16) peaks[anchor].frame });
+        }
+    }
+
+    return landmarks;
+}
+
+//==============================================================================
+int DuplicateFinder::indexOf(const File& file) const
+{
+    auto path = file.getFullPathName();
+    return trackByPath.contains(path) ? trackByPath[path] : -1;
+}
+
+Array<int> DuplicateFinder::findMatches(const std::vector<Landmark>& landmarks) const
+{
+    Array<int> matches;
+
+    if ((int) landmarks.size() < minMatches)
+        return matches;
+
+    // hits per track and time offset, packed into one key
+    std::unordered_map<int64, int> votes;
+
+    for (auto& landmark : landmarks)
+    {
+        auto postings = index.find(landmark.hash);
+
+        if (postings == index.end())
+            continue;
+
+        for (auto& posting : postings->second)
+            ++votes[((int64) posting.track << 20) + (int64) landmark.time - (int64) posting.time + 65536];
+    }
+
+    // a frame grid that lands between two offsets splits its hits, so count neighbours together
+    std::map<int, int> bestVotes;
+
+    for (auto& vote : votes)
+    {
+        auto next = votes.find(vote.first + 1);
+        auto count = vote.second + (next != votes.end() ? next->second : 0);
+        auto& best = bestVotes[(int) (vote.first >> 20)];
+        best = jmax(best, count);
+    }
+
+    for (auto& best : bestVotes)
+    {
+        auto smaller = jmin((int) landmarks.size(), numLandmarks[(size_t) best.first]);
+
+        if (best.second >= jmax(minMatches, (int) (minMatchShare * (float) smaller)))
+            matches.add(best.first);
+    }
+
+    return matches;
+}
+
+int DuplicateFinder::addTrack(const File& file, const std::vector<Landmark>& landmarks)
+{
+    auto track = (int) files.size();
+    files.push_back(file);
+    numLandmarks.push_back((int) landmarks.size());
+    duplicates.emplace_back();
+    trackByPath.set(file.getFullPathName(), track);
+
+    for (auto& landmark : landmarks)
+        index[landmark.hash].push_back({ track, landmark.time });
+
+    return track;
+}
+
+void DuplicateFinder::link(int track, int other)
+{
+    duplicates[(size_t) track].addIfNotAlreadyThere(other);
+    duplicates[(size_t) other].addIfNotAlreadyThere(track);
+}
+
+//==============================================================================
+// The cache is a run of records: 'F' path count (hash time)* for a fingerprint,
+// then 'D' path path for each duplicate found when it was indexed.
+void DuplicateFinder::loadCache()
+{
+    FileInputStream stream(cacheFile);
+
+    if (!stream.openedOk())
+        return;
+
+    while (!stream.isExhausted())
+    {
+        auto type = stream.readByte();
+        auto path = stream.readString();
+
+        if (type == 'F')
+        {
+            auto count = stream.readInt();
+
+            // a record cut short by a crash ends the cache
+            if (count < 0 || stream.getNumBytesRemaining() < (int64) count * 6)
+                break;
+
+            std::vector<Landmark> landmarks((size_t) count);
+
+            for (auto& landmark : landmarks)
+            {
+                landmark.hash = (uint32) stream.readInt();
+                landmark.time = (uint16) stream.readShort();
+            }
+
+            if (!trackByPath.contains(path))
+                addTrack(File(path), landmarks);
+        }
+        else if (type == 'D')
+        {
+            auto track = indexOf(File(path));
+            auto other = indexOf(File(stream.readString()));
+
+            if (track >= 0 && other >= 0)
+                link(track, other);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    DBG("DuplicateFinder - " + String((int) files.size()) + " fingerprints loaded");
+}
+
+void DuplicateFinder::appendToCache(const Array<std::pair<File, std::vector<Landmark>>>& tracks)
+{
+    if (tracks.isEmpty())
+        return;
+
+    FileOutputStream stream(cacheFile);
+
+    if (!stream.openedOk())
+        return;
+
+    for (auto& row : tracks)
+    {
+        auto path = row.first.getFullPathName();
+
+        stream.writeByte('F');
+        stream.writeString(path);
+        stream.writeInt((int) row.second.size());
+
+        for (auto& landmark : row.second)
+        {
+            stream.writeInt((int) landmark.hash);
+            stream.writeShort((short) landmark.time);
+        }
+
+        for (auto other : duplicates[(size_t) indexOf(row.first)])
+        {
+            stream.writeByte('D');
+            stream.writeString(path);
+            stream.writeString(files[(size_t) other].getFullPathName());
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    DuplicateFinder.h
+    Created: 21 Oct 2026 2:41:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    Finds library tracks that are the same recording under another path, such
+    as a song ripped twice or copied into two folders.
+
+    Each track is fingerprinted once, in the background, from a 30 second
+    excerpt mixed to mono at about 11 kHz. The strongest spectral peaks are
+    paired with the peaks that follow them. Each pair is hashed from its two
+    frequencies and the time between them, which survives re-encoding, level
+    changes and leading silence. Only one hash in eight is kept, chosen by the
+    hash value itself, so two copies keep the same ones.
+
+    Hashes go into an inverted index from hash to the tracks and times they
+    occur at. A new track looks its hashes up and counts the hits per track and
+    time offset. The same recording lines up many hits at a single offset, and
+    unrelated tracks don't.
+
+    Fingerprints and the duplicates found are appended to a cache file. Adding
+    tracks only fingerprints the new ones and matches them against the index.
+    The index counts towards the memory budget but is never evicted.
+*/
+class DuplicateFinder : private MemoryBudget::Consumer
+{
+public:
+    DuplicateFinder();
+    ~DuplicateFinder();
+
+    /** fingerprints, in the background, any of these files that have no fingerprint yet */
+    void fingerprintMissing(const std::vector<File>& files);
+    /** message thread: indexes and matches finished fingerprints; true if any arrived */
+    bool collectResults();
+    int getNumPending() const;
+
+    /** for each of these files that is a copy of one earlier in the list, that earlier file, by path */
+    std::map<String, File> findDuplicatesIn(const std::vector<File>& files) const;
+
+    /** the index and the track list, roughly */
+    size_t getUsedBytes() const override;
+
+private:
+    struct Landmark
+    {
+        uint32 hash;
+        uint16 time;    // analysis frame of the first peak
+    };
+
+    struct Posting
+    {
+        int track;
+        uint16 time;
+    };
+
+    class FingerprintJob;
+
+    static std::vector<Landmark> fingerprint(AudioFormatReader& reader, std::function<bool()> shouldExit);
+
+    int indexOf(const File& file) const;
+    /** the tracks already indexed that share enough aligned hashes with these */
+    Array<int> findMatches(const std::vector<Landmark>& landmarks) const;
+    int addTrack(const File& file, const std::vector<Landmark>& landmarks);
+    void link(int track, int other);
+
+    void loadCache();
+    void appendToCache(const Array<std::pair<File, std::vector<Landmark>>>& tracks);
+
+    std::vector<File> files;
+    std::vector<int> numLandmarks;
+    std::vector<Array<int>> duplicates;
+    HashMap<String, int> trackByPath;
+    std::unordered_map<uint32, std::vector<Posting>> index;
+
+    File cacheFile;
+    AudioFormatManager formatManager;
+    ThreadPool pool{ 1 };
+
+    CriticalSection resultsLock;
+    Array<std::pair<File, std::vector<Landmark>>> results;
+    HashMap<String, bool> queuedPaths;
+    std::atomic<int> numPending{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DuplicateFinder)
+};
@@ -0,0 +1,348 @@
+/*
+  ==============================================================================
+
+    EffectsRack.cpp
+    Created: 20 Oct 2026 9:31:12am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "EffectsRack.h"
+
+namespace
+{
+    const double maxEchoSeconds = 2.0;
+    const double maxFlangerSeconds = 0.01;
+    const double wetRampSeconds = 0.05;
+    // the tempo timed effects run at on a deck with no beat grid yet
+    const double defaultBpm = 120.0;
+
+    const float echoBeats[] = { 0.25f, 0.5f, 0.75f, 1.0f };
+    const float echoFeedback = 0.5f;
+
+    const float flangerCycleBeats[] = { 2.0f, 4.0f, 8.0f, 16.0f };
+    const float flangerFeedback = 0.6f;
+    const double flangerMinDelaySeconds = 0.0005, flangerDepthSeconds = 0.0045;
+
+    const float gateStepBeats[] = { 0.5f, 0.25f, 0.125f, 0.0625f };
+    const double gateAttackSeconds = 0.002;
+
+    /** picks one of four tempo divisions from a 0..1 knob */
+    template <typename ArrayType>
+    float pickDivision(const ArrayType& divisions, float amount)
+    {
+        return divisions[jlimit(0, 3, (int) (amount * 4.0f))];
+    }
+
+    double fractionalPart(double value)
+    {
+        return value - std::floor(value);
+    }
+}
+
+//==============================================================================
+void EffectsRack::DelayLine::clear()
+{
+    for (auto* channel : data)
+        if (channel != nullptr)
+            FloatVectorOperations::clear(channel, length);
+
+    writePosition = 0;
+}
+
+float EffectsRack::DelayLine::read(int channel, float delayInSamples) const
+{
+    auto readPosition = (float) writePosition - delayInSamples;
+    if (readPosition < 0.0f)
+        readPosition += (float) length;
+
+    auto index = (int) readPosition;
+    auto fraction = readPosition - (float) index;
+    auto next = index + 1 == length ? 0 : index + 1;
+
+    return data[channel][index] + fraction * (data[channel][next] - data[channel][index]);
+}
+
+//==============================================================================
+EffectsRack::EffectsRack()
+{
+}
+
+String EffectsRack::getEffectName(Effect effect)
+{
+    switch (effect)
+    {
+        case echo:     return "ECHO";
+        case reverb:   return "VERB";
+        case flanger:  return "FLANGE";
+        case bitcrush: return "CRUSH";
+        case gate:     return "GATE";
+        default:       break;
+    }
+
+    return {};
+}
+
+void EffectsRack::setEnabled(Effect effect, bool shouldBeEnabled)
+{
+    if (isPositiveAndBelow((int) effect, (int) numEffects))
+        slots[effect].enabled = shouldBeEnabled;
+}
+
+bool EffectsRack::isEnabled(Effect effect) const
+{
+    return isPositiveAndBelow((int) effect, (int) numEffects) && slots[effect].enabled.load();
+}
+
+void EffectsRack::setMix(Effect effect, float mix)
+{
+    if (isPositiveAndBelow((int) effect, (int) numEffects))
+        slots[effect].mix = jlimit(0.0f, 1.0f, mix);
+}
+
+void EffectsRack::setAmount(Effect effect, float amount)
+{
+    if (isPositiveAndBelow((int) effect, (int) numEffects))
+        slots[effect].amount = jlimit(0.0f, 1.0f, amount);
+}
+
+//==============================================================================
+void EffectsRack::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    auto echoLength = (int) (maxEchoSeconds * sampleRate) + 2;
+    auto flangerLength = (int) (maxFlangerSeconds * sampleRate) + 2;
+    auto needed = (size_t) (2 * (echoLength + flangerLength));
+
+    if (needed != poolSize)
+    {
+        pool.allocate(needed, true);
+        poolSize = needed;
+    }
+
+    auto* next = pool.get();
+    for (auto* line : { &echoLine, &flangerLine })
+    {
+        line->length = line == &echoLine ? echoLength : flangerLength;
+        line->data[0] = next;
+        line->data[1] = next + line->length;
+        next += 2 * line->length;
+    }
+
+    dryBuffer.setSize(2, jmax(1, samplesPerBlockExpected));
+    reverbUnit.setSampleRate(sampleRate);
+
+    for (int effect = 0; effect < numEffects; ++effect)
+    {
+        slots[effect].wet.reset(sampleRate, wetRampSeconds);
+        slots[effect].wet.setCurrentAndTargetValue(0.0f);
+        slots[effect].wasActive = false;
+        resetEffect((Effect) effect);
+    }
+}
+
+void EffectsRack::releaseResources()
+{
+    for (auto& slot : slots)
+        slot.wasActive = false;
+}
+
+void EffectsRack::resetEffect(Effect effect)
+{
+    switch (effect)
+    {
+        case echo:     echoLine.clear(); echoDelay = -1.0f; break;
+        case reverb:   reverbUnit.reset(); break;
+        case flanger:  flangerLine.clear(); break;
+        case bitcrush: crushCounter = 0; crushHold[0] = crushHold[1] = 0.0f; break;
+        case gate:     gateLevel = 1.0f; break;
+        default:       break;
+    }
+}
+
+void EffectsRack::process(const AudioSourceChannelInfo& bufferToFill, double bpm, double beatPosition)
+{
+    auto& buffer = *bufferToFill.buffer;
+    auto numChannels = jmin(2, buffer.getNumChannels());
+
+    // with no grid, from before the analysis is in or on a track without a beat, the timed
+    // effects keep their own time at a default tempo instead of sitting at the grid's zero
+    auto hasGrid = bpm > 0.0;
+
+    if (!hasGrid)
+        bpm = defaultBpm;
+
+    auto beatsPerSample = bpm / (60.0 * sampleRate);
+
+    // work through the block in pieces no bigger than the dry buffer we prepared
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        auto numThisTime = jmin(bufferToFill.numSamples - done, dryBuffer.getNumSamples());
+        auto start = bufferToFill.startSample + done;
+        auto beatAtStart = beatPosition + done * beatsPerSample;
+
+        for (int index = 0; index < numEffects; ++index)
+        {
+            auto effect = (Effect) index;
+            auto& slot = slots[index];
+            slot.wet.setTargetValue(slot.enabled.load() ? slot.mix.load() : 0.0f);
+
+            if (!slot.wet.isSmoothing() && slot.wet.getTargetValue() <= 0.0f)
+            {
+                slot.wasActive = false;
+                continue;
+            }
+
+            // coming back from silence: drop whatever the last run left behind
+            if (!slot.wasActive)
+            {
+                resetEffect(effect);
+                slot.wasActive = true;
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                dryBuffer.copyFrom(channel, 0, buffer, channel, start, numThisTime);
+
+            // locked to the grid when there is one, carried on from the last piece when not
+            auto beats = hasGrid ? beatAtStart : freeRunningBeats[index];
+            freeRunningBeats[index] = beats + numThisTime * beatsPerSample;
+
+            switch (effect)
+            {
+                case echo:     processEcho(buffer, start, numThisTime, bpm); break;
+                case reverb:   processReverb(buffer, start, numThisTime); break;
+                case flanger:  processFlanger(buffer, start, numThisTime, bpm, beats); break;
+                case bitcrush: processBitcrush(buffer, start, numThisTime); break;
+                case gate:     processGate(buffer, start, numThisTime, bpm, beats); break;
+                default:       break;
+            }
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                auto wet = slot.wet.getNextValue();
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    auto dry = dryBuffer.getSample(channel, i);
+                    auto processed = buffer.getSample(channel, start + i);
+                    buffer.setSample(channel, start + i, dry + wet * (processed - dry));
+                }
+            }
+        }
+
+        done += numThisTime;
+    }
+}
+
+//==============================================================================
+void EffectsRack::processEcho(AudioBuffer<float>& buffer, int start, int numSamples, double bpm)
+{
+    auto beats = pickDivision(echoBeats, slots[echo].amount.load());
+    auto target = jlimit(1.0f, (float) echoLine.length - 2.0f, (float) (beats * 60.0 / bpm * sampleRate));
+
+    if (echoDelay < 0.0f)
+        echoDelay = target;
+
+    auto numChannels = jmin(2, buffer.getNumChannels());
+
+    for (int i = start; i < start + numSamples; ++i)
+    {
+        // glide towards a new delay time instead of jumping and clicking
+        echoDelay += 0.001f * (target - echoDelay);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto input = buffer.getSample(jmin(channel, numChannels - 1), i);
+            auto delayed = echoLine.read(channel, echoDelay);
+            echoLine.push(channel, input + delayed * echoFeedback);
+
+            if (channel < numChannels)
+                buffer.setSample(channel, i, input + delayed);
+        }
+
+        echoLine.advance();
+    }
+}
+
+void EffectsRack::processReverb(AudioBuffer<float>& buffer, int start, int numSamples)
+{
+    Reverb::Parameters parameters;
+    parameters.roomSize = 0.3f + 0.69f * slots[reverb].amount.load();
+    parameters.damping = 0.5f;
+    parameters.wetLevel = 0.4f;
+    parameters.dryLevel = 1.0f;
+    parameters.width = 1.0f;
+    reverbUnit.setParameters(parameters);
+
+    if (buffer.getNumChannels() >= 2)
+        reverbUnit.processStereo(buffer.getWritePointer(0, start), buffer.getWritePointer(1, start), numSamples);
+    else
+        reverbUnit.processMono(buffer.getWritePointer(0, start), numSamples);
+}
+
+void EffectsRack::processFlanger(AudioBuffer<float>& buffer, int start, int numSamples, double bpm, double beatPosition)
+{
+    auto cycleBeats = (double) pickDivision(flangerCycleBeats, slots[flanger].amount.load());
+    auto beatsPerSample = bpm / (60.0 * sampleRate);
+    auto numChannels = jmin(2, buffer.getNumChannels());
+
+    for (int i = start; i < start + numSamples; ++i)
+    {
+        // the sweep is locked to the beat grid, one cycle every few bars
+        auto phase = fractionalPart((beatPosition + (i - start) * beatsPerSample) / cycleBeats);
+        auto sweep = 0.5 + 0.5 * std::sin(MathConstants<double>::twoPi * phase);
+        auto delay = (float) ((flangerMinDelaySeconds + flangerDepthSeconds * sweep) * sampleRate);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto input = buffer.getSample(jmin(channel, numChannels - 1), i);
+            auto delayed = flangerLine.read(channel, delay);
+            flangerLine.push(channel, input + delayed * flangerFeedback);
+
+            if (channel < numChannels)
+                buffer.setSample(channel, i, 0.7f * (input + delayed));
+        }
+
+        flangerLine.advance();
+    }
+}
+
+void EffectsRack::processBitcrush(AudioBuffer<float>& buffer, int start, int numSamples)
+{
+    auto amount = slots[bitcrush].amount.load();
+    auto levels = std::pow(2.0f, 15.0f - 12.0f * amount);
+    auto holdSamples = 1 + (int) (amount * 15.0f);
+    auto numChannels = jmin(2, buffer.getNumChannels());
+
+    for (int i = start; i < start + numSamples; ++i)
+    {
+        if (crushCounter == 0)
+            for (int channel = 0; channel < numChannels; ++channel)
+                crushHold[channel] = std::round(buffer.getSample(channel, i) * levels) / levels;
+
+        crushCounter = (crushCounter + 1) % holdSamples;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.setSample(channel, i, crushHold[channel]);
+    }
+}
+
+void EffectsRack::processGate(AudioBuffer<float>& buffer, int start, int numSamples, double bpm, double beatPosition)
+{
+    auto stepBeats = (double) pickDivision(gateStepBeats, slots[gate].amount.load());
+    auto beatsPerSample = bpm / (60.0 * sampleRate);
+    auto smoothing = (float) (1.0 - std::exp(-1.0 / (gateAttackSeconds * sampleRate)));
+    auto numChannels = jmin(2, buffer.getNumChannels());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // open for the first half of every step on the beat grid
+        auto step = fractionalPart((beatPosition + i * beatsPerSample) / stepBeats);
+        gateLevel += smoothing * ((step < 0.5 ? 1.0f : 0.0f) - gateLevel);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.setSample(channel, start + i, buffer.getSample(channel, start + i) * gateLevel);
+    }
+}
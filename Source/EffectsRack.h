@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    EffectsRack.h
+    Created: 20 Oct 2026 9:31:12am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Insert effects for one deck: echo, reverb, flanger, bitcrush and gate, run
+    in that order after the deck's resampler.
+
+    Everything an effect needs is allocated in prepareToPlay: delay lines are
+    carved out of one block sized for the sample rate, and the reverb sets up
+    its own buffers there. process() only reads atomics, so switching effects
+    and moving knobs from the message thread never allocates or locks on the
+    audio thread. Every effect ramps its wet level in and out, and timed
+    parameters follow the deck's tempo.
+*/
+class EffectsRack
+{
+public:
+    enum Effect { echo, reverb, flanger, bitcrush, gate, numEffects };
+
+    EffectsRack();
+
+    static String getEffectName(Effect effect);
+
+    void setEnabled(Effect effect, bool shouldBeEnabled);
+    bool isEnabled(Effect effect) const;
+    /** 0 is dry, 1 is fully wet */
+    void setMix(Effect effect, float mix);
+    /** the effect's own control, 0 to 1: echo length, room size, sweep rate, crush depth, gate rate */
+    void setAmount(Effect effect, float amount);
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate);
+    void releaseResources();
+
+    /** bpm and beatPosition describe the deck at the start of the block; a bpm of 0
+        means no beat grid, and the timed effects run free at a default tempo */
+    void process(const AudioSourceChannelInfo& bufferToFill, double bpm, double beatPosition);
+
+private:
+    struct Slot
+    {
+        std::atomic<bool> enabled{ false };
+        std::atomic<float> mix{ 0.5f };
+        std::atomic<float> amount{ 0.5f };
+        SmoothedValue<float> wet;
+        bool wasActive = false;
+    };
+
+    /** one allocation made in prepareToPlay, handed out to the delay lines */
+    struct DelayLine
+    {
+        float* data[2] = { nullptr, nullptr };
+        int length = 0;
+        int writePosition = 0;
+
+        void clear();
+        void push(int channel, float sample) { data[channel][writePosition] = sample; }
+        float read(int channel, float delayInSamples) const;
+        void advance() { if (++writePosition == length) writePosition = 0; }
+    };
+
+    void resetEffect(Effect effect);
+    void processEcho(AudioBuffer<float>& buffer, int start, int numSamples, double bpm);
+    void processReverb(AudioBuffer<float>& buffer, int start, int numSamples);
+    void processFlanger(AudioBuffer<float>& buffer, int start, int numSamples, double bpm, double beatPosition);
+    void processBitcrush(AudioBuffer<float>& buffer, int start, int numSamples);
+    void processGate(AudioBuffer<float>& buffer, int start, int numSamples, double bpm, double beatPosition);
+
+    Slot slots[numEffects];
+    double sampleRate = 44100.0;
+
+    HeapBlock<float> pool;
+    size_t poolSize = 0;
+    DelayLine echoLine, flangerLine;
+    AudioBuffer<float> dryBuffer;
+
+    float echoDelay = 0.0f;
+    float crushHold[2] = { 0.0f, 0.0f };
+    int crushCounter = 0;
+    float gateLevel = 0.0f;
+    double freeRunningBeats[numEffects] = {};   // each effect's own beat count, for a deck with no grid
+    Reverb reverbUnit;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EffectsRack)
+};
@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+    EngineStress.cpp
+    Created: 21 Oct 2026 7:48:02pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "EngineStress.h"
+#include "DJAudioPlayer.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 44100.0;
+    const int blockSize = 64;
+    const double trackSeconds = 1.5;    // short enough that the whole track fits the read-ahead
+    const double goldenSeconds = 1.0;
+    const int goldenRuns = 20;
+    const float maxLevel = 8.0f;
+
+    /** a stereo sweep with a little seeded noise, so every sample differs from its neighbours */
+    File writeTestTrack(const File& folder, const String& name, int seed, double startHz, double endHz)
+    {
+        auto file = folder.getChildFile(name);
+        file.deleteFile();
+
+        WavAudioFormat wav;
+        std::unique_ptr<FileOutputStream> stream(new FileOutputStream(file));
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 24, {}, 0));
+
+        if (writer == nullptr)
+            return {};
+
+        stream.release(); // the writer owns it now
+
+        auto numSamples = (int) (trackSeconds * sampleRate);
+        AudioBuffer<float> buffer(2, numSamples);
+        Random random(seed);
+        auto phase = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto hz = startHz + (endHz - startHz) * i / numSamples;
+            phase += MathConstants<double>::twoPi * hz / sampleRate;
+            buffer.setSample(0, i, 0.5f * (float) std::sin(phase) + 0.05f * (random.nextFloat() - 0.5f));
+            buffer.setSample(1, i, 0.5f * (float) std::cos(phase) + 0.05f * (random.nextFloat() - 0.5f));
+        }
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        return file;
+    }
+
+    //==============================================================================
+    /** pulls blocks from a source like an audio device would, only without waiting for one */
+    class SimulatedDevice : public Thread
+    {
+    public:
+        SimulatedDevice(AudioSource& _source, int _numBlocks, AudioBuffer<float>* _capture)
+            : Thread("Simulated audio device"), source(_source), numBlocks(_numBlocks), capture(_capture)
+        {
+        }
+
+        /** renders numBlocks blocks, or until told to stop when numBlocks is negative */
+        void run() override
+        {
+            AudioBuffer<float> block(2, blockSize);
+
+            for (int i = 0; (numBlocks < 0 || i < numBlocks) && !threadShouldExit(); ++i)
+            {
+                block.clear();
+                source.getNextAudioBlock(AudioSourceChannelInfo(&block, 0, blockSize));
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    for (int n = 0; n < blockSize; ++n)
+                    {
+                        auto sample = block.getSample(channel, n);
+                        if (!std::isfinite(sample) || std::abs(sample) > maxLevel)
+                            ++badSamples;
+                    }
+
+                    if (capture != nullptr)
+                        capture->copyFrom(channel, i * blockSize, block, channel, 0, blockSize);
+                }
+
+                ++blocksRendered;
+            }
+        }
+
+        std::atomic<int64> badSamples{ 0 };
+        std::atomic<int64> blocksRendered{ 0 };
+
+    private:
+        AudioSource& source;
+        int numBlocks;
+        AudioBuffer<float>* capture;
+    };
+
+    /** reads what the audio thread, MIDI and Auto DJ read, from a thread of its own */
+    class StateReader : public Thread
+    {
+    public:
+        StateReader(DJAudioPlayer& _player) : Thread("State reader"), player(_player) {}
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                auto snapshot = player.getPlayheadClock().read();
+                auto total = snapshot.positionSeconds + player.getCurrentPosition() + player.getLengthInSeconds()
+                           + player.getBeatPosition() + player.getSpeed() + player.getBpm() + player.getCueOutSeconds();
+
+                if (std::isfinite(total))
+                    ++reads;
+            }
+        }
+
+        std::atomic<int64> reads{ 0 };
+
+    private:
+        DJAudioPlayer& player;
+    };
+
+    //==============================================================================
+    /** plays the track from the top for goldenSeconds; with concurrent set, on a device
+        thread while this thread and a reader keep touching the deck without changing it */
+    bool render(AudioFormatManager& formatManager, const File& track, bool concurrent, AudioBuffer<float>& output)
+    {
+        auto numBlocks = (int) (goldenSeconds * sampleRate) / blockSize;
+        output.setSize(2, numBlocks * blockSize);
+        output.clear();
+
+        DJAudioPlayer player(formatManager);
+        player.prepareToPlay(blockSize, sampleRate);
+        player.loadURL(URL(track));
+
+        if (!player.waitUntilBuffered(trackSeconds, 5000))
+        {
+            std::cout << "  read-ahead never filled" << std::endl;
+            return false;
+        }
+
+        player.start();
+        SimulatedDevice device(player, numBlocks, &output);
+
+        if (!concurrent)
+        {
+            device.run(); // offline, on this thread
+        }
+        else
+        {
+            StateReader reader(player);
+            reader.startThread();
+            device.startThread();
+
+            while (device.isThreadRunning())
+            {
+                player.setSpeed(1.0);
+                player.setGain(1.0);
+                player.setReverse(false);
+                player.setSyncEnabled(false);
+                player.getPositionRelative();
+                player.isPlaying();
+                player.getAnalysis();
+            }
+
+            reader.stopThread(2000);
+        }
+
+        // only clears the deck's playing flag, so it doesn't wait for a callback that isn't coming
+        player.stop();
+        player.releaseResources();
+        return device.badSamples == 0;
+    }
+
+    /** the index of the first sample that differs, or -1 */
+    int findMismatch(const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (a.getSample(channel, i) != b.getSample(channel, i))
+                    return i;
+
+        return -1;
+    }
+
+    //==============================================================================
+    /** changes everything at random while the device thread runs flat out */
+    bool runChaos(AudioFormatManager& formatManager, const File& trackA, const File& trackB, double seconds)
+    {
+        DJAudioPlayer player(formatManager);
+        player.prepareToPlay(blockSize, sampleRate);
+        player.loadURL(URL(trackA));
+        player.start();
+
+        SimulatedDevice device(player, -1, nullptr);
+        StateReader reader(player);
+        device.startThread();
+        reader.startThread();
+
+        Random random(20261021);
+        auto endTime = Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+        int64 numOperations = 0;
+
+        while (Time::getMillisecondCounterHiRes() < endTime)
+        {
+            switch (random.nextInt(15))
+            {
+                case 0:  player.loadURL(URL(random.nextBool() ? trackA : trackB)); break;
+                case 1:  player.setPositionRelative(random.nextDouble()); break;
+                case 2:  player.setSpeed(0.5 + 1.5 * random.nextDouble()); break;
+                case 3:  player.setReverse(random.nextBool()); break;
+                case 4:  player.beginScratch(); break;
+                case 5:  player.scratchTo(2.0 * random.nextDouble() - 1.0); break;
+                case 6:  player.endScratch(); break;
+                case 7:  player.setHotCue(random.nextInt(CueWindowSource::maxCues)); break;
+                case 8:  player.jumpToHotCue(random.nextInt(CueWindowSource::maxCues)); break;
+                case 9:  random.nextBool() ? player.start() : player.stop(); break;
+                case 10: player.setGain(random.nextDouble()); break;
+                case 11:
+                {
+                    auto effect = (EffectsRack::Effect) random.nextInt(EffectsRack::numEffects);
+                    player.setEffectEnabled(effect, random.nextBool());
+                    player.setEffectMix(effect, random.nextFloat());
+                    player.setEffectAmount(effect, random.nextFloat());
+                    break;
+                }
+                case 12: EngineStress::dispatchMessages(1); break;
+                case 13: player.queueNext(URL(random.nextBool() ? trackA : trackB), 50.0 * random.nextDouble()); break;
+                default:
+                    player.getPositionRelative();
+                    player.isPlaying();
+                    player.getAnalysis();
+                    break;
+            }
+
+            ++numOperations;
+        }
+
+        device.stopThread(2000);
+        reader.stopThread(2000);
+        EngineStress::dispatchMessages(10);
+        player.stop();
+        player.releaseResources();
+
+        std::cout << "  " << numOperations << " operations, " << device.blocksRendered.load() << " blocks, "
+                  << reader.reads.load() << " reads, " << device.badSamples.load() << " bad samples" << std::endl;
+
+        return device.badSamples == 0 && device.blocksRendered > 0;
+    }
+}
+
+//==============================================================================
+int EngineStress::run(double chaosSeconds)
+{
+    std::cout << "OtoDecks engine stress" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto folder = File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks stress");
+    folder.createDirectory();
+
+    auto trackA = writeTestTrack(folder, "a.wav", 1, 110.0, 1760.0);
+    auto trackB = writeTestTrack(folder, "b.wav", 2, 3000.0, 220.0);
+
+    CheckResults results;
+
+    if (!results.expect(trackA.existsAsFile() && trackB.existsAsFile(),
+                        "couldn't write the test tracks to " + folder.getFullPathName()))
+        return results.finish();
+
+    std::cout << "Golden render, " << goldenRuns << " concurrent runs" << std::endl;
+    AudioBuffer<float> golden, concurrent;
+
+    if (results.expect(render(formatManager, trackA, false, golden), "offline render"))
+    {
+        for (int run = 0; run < goldenRuns; ++run)
+        {
+            auto rendered = render(formatManager, trackA, true, concurrent);
+            auto mismatch = rendered ? findMismatch(golden, concurrent) : -1;
+
+            results.expect(rendered && mismatch < 0,
+                           "run " + String(run) + (rendered ? " differs from sample " + String(mismatch) : " didn't render"));
+        }
+    }
+
+    std::cout << "Chaos, " << chaosSeconds << " seconds" << std::endl;
+    results.expect(runChaos(formatManager, trackA, trackB, chaosSeconds), "chaos");
+
+    folder.deleteRecursively();
+    return results.finish();
+}
+
+void EngineStress::dispatchMessages(int milliseconds)
+{
+   #if JUCE_MODAL_LOOPS_PERMITTED
+    MessageManager::getInstance()->runDispatchLoopUntil(milliseconds);
+   #else
+    // the headless tool is built with modal loops on, see CMakeLists.txt
+    jassertfalse;
+    Thread::sleep(milliseconds);
+   #endif
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    EngineStress.h
+    Created: 21 Oct 2026 7:48:02pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless stress run of the deck engine, started with --stress [seconds].
+
+    A simulated device thread pulls blocks from a DJAudioPlayer as fast as it
+    can. Meanwhile the message thread drives the deck the way the GUI does, and
+    a third thread reads its state the way the GUI timers do. Nothing touches
+    the sound card or opens a window.
+
+    The run has two parts:
+      - Golden: a track rendered offline is compared, bit for bit, against the
+        same track rendered on the device thread while the other threads set
+        the deck to the values it already has and read it constantly.
+      - Chaos: loads, queued tracks, seeks, tempo, reverse, scratching, hot
+        cues and effects are changed at random for the given time. Every sample
+        must stay finite and in range. Whether a queued track starts at the
+        right sample is GaplessCheck's job.
+
+    There is no message loop running in the headless tools, so whatever the
+    decks post to the message thread, such as the re-arm after the end of a
+    track or a queued track's handover, waits until dispatchMessages() is
+    called. The chaos part calls it between operations, the way the app's
+    loop runs between GUI events.
+
+    Build with OTODECKS_TSAN=ON to run it under ThreadSanitizer.
+*/
+class EngineStress
+{
+public:
+    /** runs both parts, printing progress; returns the process exit code */
+    static int run(double chaosSeconds);
+
+    /** delivers the messages waiting for the message thread, for about this long;
+        call it on the thread that created the MessageManager */
+    static void dispatchMessages(int milliseconds);
+};
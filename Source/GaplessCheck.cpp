@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    GaplessCheck.cpp
+    Created: 27 Oct 2026 3:41:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "GaplessCheck.h"
+#include "GaplessSource.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 44100.0;
+    const int blockSize = 64;
+    const int lengthA = 44100 - 37;     // a second, less a little so the switch falls part way through a block
+    const int lengthB = 44100;          // both fit the read-ahead whole, so nothing plays before it's buffered
+    const int samplesAfterSwitch = 2048;
+    const float levelA = 0.75f;
+    const float tolerance = 1.0e-6f;
+    const uint32 bufferTimeoutMs = 5000;
+    const int decoderDelay = 529;       // what GaplessSource takes a standard MP3 decoder to add
+
+    /** track B's samples, all different and all below track A's level */
+    float rampB(int64 sample)
+    {
+        return 0.25f + 0.25f * (float) sample / (float) lengthB;
+    }
+
+    /** a 32 bit float stereo WAV in memory, which reads back exactly what was written */
+    MemoryBlock makeTrack(int numSamples, bool ramp)
+    {
+        MemoryBlock content;
+        WavAudioFormat wav;
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(new MemoryOutputStream(content, false),
+                                                                      sampleRate, 2, 32, {}, 0));
+        AudioBuffer<float> buffer(2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < 2; ++channel)
+                buffer.setSample(channel, i, ramp ? rampB(i) : levelA);
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        writer.reset(); // writes the header lengths
+        return content;
+    }
+
+    std::unique_ptr<CueWindowSource> openTrack(AudioFormatManager& formatManager, const MemoryBlock& content,
+                                               TimeSliceThread& thread)
+    {
+        std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(std::make_unique<MemoryInputStream>(content, false)));
+        std::unique_ptr<AudioFormatReader> windowReader(formatManager.createReaderFor(std::make_unique<MemoryInputStream>(content, false)));
+
+        if (reader == nullptr || windowReader == nullptr)
+            return {};
+
+        return std::make_unique<CueWindowSource>(reader.release(), windowReader.release(), thread);
+    }
+
+    //==============================================================================
+    struct Case
+    {
+        const char* name;
+        int64 trimEndA;
+        int64 trimStartB;
+        int crossfade;
+    };
+
+    /** renders A with B queued, offline on this thread, and compares every sample */
+    void check(CheckResults& results, AudioFormatManager& formatManager, const MemoryBlock& trackA,
+               const MemoryBlock& trackB, const Case& setup)
+    {
+        std::cout << "  " << setup.name << std::endl;
+
+        TimeSliceThread thread("Gapless check read-ahead");
+        thread.startThread();
+
+        auto sourceA = openTrack(formatManager, trackA, thread);
+        auto sourceB = openTrack(formatManager, trackB, thread);
+
+        if (!results.expect(sourceA != nullptr && sourceB != nullptr, "couldn't read the test tracks"))
+            return;
+
+        // as the deck does: B is prepared and positioned at its trimmed start before it's queued
+        sourceA->prepareToPlay(blockSize, sampleRate);
+        sourceB->prepareToPlay(blockSize, sampleRate);
+        sourceA->setStartPosition(0);
+        sourceB->setStartPosition(setup.trimStartB);
+
+        GaplessSource gapless;
+        gapless.setCurrent(sourceA.get(), { 0, setup.trimEndA });
+        gapless.setQueued(sourceB.get(), { setup.trimStartB, 0 }, setup.crossfade);
+
+        auto switchAt = (int) (lengthA - setup.trimEndA - setup.crossfade);
+        auto numBlocks = (switchAt + setup.crossfade + samplesAfterSwitch) / blockSize + 1;
+
+        if (results.expect(sourceA->waitUntilBuffered(lengthA, bufferTimeoutMs)
+                               && sourceB->waitUntilBuffered(setup.crossfade + samplesAfterSwitch + blockSize, bufferTimeoutMs),
+                           "the read-ahead never filled"))
+        {
+            AudioBuffer<float> output(2, numBlocks * blockSize);
+            output.clear();
+
+            for (int block = 0; block < numBlocks; ++block)
+                gapless.getNextAudioBlock(AudioSourceChannelInfo(&output, block * blockSize, blockSize));
+
+            // A up to the switch, the crossfade as the tail mixes it, then B from its trimmed start
+            auto expected = [&setup, switchAt](int sample)
+            {
+                if (sample < switchAt)
+                    return levelA;
+
+                auto intoB = sample - switchAt;
+                auto fromB = rampB(setup.trimStartB + intoB);
+
+                if (intoB >= setup.crossfade)
+                    return fromB;
+
+                auto fadeIn = (float) (intoB + 1) / (float) (setup.crossfade + 1);
+                return fromB * fadeIn + levelA * (1.0f - fadeIn);
+            };
+
+            auto firstFromB = -1;
+            auto mismatch = -1;
+
+            for (int i = 0; i < output.getNumSamples(); ++i)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    auto sample = output.getSample(channel, i);
+
+                    if (firstFromB < 0 && std::abs(sample - levelA) > tolerance)
+                        firstFromB = i;
+
+                    if (mismatch < 0 && std::abs(sample - expected(i)) > tolerance)
+                        mismatch = i;
+                }
+            }
+
+            std::cout << "    switched at sample " << firstFromB << ", expected " << switchAt << std::endl;
+
+            results.expect(firstFromB == switchAt, "the switch wasn't at the trimmed end less the crossfade");
+            results.expect(mismatch < 0, "sample " + String(mismatch) + " is " + String(output.getSample(0, jmax(0, mismatch)))
+                                             + ", expected " + String(expected(jmax(0, mismatch))));
+            results.expect(gapless.takeSwitch(), "the switch wasn't flagged for the deck");
+            results.expect(!gapless.cancelQueued(), "B was still queued after the switch");
+        }
+
+        gapless.setCurrent(nullptr, {});
+        sourceA->releaseResources();
+        sourceB->releaseResources();
+    }
+
+    //==============================================================================
+    /** the first frame of an MP3 with an Info tag and LAME's delay and padding, optionally
+        after an ID3v2 tag, and enough of the frame after it to be read */
+    MemoryBlock makeLameTag(int numFrames, int encoderDelay, int padding, bool withId3)
+    {
+        MemoryOutputStream out;
+
+        if (withId3)
+        {
+            const uint8 id3[] = { 'I', 'D', '3', 4, 0, 0, 0, 0, 0, 20 };
+            out.write(id3, sizeof(id3));
+            out.writeRepeatedByte(0, 20);
+        }
+
+        const uint8 header[] = { 0xff, 0xfb, 0x90, 0x64 };   // MPEG 1 layer 3, 128 kb/s, 44.1 kHz, joint stereo
+        out.write(header, sizeof(header));
+        out.writeRepeatedByte(0, 32);                         // the side information
+        out.write("Info", 4);
+        out.writeIntBigEndian(1);                             // only the frame count follows
+        out.writeIntBigEndian(numFrames);
+        out.write("LAME", 4);
+        out.writeRepeatedByte(0, 17);
+
+        const uint8 delayAndPadding[] = { (uint8) (encoderDelay >> 4),
+                                          (uint8) (((encoderDelay & 0x0f) << 4) | (padding >> 8)),
+                                          (uint8) (padding & 0xff) };
+        out.write(delayAndPadding, sizeof(delayAndPadding));
+        out.writeRepeatedByte(0, 400);
+        return out.getMemoryBlock();
+    }
+
+    void checkEncoderTrim(CheckResults& results)
+    {
+        const int numFrames = 100, samplesPerFrame = 1152, encoderDelay = 576, padding = 1200;
+        const int64 allFrames = numFrames * samplesPerFrame;
+
+        struct TrimCase
+        {
+            const char* name;
+            bool withId3;
+            int64 decodedLength;
+            GaplessSource::Trim expected;
+        };
+
+        const TrimCase cases[] = {
+            { "every frame, tag frame as silence", false, allFrames + samplesPerFrame, { samplesPerFrame + encoderDelay + decoderDelay, padding - decoderDelay } },
+            { "every frame, after an ID3 tag",     true,  allFrames,                   { encoderDelay + decoderDelay, padding - decoderDelay } },
+            { "already trimmed by the decoder",    false, allFrames - encoderDelay - padding, {} },
+        };
+
+        for (auto& trimCase : cases)
+        {
+            MemoryInputStream stream(makeLameTag(numFrames, encoderDelay, padding, trimCase.withId3), true);
+            auto trim = GaplessSource::findEncoderTrim(stream, trimCase.decodedLength);
+
+            std::cout << "  " << trimCase.name << ": trim " << trim.start << " and " << trim.end << std::endl;
+            results.expect(trim.start == trimCase.expected.start && trim.end == trimCase.expected.end,
+                           String(trimCase.name) + ": expected " + String(trimCase.expected.start) + " and "
+                               + String(trimCase.expected.end));
+        }
+    }
+}
+
+//==============================================================================
+int GaplessCheck::run()
+{
+    std::cout << "OtoDecks gapless check, " << blockSize << " sample blocks" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto trackA = makeTrack(lengthA, false);
+    auto trackB = makeTrack(lengthB, true);
+
+    const Case cases[] = {
+        { "no crossfade, no trim",                 0,   0,    0 },
+        { "no crossfade, both ends trimmed",       300, 200,  0 },
+        { "10 ms crossfade, both ends trimmed",    300, 200,  441 },
+        { "longest crossfade, start trimmed",      0,   1105, GaplessSource::maxCrossfadeSamples },
+    };
+
+    CheckResults results;
+
+    std::cout << "Handover" << std::endl;
+    for (auto& setup : cases)
+        check(results, formatManager, trackA, trackB, setup);
+
+    std::cout << "MP3 encoder trim" << std::endl;
+    checkEncoderTrim(results);
+
+    return results.finish();
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    GaplessCheck.h
+    Created: 27 Oct 2026 3:41:07pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of the handover to a queued track, started with
+    --gapless-check.
+
+    Track A holds one level throughout and track B is a ramp, both 32 bit
+    float WAVs in memory, so every output sample says exactly where it came
+    from. A GaplessSource with B queued is rendered offline in small blocks.
+    A must play up to its length less its trim and the crossfade, and B must
+    follow from its trimmed start with the crossfade mixed in and not a sample
+    missing or repeated. The cases switch part way through a block, with and
+    without a crossfade and an end trim.
+
+    The MP3 trim is read from a LAME tag built in memory: the delay and
+    padding for a decoder that keeps every frame, and no trim for one that
+    has already removed them.
+*/
+class GaplessCheck
+{
+public:
+    /** runs every case, printing progress; returns the process exit code */
+    static int run();
+};
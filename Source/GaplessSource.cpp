@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+    GaplessSource.cpp
+    Created: 22 Oct 2026 9:14:36am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "GaplessSource.h"
+
+namespace
+{
+    const int mp3DecoderDelay = 529;    // what a standard decoder adds on top of the encoder delay
+    const int tagSearchBytes = 4096;
+
+    uint32 readBigEndian(const uint8* data)
+    {
+        return ((uint32) data[0] << 24) | ((uint32) data[1] << 16) | ((uint32) data[2] << 8) | (uint32) data[3];
+    }
+}
+
+//==============================================================================
+GaplessSource::Trim GaplessSource::findEncoderTrim(InputStream& stream, int64 decodedLength)
+{
+    Trim trim;
+
+    // step over an ID3v2 tag to the first frame
+    uint8 id3[10];
+    if (stream.read(id3, 10) != 10)
+        return trim;
+
+    int64 frameStart = 0;
+    if (id3[0] == 'I' && id3[1] == 'D' && id3[2] == '3')
+        frameStart = 10 + (((id3[6] & 0x7f) << 21) | ((id3[7] & 0x7f) << 14) | ((id3[8] & 0x7f) << 7) | (id3[9] & 0x7f))
+                   + ((id3[5] & 0x10) != 0 ? 10 : 0);
+
+    if (!stream.setPosition(frameStart))
+        return trim;
+
+    HeapBlock<uint8> block(tagSearchBytes, true);
+    auto numBytes = stream.read(block, tagSearchBytes);
+
+    // the first frame header
+    int sync = 0;
+    while (sync + 4 <= numBytes && !(block[sync] == 0xff && (block[sync + 1] & 0xe0) == 0xe0))
+        ++sync;
+
+    if (sync + 4 > numBytes)
+        return trim;
+
+    const uint8* frame = block + sync;
+    auto mpeg1 = ((frame[1] >> 3) & 3) == 3;
+    auto mono = ((frame[3] >> 6) & 3) == 3;
+    auto samplesPerFrame = mpeg1 ? 1152 : 576;
+
+    // the Xing or Info header sits after the side information
+    auto tag = sync + 4 + (mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17));
+    if (tag + 8 > numBytes)
+        return trim;
+
+    if (memcmp(block + tag, "Xing", 4) != 0 && memcmp(block + tag, "Info", 4) != 0)
+        return trim;
+
+    auto flags = readBigEndian(block + tag + 4);
+    auto position = tag + 8;
+    int64 numFrames = 0;
+
+    if ((flags & 1) != 0)
+    {
+        if (position + 4 > numBytes)
+            return trim;
+
+        numFrames = readBigEndian(block + position);
+        position += 4;
+    }
+
+    if ((flags & 2) != 0) position += 4;    // byte count
+    if ((flags & 4) != 0) position += 100;  // seek table
+    if ((flags & 8) != 0) position += 4;    // quality
+
+    // LAME's extension, also written by ffmpeg: the delay and padding are 12 bits each, 21 bytes in
+    if (numFrames == 0 || position + 24 > numBytes)
+        return trim;
+
+    auto encoder = String::fromUTF8((const char*) block.get() + position, 4);
+    if (encoder != "LAME" && encoder != "Lavf" && encoder != "Lavc")
+        return trim;
+
+    auto* delayAndPadding = block + position + 21;
+    auto encoderDelay = (delayAndPadding[0] << 4) | (delayAndPadding[1] >> 4);
+    auto padding = ((delayAndPadding[1] & 0x0f) << 8) | delayAndPadding[2];
+
+    // only a decoder that hands back every frame still has them; the tag frame may decode as silence too
+    auto allFrames = numFrames * samplesPerFrame;
+
+    if (decodedLength != allFrames && decodedLength != allFrames + samplesPerFrame)
+        return trim;
+
+    trim.start = (decodedLength - allFrames) + encoderDelay + mp3DecoderDelay;
+    trim.end = jmax(0, padding - mp3DecoderDelay);
+    return trim;
+}
+
+//==============================================================================
+GaplessSource::GaplessSource()
+{
+    tail.setSize(2, maxCrossfadeSamples);
+}
+
+void GaplessSource::setCurrent(CueWindowSource* source, Trim trim)
+{
+    current = source;
+    currentTrimEnd = trim.end;
+    tailLength = 0;
+    tailPosition = 0;
+    switched = false;
+}
+
+void GaplessSource::setQueued(CueWindowSource* source, Trim trim, int crossfadeSamples)
+{
+    // everything the audio thread needs is in place before the pointer it looks for
+    queuedTrimEnd = trim.end;
+    crossfadeLength = jlimit(0, maxCrossfadeSamples, crossfadeSamples);
+    queued = source;
+}
+
+bool GaplessSource::cancelQueued()
+{
+    return queued.exchange(nullptr) != nullptr;
+}
+
+//==============================================================================
+void GaplessSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    if (auto* source = current.load())
+        source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void GaplessSource::releaseResources()
+{
+    if (auto* source = current.load())
+        source->releaseResources();
+}
+
+void GaplessSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    auto* source = current.load();
+
+    if (source == nullptr)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    auto* next = queued.load();
+    auto numSamples = bufferToFill.numSamples;
+
+    if (next != nullptr)
+    {
+        // switch where the overlap with the next track has to begin
+        auto fadeLength = crossfadeLength.load();
+        auto switchAt = source->getTotalLength() - currentTrimEnd.load() - fadeLength;
+        auto beforeSwitch = (int) jlimit<int64>(0, numSamples, switchAt - source->getNextReadPosition());
+
+        if (beforeSwitch < numSamples && queued.compare_exchange_strong(next, nullptr))
+        {
+            if (beforeSwitch > 0)
+                source->getNextAudioBlock(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample, beforeSwitch));
+
+            // the end of the outgoing track, to fade out over the start of the next one
+            tailLength = fadeLength;
+            tailPosition = 0;
+
+            if (tailLength > 0)
+            {
+                tail.clear();
+                source->getNextAudioBlock(AudioSourceChannelInfo(&tail, 0, tailLength));
+            }
+
+            current = next;
+            currentTrimEnd = queuedTrimEnd.load();
+            switched = true;
+
+            auto startSample = bufferToFill.startSample + beforeSwitch;
+            auto remaining = numSamples - beforeSwitch;
+            next->getNextAudioBlock(AudioSourceChannelInfo(bufferToFill.buffer, startSample, remaining));
+            mixTail(*bufferToFill.buffer, startSample, remaining);
+            return;
+        }
+    }
+
+    source->getNextAudioBlock(bufferToFill);
+    mixTail(*bufferToFill.buffer, bufferToFill.startSample, numSamples);
+}
+
+void GaplessSource::mixTail(AudioBuffer<float>& dest, int startSample, int numSamples)
+{
+    auto numToMix = jmin(numSamples, tailLength - tailPosition);
+
+    if (numToMix <= 0)
+        return;
+
+    for (int channel = 0; channel < dest.getNumChannels(); ++channel)
+    {
+        auto* out = dest.getWritePointer(channel, startSample);
+        auto* in = tail.getReadPointer(jmin(channel, tail.getNumChannels() - 1), tailPosition);
+
+        for (int i = 0; i < numToMix; ++i)
+        {
+            auto fadeIn = (float) (tailPosition + i + 1) / (float) (tailLength + 1);
+            out[i] = out[i] * fadeIn + in[i] * (1.0f - fadeIn);
+        }
+    }
+
+    tailPosition += numToMix;
+}
+
+void GaplessSource::setNextReadPosition(int64 newPosition)
+{
+    if (auto* source = current.load())
+        source->setNextReadPosition(newPosition);
+}
+
+int64 GaplessSource::getNextReadPosition() const
+{
+    auto* source = current.load();
+    return source != nullptr ? source->getNextReadPosition() : 0;
+}
+
+int64 GaplessSource::getTotalLength() const
+{
+    auto* source = current.load();
+    return source != nullptr ? source->getTotalLength() : 0;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    GaplessSource.h
+    Created: 22 Oct 2026 9:14:36am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "CueWindowSource.h"
+
+//==============================================================================
+/*
+    What a deck's transport plays from: the current track's CueWindowSource,
+    plus an optional queued one to carry on with when it ends.
+
+    The queued source is opened, prepared and positioned on the message thread,
+    so its read-ahead is already full when it's needed. On the audio thread the
+    switch happens at the exact sample where the current track ends, part way
+    through a block if need be. A short overlap can crossfade the two.
+
+    MP3 encoders pad the start and end of a track, which is an audible gap
+    between album tracks. findEncoderTrim reads the padding from the LAME tag
+    so it can be skipped.
+
+    Both sources are owned by the deck. The audio thread only swaps pointers,
+    and the deck polls takeSwitch() from a timer and deletes the old source on
+    the message thread.
+*/
+class GaplessSource : public PositionableAudioSource
+{
+public:
+    struct Trim
+    {
+        int64 start = 0;    // samples to skip at the start
+        int64 end = 0;      // samples to leave off the end
+    };
+
+    /** The encoder delay and padding left in by a decoder that doesn't remove them,
+        read from an MP3's LAME tag. No trim if there is no tag, or if decodedLength
+        shows the decoder has already removed them.
+    */
+    static Trim findEncoderTrim(InputStream& mp3Stream, int64 decodedLength);
+
+    GaplessSource();
+
+    /** message thread, while the transport isn't using this: play this source from now on */
+    void setCurrent(CueWindowSource* source, Trim trim);
+    /** message thread: carry on with this source when the current one ends. It must already
+        be prepared and positioned where it should start. */
+    void setQueued(CueWindowSource* source, Trim trim, int crossfadeSamples);
+    /** message thread: false if the audio thread had already switched to the queued source,
+        or is part way through the block that does; hasSwitched() is true once that ends */
+    bool cancelQueued();
+
+    /** the source playing now; audio thread, or the message thread before a switch is taken */
+    CueWindowSource* getCurrent() const noexcept { return current.load(); }
+    /** true once the audio thread has moved on to the queued source, until takeSwitch */
+    bool hasSwitched() const noexcept { return switched.load(); }
+    /** message thread: true once per switch */
+    bool takeSwitch() { return switched.exchange(false); }
+
+    //==============================================================================
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(int64 newPosition) override;
+    int64 getNextReadPosition() const override;
+    int64 getTotalLength() const override;
+    bool isLooping() const override { return false; }
+
+    static constexpr int maxCrossfadeSamples = 4096;
+
+private:
+    /** fades the rest of the outgoing track's tail out over the incoming one */
+    void mixTail(AudioBuffer<float>& dest, int startSample, int numSamples);
+
+    std::atomic<CueWindowSource*> current{ nullptr };
+    std::atomic<CueWindowSource*> queued{ nullptr };
+    std::atomic<int64> currentTrimEnd{ 0 };
+    std::atomic<int64> queuedTrimEnd{ 0 };
+    std::atomic<int> crossfadeLength{ 0 };
+    std::atomic<bool> switched{ false };
+
+    AudioBuffer<float> tail;
+    int tailLength = 0;
+    int tailPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GaplessSource)
+};
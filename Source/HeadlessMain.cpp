@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    HeadlessMain.cpp
+    Created: 23 Oct 2026 5:44:58pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "OtoDecksEngine.h"
+#include "MasterLimiter.h"
+#include "EngineStress.h"
+#include "StreamCheck.h"
+#include "CueBusCheck.h"
+#include "MidiCheck.h"
+#include "GaplessCheck.h"
+#include "SessionCheck.h"
+#include "SamplerCheck.h"
+
+//==============================================================================
+/*
+    OtoDecksHeadless: the engine's command-line runs, linked against
+    otodecks_engine alone, without a window or the GUI modules.
+
+      --stress [seconds]   the deck engine stress run, see EngineStress
+      --bench-limiter      the master limiter's cost at small block sizes
+      --limiter-check      the master limiter's ceiling at the longest look-ahead
+      --bench-deck         each deck's EQ and filter cost at small block sizes
+      --bench-recommender  a recommendation query over a million tracks
+      --stream-check       HTTP streaming against a stand-in server, see StreamCheck
+      --cue-check          PFL routing to outputs 3-4 of a null device, see CueBusCheck
+      --midi-check         the MIDI mapping through a virtual ALSA port, see MidiCheck
+      --gapless-check      the handover to a queued track and the MP3 trim, see GaplessCheck
+      --session-check      the session snapshot's round trip and restore, see SessionCheck
+      --sampler-check      voice stealing, stop all and grid quantising, see SamplerCheck
+      --render <automation> <wav> [sampleRate]
+                           play a recorded set's automation back offline into a WAV
+      --trace [file]       record a Chrome trace of the run
+
+    The checks report through CheckResults, and ctest runs each of them.
+*/
+int main(int argc, char* argv[])
+{
+    // The decks post their results to a message thread, even with no window. Nothing
+    // runs its loop here, so the runs that need them call EngineStress::dispatchMessages
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    StringArray arguments;
+    for (int i = 1; i < argc; ++i)
+        arguments.add(String::fromUTF8(argv[i]));
+
+    auto traceIndex = arguments.indexOf("--trace");
+    File traceFile;
+
+    if (traceIndex >= 0)
+    {
+        auto path = arguments[traceIndex + 1];
+        traceFile = path.isNotEmpty() && !path.startsWith("-") ? File::getCurrentWorkingDirectory().getChildFile(path)
+                                                              : Tracer::getDefaultFile();
+        Tracer::start();
+    }
+
+    auto result = 0;
+
+    if (arguments.contains("--bench-limiter"))
+    {
+        MasterLimiter::benchmark();
+    }
+    else if (arguments.contains("--limiter-check"))
+    {
+        result = MasterLimiter::check();
+    }
+    else if (arguments.contains("--bench-deck"))
+    {
+        DeckEQ::benchmark();
+    }
+    else if (arguments.contains("--bench-recommender"))
+    {
+        Recommender::benchmark();
+    }
+    else if (arguments.contains("--stress"))
+    {
+        auto seconds = arguments[arguments.indexOf("--stress") + 1].getDoubleValue();
+        result = EngineStress::run(seconds > 0.0 ? seconds : 10.0);
+    }
+    else if (arguments.contains("--stream-check"))
+    {
+        result = StreamCheck::run();
+    }
+    else if (arguments.contains("--cue-check"))
+    {
+        result = CueBusCheck::run();
+    }
+    else if (arguments.contains("--midi-check"))
+    {
+        result = MidiCheck::run();
+    }
+    else if (arguments.contains("--gapless-check"))
+    {
+        result = GaplessCheck::run();
+    }
+    else if (arguments.contains("--session-check"))
+    {
+        result = SessionCheck::run();
+    }
+    else if (arguments.contains("--sampler-check"))
+    {
+        result = SamplerCheck::run();
+    }
+    else if (arguments.contains("--render"))
+    {
+        auto index = arguments.indexOf("--render");
+        auto workingDirectory = File::getCurrentWorkingDirectory();
+
+        if (arguments[index + 1].isEmpty() || arguments[index + 2].isEmpty())
+        {
+            std::cout << "usage: OtoDecksHeadless --render <automation> <wav> [sampleRate]" << std::endl;
+            result = 1;
+        }
+        else
+        {
+            result = Automation::render(workingDirectory.getChildFile(arguments[index + 1]),
+                                        workingDirectory.getChildFile(arguments[index + 2]),
+                                        arguments[index + 3].getDoubleValue());
+        }
+    }
+    else
+    {
+        std::cout << "usage: OtoDecksHeadless --stress [seconds] | --bench-limiter | --limiter-check | --bench-deck | --bench-recommender | --stream-check | --cue-check | --midi-check | --gapless-check | --session-check | --sampler-check | --render <automation> <wav> [sampleRate] [--trace [file]]" << std::endl;
+        result = 1;
+    }
+
+    if (Tracer::isEnabled())
+        Tracer::stopAndWrite(traceFile);
+
+    return result;
+}
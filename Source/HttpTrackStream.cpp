@@ -0,0 +1,675 @@
+/*
+  ==============================================================================
+
+    HttpTrackStream.cpp
+    Created: 24 Oct 2026 9:52:17am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "HttpTrackStream.h"
+#include "Tracer.h"
+
+namespace
+{
+    const int blockSize = HttpTrackStream::blockSize;
+    const int maxRunBlocks = 8;         // blocks asked for in one range request
+    const int prefetchBlocks = 32;      // kept ready ahead of each stream
+    const int chunkBytes = 1 << 14;     // read from the connection at a time
+    const int connectTimeoutMs = 3000;
+    const int readTimeoutMs = 10000;
+    const int maxAttempts = 3;
+    const int blocksPerMapSave = 32;
+    const int64 maxCacheBytes = (int64) 2 << 30;
+    const int streamBufferBytes = 1 << 16;
+    const int mapMagic = 0x4f544243;    // "OTBC"
+
+    File getCacheFolder()
+    {
+        auto folder = File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks Stream Cache");
+        folder.createDirectory();
+        return folder;
+    }
+
+    int getNumBlocks(int64 length)
+    {
+        return (int) ((length + blockSize - 1) / blockSize);
+    }
+
+    /** the total from a Content-Range header, like "bytes 0-65535/1234567"; -1 if it has none */
+    int64 parseTotalLength(const String& contentRange)
+    {
+        auto total = contentRange.fromLastOccurrenceOf("/", false, false).trim();
+        return total.isNotEmpty() && total.containsOnly("0123456789") ? total.getLargeIntValue() : -1;
+    }
+}
+
+//==============================================================================
+/*
+    The cache and fetch thread behind every stream of one URL. Streams get one
+    through get(), and release it through release(), so the registry lock is
+    held whenever a count could reach zero.
+*/
+class HttpTrackStream::SharedTrack : public ReferenceCountedObject,
+                                     private Thread
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<SharedTrack>;
+
+    static Ptr get(const URL& url)
+    {
+        auto& registry = getRegistry();
+        const ScopedLock sl(registry.lock);
+
+        for (auto* track : registry.tracks)
+            if (track->url == url)
+                return track;
+
+        trimCacheFolder(registry.tracks);
+
+        Ptr track(new SharedTrack(url));
+        registry.tracks.add(track.get());
+        return track;
+    }
+
+    static bool removeFromCache(const URL& url)
+    {
+        auto& registry = getRegistry();
+        const ScopedLock sl(registry.lock);
+
+        for (auto* track : registry.tracks)
+            if (track->url == url)
+                return false;
+
+        auto name = String::toHexString(url.toString(false).hashCode64());
+        getCacheFolder().getChildFile(name + ".map").deleteFile();
+        return getCacheFolder().getChildFile(name + ".data").deleteFile();
+    }
+
+    static void release(Ptr& track)
+    {
+        Ptr last;
+
+        {
+            auto& registry = getRegistry();
+            const ScopedLock sl(registry.lock);
+
+            if (track->getReferenceCount() == 1)
+            {
+                registry.tracks.removeFirstMatchingValue(track.get());
+                last = std::move(track);
+            }
+
+            track = nullptr;
+        }
+
+        // stopping the fetch thread can take a moment, so not while others wait on the registry
+        last = nullptr;
+    }
+
+    explicit SharedTrack(const URL& _url)
+        : Thread("Track stream"), url(_url)
+    {
+        auto name = String::toHexString(url.toString(false).hashCode64());
+        dataFile = getCacheFolder().getChildFile(name + ".data");
+        mapFile = getCacheFolder().getChildFile(name + ".map");
+
+        loadMap();
+        dataFile.setLastModificationTime(Time::getCurrentTime());
+
+        writer = std::make_unique<FileOutputStream>(dataFile);
+        reader = dataFile.createInputStream();
+
+        if (writer->failedToOpen() || reader == nullptr)
+        {
+            DBG("HttpTrackStream - Couldn't open the cache file " + dataFile.getFullPathName());
+            failed = true;
+            return;
+        }
+
+        startThread(Thread::Priority::normal);
+    }
+
+    ~SharedTrack() override
+    {
+        signalThreadShouldExit();
+
+        {
+            const ScopedLock sl(connectionLock);
+
+            if (connection != nullptr)
+                connection->cancel();
+        }
+
+        wakeUp.signal();
+        stopThread(connectTimeoutMs);
+
+        const ScopedLock sl(lock);
+        saveMap();
+    }
+
+    /** the track's length once the cache or the server has said; -1 if neither does in time */
+    int64 waitForLength(int timeoutMs)
+    {
+        auto deadline = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        for (;;)
+        {
+            dataArrived.reset();
+
+            {
+                const ScopedLock sl(lock);
+
+                if (totalLength >= 0 || failed)
+                    return totalLength;
+            }
+
+            if (Time::getMillisecondCounter() > deadline)
+                return -1;
+
+            dataArrived.wait(10);
+        }
+    }
+
+    int addReader()
+    {
+        const ScopedLock sl(lock);
+        readerPositions[++lastReaderId] = 0;
+        return lastReaderId;
+    }
+
+    void removeReader(int readerId)
+    {
+        const ScopedLock sl(lock);
+        readerPositions.erase(readerId);
+    }
+
+    void setReaderPosition(int readerId, int64 position)
+    {
+        {
+            const ScopedLock sl(lock);
+            readerPositions[readerId] = position;
+        }
+
+        wakeUp.signal();
+    }
+
+    int read(int readerId, int64 position, void* destBuffer, int numBytes)
+    {
+        auto* dest = static_cast<char*>(destBuffer);
+        auto deadline = Time::getMillisecondCounter() + (uint32) readTimeoutMs;
+        auto numRead = 0;
+
+        while (numRead < numBytes)
+        {
+            auto offset = position + numRead;
+            auto block = (int) (offset / blockSize);
+            dataArrived.reset();
+
+            {
+                const ScopedLock sl(lock);
+
+                if (failed || totalLength < 0 || offset >= totalLength)
+                    break;
+
+                if (present[(size_t) block] != 0)
+                {
+                    auto blockEnd = jmin(totalLength, (int64) (block + 1) * blockSize);
+                    auto numToRead = (int) jmin((int64) (numBytes - numRead), blockEnd - offset);
+
+                    if (!reader->setPosition(offset) || reader->read(dest + numRead, numToRead) != numToRead)
+                        break;
+
+                    numRead += numToRead;
+                    continue;
+                }
+
+                // the fetch thread takes waited-on blocks first
+                if (std::find(waitedOn.begin(), waitedOn.end(), block) == waitedOn.end())
+                    waitedOn.push_back(block);
+            }
+
+            wakeUp.signal();
+
+            if (Time::getMillisecondCounter() > deadline)
+            {
+                DBG("HttpTrackStream - Timed out waiting for block " + String(block) + " of " + url.getFileName());
+                break;
+            }
+
+            dataArrived.wait(10);
+        }
+
+        setReaderPosition(readerId, position + numRead);
+        return numRead;
+    }
+
+private:
+    struct Registry
+    {
+        CriticalSection lock;
+        Array<SharedTrack*> tracks;
+    };
+
+    static Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /** drops the least recently used tracks that nobody has open until the folder fits */
+    static void trimCacheFolder(const Array<SharedTrack*>& openTracks)
+    {
+        auto files = getCacheFolder().findChildFiles(File::findFiles, false, "*.data");
+
+        std::sort(files.begin(), files.end(), [](const File& a, const File& b)
+        {
+            return a.getLastModificationTime() > b.getLastModificationTime();
+        });
+
+        int64 totalBytes = 0;
+
+        for (auto& file : files)
+        {
+            totalBytes += file.getSize();
+
+            auto isOpen = std::any_of(openTracks.begin(), openTracks.end(), [&file](SharedTrack* track)
+            {
+                return track->dataFile == file;
+            });
+
+            if (totalBytes > maxCacheBytes && !isOpen)
+            {
+                totalBytes -= file.getSize();
+                file.deleteFile();
+                file.withFileExtension(".map").deleteFile();
+            }
+        }
+    }
+
+    //==============================================================================
+    void run() override
+    {
+        auto attempts = 0;
+
+        while (!threadShouldExit())
+        {
+            int firstBlock = 0, numBlocks = 0;
+
+            {
+                const ScopedLock sl(lock);
+                chooseRun(firstBlock, numBlocks);
+            }
+
+            if (numBlocks == 0)
+            {
+                wakeUp.wait(200);
+                continue;
+            }
+
+            if (fetch(firstBlock, numBlocks))
+            {
+                attempts = 0;
+                continue;
+            }
+
+            if (threadShouldExit())
+                break;
+
+            if (++attempts >= maxAttempts)
+            {
+                DBG("HttpTrackStream - Giving up on " + url.toString(false));
+
+                const ScopedLock sl(lock);
+                failed = true;
+                dataArrived.signal();
+                break;
+            }
+
+            wait(250 * attempts);
+        }
+    }
+
+    /** lock held: the next blocks to ask for, or none */
+    void chooseRun(int& firstBlock, int& numBlocks)
+    {
+        numBlocks = 0;
+
+        // the first request finds the length
+        if (totalLength < 0)
+        {
+            firstBlock = 0;
+            numBlocks = 1;
+            return;
+        }
+
+        auto total = getNumBlocks(totalLength);
+        auto isMissing = [&](int block) { return block < total && present[(size_t) block] == 0; };
+
+        auto start = -1;
+
+        while (start < 0 && !waitedOn.empty())
+        {
+            if (isMissing(waitedOn.front()))
+                start = waitedOn.front();
+            else
+                waitedOn.pop_front();
+        }
+
+        // then the nearest gap ahead of any stream
+        if (start < 0)
+        {
+            auto nearest = prefetchBlocks;
+
+            for (auto& reader : readerPositions)
+            {
+                auto from = (int) (reader.second / blockSize);
+
+                for (int block = from; block < jmin(total, from + nearest); ++block)
+                {
+                    if (isMissing(block))
+                    {
+                        nearest = block - from;
+                        start = block;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // then whatever is left, so the whole track ends up on disk
+        for (int block = 0; start < 0 && block < total; ++block)
+            if (isMissing(block))
+                start = block;
+
+        if (start < 0)
+            return;
+
+        firstBlock = start;
+        numBlocks = 1;
+
+        while (numBlocks < maxRunBlocks && isMissing(firstBlock + numBlocks))
+            ++numBlocks;
+    }
+
+    /** one range request; false if it failed */
+    bool fetch(int firstBlock, int numBlocks)
+    {
+        TRACE_SPAN("HttpTrackStream fetch");
+
+        auto rangeStart = (int64) firstBlock * blockSize;
+        auto rangeEnd = rangeStart + (int64) numBlocks * blockSize - 1;
+
+        {
+            const ScopedLock sl(lock);
+
+            if (totalLength >= 0)
+                rangeEnd = jmin(rangeEnd, totalLength - 1);
+        }
+
+        WebInputStream stream(url, false);
+        stream.withExtraHeaders("Range: bytes=" + String(rangeStart) + "-" + String(rangeEnd));
+        stream.withConnectionTimeout(connectTimeoutMs);
+
+        {
+            const ScopedLock sl(connectionLock);
+            connection = &stream;
+        }
+
+        auto received = !threadShouldExit() && stream.connect(nullptr) && receive(stream, firstBlock, rangeEnd);
+
+        const ScopedLock sl(connectionLock);
+        connection = nullptr;
+
+        return received;
+    }
+
+    bool receive(WebInputStream& stream, int firstBlock, int64 rangeEnd)
+    {
+        auto status = stream.getStatusCode();
+        int64 length = -1;
+
+        if (status == 206)
+        {
+            length = parseTotalLength(stream.getResponseHeaders()["Content-Range"]);
+        }
+        else if (status == 200)
+        {
+            // the server sent the whole track, so take all of it in order
+            length = stream.getTotalLength();
+            firstBlock = 0;
+            rangeEnd = length - 1;
+        }
+
+        if (length < 0)
+        {
+            DBG("HttpTrackStream - " + url.getFileName() + " answered " + String(status));
+            return false;
+        }
+
+        {
+            const ScopedLock sl(lock);
+            setLength(length);
+            rangeEnd = jmin(rangeEnd, length - 1);
+        }
+
+        HeapBlock<char> buffer(blockSize);
+        auto lastBlock = (int) (rangeEnd / blockSize);
+
+        for (int block = firstBlock; block <= lastBlock; ++block)
+        {
+            auto blockStart = (int64) block * blockSize;
+            auto size = (int) (jmin(rangeEnd + 1, blockStart + blockSize) - blockStart);
+
+            for (int numRead = 0; numRead < size;)
+            {
+                if (threadShouldExit())
+                    return false;
+
+                auto chunk = stream.read(buffer + numRead, jmin(chunkBytes, size - numRead));
+                if (chunk <= 0)
+                    return false;
+
+                numRead += chunk;
+            }
+
+            if (!store(block, buffer, size))
+                return false;
+
+            // a read waiting somewhere else comes before the rest of this run
+            if (status == 206 && block < lastBlock && isWaitedOnElsewhere(block + 1, lastBlock))
+                return true;
+        }
+
+        return true;
+    }
+
+    /** lock held: a new length from the server, which throws away a cache of a different one */
+    void setLength(int64 length)
+    {
+        if (length == totalLength)
+            return;
+
+        if (totalLength >= 0)
+        {
+            DBG("HttpTrackStream - " + url.getFileName() + " has changed on the server, clearing its cache");
+            writer->setPosition(0);
+            writer->truncate();
+        }
+
+        totalLength = length;
+        present.assign((size_t) getNumBlocks(length), 0);
+        dataArrived.signal();
+    }
+
+    bool store(int block, const char* data, int size)
+    {
+        const ScopedLock sl(lock);
+
+        if (present[(size_t) block] != 0)
+            return true;
+
+        if (!writer->setPosition((int64) block * blockSize) || !writer->write(data, (size_t) size))
+        {
+            DBG("HttpTrackStream - Couldn't write to " + dataFile.getFullPathName());
+            return false;
+        }
+
+        writer->flush();
+        present[(size_t) block] = 1;
+
+        if (++blocksSinceMapSave >= blocksPerMapSave)
+            saveMap();
+
+        dataArrived.signal();
+        return true;
+    }
+
+    bool isWaitedOnElsewhere(int fromBlock, int toBlock)
+    {
+        const ScopedLock sl(lock);
+
+        for (auto block : waitedOn)
+            if (present[(size_t) block] == 0 && (block < fromBlock || block > toBlock))
+                return true;
+
+        return false;
+    }
+
+    //==============================================================================
+    /** the map is the length and block size, then a byte per block */
+    void loadMap()
+    {
+        MemoryBlock data;
+
+        if (!dataFile.existsAsFile() || !mapFile.loadFileAsData(data))
+            return;
+
+        MemoryInputStream in(data, false);
+
+        if (in.readInt() != mapMagic || in.readInt() != blockSize)
+            return;
+
+        auto length = in.readInt64();
+
+        if (length <= 0 || in.getNumBytesRemaining() != getNumBlocks(length))
+            return;
+
+        totalLength = length;
+        present.resize((size_t) getNumBlocks(length));
+        in.read(present.data(), (int) present.size());
+    }
+
+    /** lock held */
+    void saveMap()
+    {
+        blocksSinceMapSave = 0;
+
+        if (totalLength < 0)
+            return;
+
+        MemoryOutputStream out;
+        out.writeInt(mapMagic);
+        out.writeInt(blockSize);
+        out.writeInt64(totalLength);
+        out.write(present.data(), present.size());
+        mapFile.replaceWithData(out.getData(), out.getDataSize());
+    }
+
+    //==============================================================================
+    const URL url;
+    File dataFile, mapFile;
+
+    CriticalSection lock;
+    int64 totalLength = -1;
+    std::vector<uint8> present;
+    std::deque<int> waitedOn;
+    std::map<int, int64> readerPositions;
+    int lastReaderId = 0;
+    int blocksSinceMapSave = 0;
+    bool failed = false;
+
+    std::unique_ptr<FileOutputStream> writer;
+    std::unique_ptr<FileInputStream> reader;
+
+    WaitableEvent dataArrived{ true };   // signalled after every block, reset by whoever is about to wait
+    WaitableEvent wakeUp;
+    CriticalSection connectionLock;
+    WebInputStream* connection = nullptr;   // so the destructor can cut a fetch short
+
+    JUCE_DECLARE_NON_COPYABLE(SharedTrack)
+};
+
+//==============================================================================
+std::unique_ptr<InputStream> HttpTrackStream::createInputStreamFor(const URL& url)
+{
+    if (!isRemote(url))
+        return url.createInputStream(false);
+
+    auto stream = std::make_unique<HttpTrackStream>(url);
+
+    if (!stream->isOpen())
+        return nullptr;
+
+    // decoders read a few bytes at a time, and each read here takes the cache's lock
+    return std::make_unique<BufferedInputStream>(stream.release(), streamBufferBytes, true);
+}
+
+bool HttpTrackStream::isRemote(const URL& url)
+{
+    auto scheme = url.getScheme();
+    return scheme == "http" || scheme == "https";
+}
+
+bool HttpTrackStream::removeFromCache(const URL& url)
+{
+    return SharedTrack::removeFromCache(url);
+}
+
+HttpTrackStream::HttpTrackStream(const URL& url)
+    : track(SharedTrack::get(url))
+{
+    readerId = track->addReader();
+    totalLength = track->waitForLength(openTimeoutMs);
+}
+
+HttpTrackStream::~HttpTrackStream()
+{
+    track->removeReader(readerId);
+    SharedTrack::release(track);
+}
+
+int HttpTrackStream::read(void* destBuffer, int maxBytesToRead)
+{
+    auto numRead = track->read(readerId, position, destBuffer, maxBytesToRead);
+    position += numRead;
+    return numRead;
+}
+
+bool HttpTrackStream::setPosition(int64 newPosition)
+{
+    position = jlimit((int64) 0, jmax((int64) 0, totalLength), newPosition);
+    track->setReaderPosition(readerId, position);
+    return true;
+}
+
+//==============================================================================
+InputStream* TrackInputSource::createInputStreamFor(const String& relatedItemPath)
+{
+    return HttpTrackStream::isRemote(url) ? nullptr
+                                          : url.getChildURL(relatedItemPath).createInputStream(false).release();
+}
+
+int64 TrackInputSource::hashCode() const
+{
+    auto hash = url.toString(false).hashCode64();
+
+    if (url.isLocalFile())
+    {
+        auto file = url.getLocalFile();
+        hash ^= file.getSize() * 7919 + file.getLastModificationTime().toMilliseconds();
+    }
+
+    return hash;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    HttpTrackStream.h
+    Created: 24 Oct 2026 9:52:17am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    A seekable stream of a track on a web server, read with HTTP range
+    requests so it can play before it has finished downloading.
+
+    Every stream of the same URL, the deck's, its hot cue windows', the
+    analysis' and the waveform's, shares one block cache on disk and one
+    thread fetching into it. The thread fetches, in this order:
+      - blocks a read is waiting on, so a seek costs one range request
+      - the blocks just ahead of each stream's position
+      - the rest of the track, front to back
+    A wait for a block somewhere else stops a long fetch between blocks.
+
+    The cache is a sparse file in the temp folder with a map of the blocks it
+    holds, so a track heard before starts straight from disk. The folder is
+    kept under a size limit, least recently used first.
+
+    Servers that ignore ranges still work: the track is then read in order,
+    and a seek waits until the download has got there.
+*/
+class HttpTrackStream : public InputStream
+{
+public:
+    /** http and https URLs stream through the block cache, and anything else opens
+        as usual; nullptr if it can't be opened. On Linux, https needs JUCE's curl
+        backend, which both CMake targets are built with */
+    static std::unique_ptr<InputStream> createInputStreamFor(const URL& url);
+    static bool isRemote(const URL& url);
+    /** deletes a track's cached blocks; false if a stream of it is open */
+    static bool removeFromCache(const URL& url);
+
+    /** waits up to openTimeoutMs for the length, from the cache or the first response */
+    explicit HttpTrackStream(const URL& url);
+    ~HttpTrackStream() override;
+
+    /** false if the track's length couldn't be found */
+    bool isOpen() const { return totalLength >= 0; }
+
+    int64 getTotalLength() override { return totalLength; }
+    bool isExhausted() override { return position >= totalLength; }
+    /** blocks until the bytes have arrived, up to a timeout */
+    int read(void* destBuffer, int maxBytesToRead) override;
+    int64 getPosition() override { return position; }
+    /** also moves where this stream's prefetch starts */
+    bool setPosition(int64 newPosition) override;
+
+    static constexpr int blockSize = 1 << 16;
+    static constexpr int openTimeoutMs = 5000;
+
+private:
+    class SharedTrack;
+
+    ReferenceCountedObjectPtr<SharedTrack> track;
+    int readerId = 0;
+    int64 position = 0;
+    int64 totalLength = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HttpTrackStream)
+};
+
+//==============================================================================
+/*
+    An InputSource that opens through HttpTrackStream, for an AudioThumbnail
+    to draw a remote track from the same cache the deck plays it from.
+*/
+class TrackInputSource : public InputSource
+{
+public:
+    explicit TrackInputSource(const URL& _url) : url(_url) {}
+
+    InputStream* createInputStream() override { return HttpTrackStream::createInputStreamFor(url).release(); }
+    InputStream* createInputStreamFor(const String& relatedItemPath) override;
+    /** a local file's also changes with its size and modification time, as the waveform
+        cache outlives the file's contents */
+    int64 hashCode() const override;
+
+private:
+    const URL url;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackInputSource)
+};
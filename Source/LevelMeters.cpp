@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    LevelMeters.cpp
+    Created: 23 Oct 2026 2:58:20pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "LevelMeters.h"
+#include "Tracer.h"
+
+namespace
+{
+    const float floorDb = -60.0f;
+    const float topDb = 6.0f;              // the decks can go over before the crossfader
+    const float peakFallDbPerSecond = 20.0f;
+    const double rmsTimeSeconds = 0.3;
+    const double holdSeconds = 1.5;
+    const double silentAfterSeconds = 0.1; // no blocks for this long means the audio has stopped
+    const int labelHeight = 14;
+}
+
+LevelMeters::LevelMeters()
+{
+    samples.setSize(MeterTap::numChannels, MeterTap::capacity);
+}
+
+LevelMeters::~LevelMeters()
+{
+}
+
+void LevelMeters::addMeter(MeterTap& tap, const String& name)
+{
+    Meter meter;
+    meter.tap = &tap;
+    meter.name = name;
+
+    for (int channel = 0; channel < MeterTap::numChannels; ++channel)
+    {
+        meter.peakDb[channel] = meter.rmsDb[channel] = meter.holdDb[channel] = floorDb;
+        meter.holdUntil[channel] = 0.0;
+    }
+
+    meters.push_back(meter);
+    resized();
+}
+
+//==============================================================================
+void LevelMeters::update()
+{
+    TRACE_SPAN("LevelMeters::update");
+
+    auto now = Time::getMillisecondCounterHiRes() * 0.001;
+    auto elapsed = lastUpdateTime > 0.0 ? jmin(0.25, now - lastUpdateTime) : 0.0;
+    lastUpdateTime = now;
+
+    for (size_t i = 0; i < meters.size(); ++i)
+    {
+        auto& meter = meters[i];
+        auto numSamples = meter.tap->pull(samples);
+        measure(meter, numSamples, now, elapsed);
+
+        if (numSamples > 0 && i == meters.size() - 1 && onSamplesRead != nullptr)
+            onSamplesRead(samples, numSamples, meter.tap->getSampleRate());
+    }
+
+    repaint(barArea);
+}
+
+void LevelMeters::measure(Meter& meter, int numSamples, double now, double elapsed)
+{
+    if (numSamples > 0)
+        meter.lastSamplesTime = now;
+
+    auto silent = now - meter.lastSamplesTime > silentAfterSeconds;
+    auto rmsCoefficient = (float) (1.0 - std::exp(-elapsed / rmsTimeSeconds));
+
+    for (int channel = 0; channel < MeterTap::numChannels; ++channel)
+    {
+        // the bars fall at a fixed rate, and jump up to any louder peak
+        auto peakDb = jmax(floorDb, meter.peakDb[channel] - peakFallDbPerSecond * (float) elapsed);
+
+        if (numSamples > 0)
+        {
+            auto* data = samples.getReadPointer(channel);
+            auto range = FloatVectorOperations::findMinAndMax(data, numSamples);
+            auto peak = jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+            peakDb = jmax(peakDb, Decibels::gainToDecibels(peak, floorDb));
+
+            // between blocks the last RMS stands; a frame can easily arrive before the next block
+            auto rms = samples.getRMSLevel(channel, 0, numSamples);
+            auto rmsGain = Decibels::decibelsToGain(meter.rmsDb[channel], floorDb);
+            meter.rmsDb[channel] = Decibels::gainToDecibels(rmsGain + (rms - rmsGain) * rmsCoefficient, floorDb);
+        }
+        else if (silent)
+        {
+            auto rmsGain = Decibels::decibelsToGain(meter.rmsDb[channel], floorDb);
+            meter.rmsDb[channel] = Decibels::gainToDecibels(rmsGain * (1.0f - rmsCoefficient), floorDb);
+        }
+
+        meter.peakDb[channel] = peakDb;
+
+        if (peakDb >= meter.holdDb[channel] || now > meter.holdUntil[channel])
+        {
+            meter.holdDb[channel] = peakDb;
+            meter.holdUntil[channel] = now + holdSeconds;
+        }
+    }
+}
+
+int LevelMeters::levelToY(float db) const
+{
+    auto proportion = jlimit(0.0f, 1.0f, (db - floorDb) / (topDb - floorDb));
+    return barArea.getBottom() - roundToInt(proportion * (float) barArea.getHeight());
+}
+
+//==============================================================================
+void LevelMeters::paint(Graphics& g)
+{
+    TRACE_SPAN("LevelMeters::paint");
+
+    g.fillAll(Colours::black);
+
+    if (meters.empty() || barWidth <= 0)
+        return;
+
+    auto meterWidth = getWidth() / (int) meters.size();
+
+    for (size_t i = 0; i < meters.size(); ++i)
+    {
+        auto& meter = meters[i];
+        auto x = (int) i * meterWidth + (meterWidth - barWidth * MeterTap::numChannels - 1) / 2;
+
+        for (int channel = 0; channel < MeterTap::numChannels; ++channel)
+        {
+            auto barX = x + channel * (barWidth + 1);
+            auto peakY = levelToY(meter.peakDb[channel]);
+            auto rmsY = levelToY(meter.rmsDb[channel]);
+            auto top = barArea.getY();
+
+            auto drawSlice = [&](const Image& image, int fromY, int toY)
+            {
+                if (toY > fromY)
+                    g.drawImage(image, barX, fromY, barWidth, toY - fromY, 0, fromY - top, barWidth, toY - fromY);
+            };
+
+            // the unlit bar down to the peak, the lit one below it, and the RMS brighter still
+            drawSlice(unlitBar, top, peakY);
+            g.setOpacity(0.6f);
+            drawSlice(litBar, peakY, rmsY);
+            g.setOpacity(1.0f);
+            drawSlice(litBar, rmsY, barArea.getBottom());
+
+            auto holdDb = meter.holdDb[channel];
+            if (holdDb > floorDb)
+            {
+                g.setColour(holdDb >= 0.0f ? Colours::red : Colours::white);
+                g.fillRect(barX, levelToY(holdDb), barWidth, 2);
+            }
+        }
+
+        g.setColour(Colours::grey);
+        g.setFont(12.0f);
+        g.drawText(meter.name, (int) i * meterWidth, getHeight() - labelHeight, meterWidth, labelHeight, Justification::centred);
+    }
+
+    // 0 dBFS across every meter
+    g.setColour(Colours::darkgrey);
+    g.drawHorizontalLine(levelToY(0.0f), 0.0f, (float) getWidth());
+}
+
+void LevelMeters::resized()
+{
+    barArea = getLocalBounds().reduced(2, 4).withTrimmedBottom(labelHeight - 4);
+
+    auto meterWidth = meters.empty() ? 0 : getWidth() / (int) meters.size();
+    barWidth = jmax(2, (meterWidth - 4) / MeterTap::numChannels - 1);
+
+    if (barArea.isEmpty())
+        return;
+
+    // one bar's worth of colour, green through yellow to red at 0 dBFS
+    litBar = Image(Image::RGB, barWidth, barArea.getHeight(), false);
+    unlitBar = Image(Image::RGB, barWidth, barArea.getHeight(), false);
+
+    auto proportionAt = [](float db) { return (double) ((db - floorDb) / (topDb - floorDb)); };
+    ColourGradient gradient(Colours::green, 0.0f, (float) barArea.getHeight(), Colours::red, 0.0f, 0.0f, false);
+    gradient.addColour(proportionAt(-12.0f), Colours::yellow);
+    gradient.addColour(proportionAt(-3.0f), Colours::orange);
+    gradient.addColour(proportionAt(0.0f), Colours::red);
+
+    Graphics lit(litBar);
+    lit.setGradientFill(gradient);
+    lit.fillAll();
+
+    Graphics unlit(unlitBar);
+    unlit.setGradientFill(gradient);
+    unlit.fillAll();
+    unlit.fillAll(Colours::black.withAlpha(0.8f));
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    LevelMeters.h
+    Created: 23 Oct 2026 2:58:20pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MeterTap.h"
+
+//==============================================================================
+/*
+    Peak and RMS bars for each MeterTap, side by side.
+
+    This is the one reader of the taps it is given. Once per display frame it
+    pulls whatever the audio thread has pushed, measures it and repaints; the
+    decks themselves are never asked for anything. The lit and unlit bars are
+    drawn into images once per size, and each frame only copies slices of them.
+*/
+class LevelMeters : public Component
+{
+public:
+    LevelMeters();
+    ~LevelMeters();
+
+    /** message thread, before the first frame: add a meter reading this tap */
+    void addMeter(MeterTap& tap, const String& name);
+
+    /** the last meter's samples as they are read, for the spectrum */
+    std::function<void(const AudioBuffer<float>& samples, int numSamples, double sampleRate)> onSamplesRead;
+
+    void paint(Graphics&) override;
+    void resized() override;
+
+private:
+    struct Meter
+    {
+        MeterTap* tap = nullptr;
+        String name;
+        float peakDb[MeterTap::numChannels];
+        float rmsDb[MeterTap::numChannels];
+        float holdDb[MeterTap::numChannels];
+        double holdUntil[MeterTap::numChannels];
+        double lastSamplesTime = 0.0;
+    };
+
+    /** once per display frame: read the taps and move the bars */
+    void update();
+    void measure(Meter& meter, int numSamples, double now, double elapsed);
+    int levelToY(float db) const;
+
+    std::vector<Meter> meters;
+    AudioBuffer<float> samples;
+    double lastUpdateTime = 0.0;
+
+    Rectangle<int> barArea;
+    int barWidth = 0;
+    Image litBar, unlitBar;
+
+    VBlankAttachment vblank{ this, [this] { update(); } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeters)
+};
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    LibraryPreview.cpp
+    Created: 22 Oct 2026 5:40:27pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "LibraryPreview.h"
+
+namespace
+{
+    const int edgeFadeSamples = 256;
+}
+
+LibraryPreview::LibraryPreview()
+{
+}
+
+LibraryPreview::~LibraryPreview()
+{
+}
+
+void LibraryPreview::play(std::shared_ptr<const SnippetCache::TrackSnippets> snippets, double relativePosition)
+{
+    if (snippets == nullptr || snippets->snippets.empty())
+        return;
+
+    int offset = 0;
+    auto index = snippets->findNearest(relativePosition, offset);
+    resampler.setResamplingRatio(snippets->sampleRate / outputSampleRate);
+    file = snippets->file;
+
+    {
+        const SpinLock::ScopedLockType sl(lock);
+        std::swap(current, snippets);
+        snippetIndex = index;
+        snippetPosition = offset;
+        entryPosition = offset;
+        stopPending = false;
+        playing = true;
+    }
+
+    // the previous track's snippets are released here, outside the lock
+}
+
+void LibraryPreview::stop()
+{
+    if (playing.load())
+        stopPending = true;
+}
+
+//==============================================================================
+void LibraryPreview::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    outputSampleRate = sampleRate;
+    resampler.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void LibraryPreview::releaseResources()
+{
+    resampler.releaseResources();
+}
+
+void LibraryPreview::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    if (!playing.load())
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    auto fadeOut = stopPending.exchange(false);
+    resampler.getNextAudioBlock(bufferToFill);
+
+    if (fadeOut)
+    {
+        bufferToFill.buffer->applyGainRamp(bufferToFill.startSample, bufferToFill.numSamples, 1.0f, 0.0f);
+        playing = false;
+    }
+}
+
+void LibraryPreview::SnippetPlayer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    bufferToFill.clearActiveBufferRegion();
+
+    const SpinLock::ScopedTryLockType sl(preview.lock);
+
+    if (!sl.isLocked() || preview.current == nullptr)
+        return;
+
+    auto& track = *preview.current;
+    auto numChannels = jmin(2, bufferToFill.buffer->getNumChannels());
+
+    for (int i = 0; i < bufferToFill.numSamples && preview.snippetIndex < (int) track.snippets.size(); ++i)
+    {
+        auto& snippet = track.snippets[(size_t) preview.snippetIndex];
+        auto position = preview.snippetPosition;
+
+        // fade in from where playback came in, and out towards the end of the snippet
+        auto gain = jmin(1.0f, (float) (position - preview.entryPosition + 1) / edgeFadeSamples,
+                         (float) (snippet.length - position) / edgeFadeSamples);
+        auto* frame = track.samples.get() + 2 * (snippet.offset + (size_t) position);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            bufferToFill.buffer->setSample(channel, bufferToFill.startSample + i, gain * frame[channel] / 32767.0f);
+
+        if (++preview.snippetPosition >= snippet.length)
+        {
+            ++preview.snippetIndex;
+            preview.snippetPosition = 0;
+            preview.entryPosition = 0;
+        }
+    }
+
+    if (preview.snippetIndex >= (int) track.snippets.size())
+        preview.playing = false;
+
+    for (int channel = numChannels; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+        bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample, *bufferToFill.buffer, 0,
+                                      bufferToFill.startSample, bufferToFill.numSamples);
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    LibraryPreview.h
+    Created: 22 Oct 2026 5:40:27pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SnippetCache.h"
+
+//==============================================================================
+/*
+    Plays a library track's cached snippets into the headphone cue bus, so a
+    track can be checked without touching either deck.
+
+    Playback starts straight from memory at the snippet nearest the point
+    asked for, then skims on through the later snippets. Each snippet fades in
+    and out so the jumps between them don't click.
+
+    The snippets are swapped in under a lock the audio thread only ever tries,
+    and the old ones are released on the message thread.
+*/
+class LibraryPreview : public AudioSource
+{
+public:
+    LibraryPreview();
+    ~LibraryPreview() override;
+
+    /** message thread: play this track from near relativePosition */
+    void play(std::shared_ptr<const SnippetCache::TrackSnippets> snippets, double relativePosition);
+    /** message thread: fade out over the next block */
+    void stop();
+    /** false once stopped or past the last snippet */
+    bool isPlaying() const { return playing.load(); }
+    /** the track last played, playing or not */
+    File getFile() const { return file; }
+
+    //==============================================================================
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+private:
+    /** the snippets at their own sample rate, ahead of the resampler */
+    class SnippetPlayer : public AudioSource
+    {
+    public:
+        SnippetPlayer(LibraryPreview& owner) : preview(owner) {}
+
+        void prepareToPlay(int, double) override {}
+        void releaseResources() override {}
+        void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    private:
+        LibraryPreview& preview;
+    };
+
+    SnippetPlayer player{ *this };
+    ResamplingAudioSource resampler{ &player, false, 2 };
+
+    SpinLock lock;
+    std::shared_ptr<const SnippetCache::TrackSnippets> current;
+    int snippetIndex = 0;
+    int snippetPosition = 0;
+    int entryPosition = 0;   // where playback came into this snippet, to fade in from
+    std::atomic<bool> playing{ false };
+    std::atomic<bool> stopPending{ false };
+
+    File file;
+    double outputSampleRate = 44100.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryPreview)
+};
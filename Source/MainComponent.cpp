@@ -1,104 +1,559 @@
-/*
-  ==============================================================================
-
-    This file was auto-generated!
-
-  ==============================================================================
-*/
-
-#include "MainComponent.h"
-#include "MusicLibrary.h"
-using namespace std;
-//==============================================================================
-MainComponent::MainComponent()
-{
-    DBG(".....................Main component constructor dbg running......................");
-    // Register audio formats BEFORE they are used
-    formatManager.registerBasicFormats();
-    DBG("Number of registered formats: " + String(formatManager.getNumKnownFormats()));
-
-    // Request permissions for audio input (if needed)
-    if (RuntimePermissions::isRequired(RuntimePermissions::recordAudio)
-        && !RuntimePermissions::isGranted(RuntimePermissions::recordAudio))
-    {
-        RuntimePermissions::request(RuntimePermissions::recordAudio,
-            [this](bool granted) { if (granted) setAudioChannels(2, 2); });
-    }
-    else
-    {
-        setAudioChannels(0, 2); // No input, only output
-    }
-
-    // Ensure UI components are added and visible
-    addAndMakeVisible(deckGUI1);
-    addAndMakeVisible(deckGUI2);
-    addAndMakeVisible(musicLibrary);
-
-    // Set the callback for when a track is selected in MusicLibrary
-    musicLibrary.onTrackSelected = [this](const File& file)
-    {
-            deckGUI1.loadTrack(file); // Load track into deckGUI1
-    };
-
-    setSize(1000, 600); // Set window size
-}
-
-
-MainComponent::~MainComponent()
-{
-    // This shuts down the audio device and clears the audio source.
-    shutdownAudio();
-}
-
-//==============================================================================
-void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
-{
-    player1.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    player2.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    
-    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-
-    
- }
-void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
-{
-    mixerSource.getNextAudioBlock(bufferToFill);
-}
-
-void MainComponent::releaseResources()
-{
-    // This will be called when the audio device stops, or when it is being
-    // restarted due to a setting change.
-
-    // For more details, see the help for AudioProcessor::releaseResources()
-    player1.releaseResources();
-    player2.releaseResources();
-    mixerSource.releaseResources();
-}
-
-//==============================================================================
-void MainComponent::paint (Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
-
-    // You can add your drawing code here!
-}
-
-void MainComponent::resized()
-{
-    int deckHeight = getHeight() * 0.5; // DeckGUI takes 60% of the height
-    int libraryHeight = getHeight() * 0.5; // Music library takes 40% of the height
-
-    // Arrange DeckGUI components at the top
-    deckGUI1.setBounds(0, 0, getWidth() / 2, deckHeight);
-    deckGUI2.setBounds(getWidth() / 2, 0, getWidth() / 2, deckHeight);
-
-    // Place Music Library at the bottom
-    musicLibrary.setBounds(0, deckHeight, getWidth(), libraryHeight);
-}
-
-
+/*
+  ==============================================================================
+
+    This file was auto-generated!
+
+  ==============================================================================
+*/
+
+#include "MainComponent.h"
+#include "MusicLibrary.h"
+using namespace std;
+//==============================================================================
+MainComponent::MainComponent()
+{
+    DBG(".....................Main component constructor dbg running......................");
+    // Register audio formats BEFORE they are used
+    formatManager.registerBasicFormats();
+    DBG("Number of registered formats: " + String(formatManager.getNumKnownFormats()));
+
+    // Both decks share one tempo clock, deck 1 leads until another deck is made master
+    player1.setMasterClock(&masterClock);
+    player2.setMasterClock(&masterClock);
+    player1.makeMaster();
+
+    // Automation - Every control change is reported to it, it only keeps them while recording
+    player1.setAutomation(&automation, 0);
+    player2.setAutomation(&automation, 1);
+    mixerSource.setAutomation(&automation);
+
+    // Deck 1 sits on the left of the crossfader, deck 2 on the right
+    mixerSource.addDeck(&player1, DJMixer::CrossfaderSide::left);
+    mixerSource.addDeck(&player2, DJMixer::CrossfaderSide::right);
+
+    // Sampler pads - Summed with the decks, untouched by the crossfader
+    mixerSource.addDeck(&sampler, DJMixer::CrossfaderSide::thru);
+
+    // Library preview - Heard in the headphones only
+    mixerSource.setCueOnlySource(&libraryPreview);
+
+    // Request permissions for audio input (if needed)
+    if (RuntimePermissions::isRequired(RuntimePermissions::recordAudio)
+        && !RuntimePermissions::isGranted(RuntimePermissions::recordAudio))
+    {
+        RuntimePermissions::request(RuntimePermissions::recordAudio,
+            [this](bool granted) { if (granted) setAudioChannels(2, 4); });
+    }
+    else
+    {
+        setAudioChannels(0, 4); // No input; outputs 1-2 master, 3-4 headphone cue
+    }
+
+    // MIDI controllers - Every input is opened and mapped straight onto the decks
+    midiController.attach(deviceManager);
+
+    // Ensure UI components are added and visible
+    addAndMakeVisible(deckGUI1);
+    addAndMakeVisible(deckGUI2);
+    addAndMakeVisible(samplerPanel);
+    addAndMakeVisible(mixerPanel);
+
+    // Meters - Each deck after its EQ, then the master; the spectrum follows the master
+    levelMeters.addMeter(mixerSource.getDeckTap(0), "A");
+    levelMeters.addMeter(mixerSource.getDeckTap(1), "B");
+    levelMeters.addMeter(mixerSource.getMasterTap(), "M");
+    levelMeters.onSamplesRead = [this](const AudioBuffer<float>& samples, int numSamples, double sampleRate)
+    {
+            spectrumView.pushSamples(samples, numSamples, sampleRate);
+    };
+    addAndMakeVisible(levelMeters);
+    addChildComponent(spectrumView);
+    addAndMakeVisible(musicLibrary);
+    addAndMakeVisible(recommendationPanel);
+
+    // Session recording - Status bar along the bottom
+    recordButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    recordButton.setColour(TextButton::buttonOnColourId, Colours::red);
+    recordButton.onClick = [this] { toggleRecording(); };
+    addAndMakeVisible(recordButton);
+
+    recordFormatBox.addItem("WAV", 1);
+    recordFormatBox.addItem("FLAC", 2);
+    recordFormatBox.setSelectedId(1, dontSendNotification);
+    addAndMakeVisible(recordFormatBox);
+
+    recordStatus.setColour(Label::textColourId, Colours::white);
+    addAndMakeVisible(recordStatus);
+
+    replayButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    replayButton.setColour(TextButton::buttonOnColourId, Colours::orange.darker());
+    replayButton.onClick = [this] { toggleReplay(); };
+    addAndMakeVisible(replayButton);
+
+    automation.onDeckLoaded = [this](int deck)
+    {
+        (deck == 0 ? deckGUI1 : deckGUI2).showLoadedTrack();
+    };
+
+    // Auto DJ - Queue from the library, the scheduler cues the idle deck
+    autoDJButton.setClickingTogglesState(true);
+    autoDJButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    autoDJButton.setColour(TextButton::buttonOnColourId, Colours::green);
+    autoDJButton.onClick = [this] { autoDJ.setEnabled(autoDJButton.getToggleState()); timerCallback(); };
+    addAndMakeVisible(autoDJButton);
+
+    autoDJStatus.setColour(Label::textColourId, Colours::white);
+    autoDJStatus.setJustificationType(Justification::centredRight);
+    addAndMakeVisible(autoDJStatus);
+
+    spectrumButton.setClickingTogglesState(true);
+    spectrumButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    spectrumButton.setColour(TextButton::buttonOnColourId, Colours::cyan.darker());
+    spectrumButton.onClick = [this] { spectrumView.setVisible(spectrumButton.getToggleState()); resized(); };
+    addAndMakeVisible(spectrumButton);
+
+    // Stats - Audio load and the memory budget, over the corner of the library
+    statsButton.setClickingTogglesState(true);
+    statsButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    statsButton.setColour(TextButton::buttonOnColourId, Colours::cyan.darker());
+    statsButton.onClick = [this] { statsOverlay.setVisible(statsButton.getToggleState()); resized(); };
+    addAndMakeVisible(statsButton);
+    addChildComponent(statsOverlay);
+
+    autoDJ.onLoadDeck = [this](int deck, const File& file)
+    {
+        (deck == 0 ? deckGUI1 : deckGUI2).loadTrack(file, false); // Cue without starting
+    };
+
+    startTimer(250);
+    setWantsKeyboardFocus(true); // For the trace shortcut when nothing else has focus
+
+    // Set the callback for when a track is selected in MusicLibrary
+    musicLibrary.onTrackSelected = [this](const File& file)
+    {
+            loadIntoIdleDeck(file); // Load track into whichever deck is free
+    };
+
+    musicLibrary.onTrackPreviewed = [this](const File& file, double position)
+    {
+            previewTrack(file, position);
+    };
+
+    snippetCache.onTrackCached = [this](const File& file)
+    {
+            if (file == pendingPreview)
+                previewTrack(file, pendingPreviewPosition);
+    };
+
+    musicLibrary.onTrackQueued = [this](const File& file)
+    {
+            autoDJ.addToQueue(file);
+            timerCallback();
+    };
+
+    // Recommendations and duplicates - Analyse and fingerprint new library tracks in the background
+    musicLibrary.onLibraryChanged = [this]
+    {
+            recommender.analyseMissing(musicLibrary.getTracks());
+            duplicateFinder.fingerprintMissing(musicLibrary.getTracks());
+            musicLibrary.setDuplicates(duplicateFinder.findDuplicatesIn(musicLibrary.getTracks()));
+    };
+
+    recommendationPanel.onTrackSelected = [this](const File& file)
+    {
+            loadIntoIdleDeck(file);
+    };
+
+    musicLibrary.onLibraryChanged(); // Catch up on tracks saved before their analysis finished
+
+    // Carry on from the last session - The decks are prepared by now, so they buffer straight away
+    resumeSession();
+
+    setSize(1200, 900); // Set window size, tall enough for the deck controls
+}
+
+
+MainComponent::~MainComponent()
+{
+    // This shuts down the audio device and clears the audio source.
+    stopTimer();
+    saveSession(); // Written out as the snapshot writer stops
+    midiController.detach();
+    shutdownAudio();
+    recorder.stop();
+
+    if (automation.isRecording())
+    {
+        automation.stopRecording();
+        automation.save(recorder.getFile().withFileExtension(Automation::getFileExtension()));
+    }
+
+    // The decks and mixer outlive the automation
+    player1.setAutomation(nullptr, 0);
+    player2.setAutomation(nullptr, 1);
+    mixerSource.setAutomation(nullptr);
+}
+
+//==============================================================================
+void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    masterClock.prepareToPlay(sampleRate);
+    recorder.prepareToPlay(sampleRate);
+    autoDJ.prepareToPlay(sampleRate);
+    midiController.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    // The mixer prepares the decks it was given
+    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    outputSampleRate = sampleRate;
+    updateOutputLatency();
+
+    
+ }
+void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
+{
+    midiController.beginBlock(bufferToFill.numSamples);
+
+    // Render up to each MIDI, Auto DJ and automation event so they land on their own sample
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        auto numThisTime = midiController.applyEvents(done, bufferToFill.numSamples - done);
+        numThisTime = autoDJ.getNextSegment(numThisTime);
+        numThisTime = automation.applyEvents(numThisTime);
+        AudioSourceChannelInfo segment(bufferToFill.buffer, bufferToFill.startSample + done, numThisTime);
+
+        masterClock.beginBlock(numThisTime);
+        mixerSource.getNextAudioBlock(segment);
+        masterClock.endBlock(numThisTime);
+
+        done += numThisTime;
+    }
+
+    // Capture exactly what goes to the speakers
+    recorder.process(bufferToFill);
+}
+
+void MainComponent::releaseResources()
+{
+    // This will be called when the audio device stops, or when it is being
+    // restarted due to a setting change.
+
+    // For more details, see the help for AudioProcessor::releaseResources()
+    mixerSource.releaseResources();
+}
+
+//==============================================================================
+void MainComponent::paint (Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
+
+    // You can add your drawing code here!
+}
+
+void MainComponent::resized()
+{
+    int deckHeight = getHeight() * 0.5; // DeckGUI takes 50% of the height
+    int mixerHeight = 80; // Mixer strip sits between decks and library
+    int statusHeight = 28; // Recorder status bar along the bottom
+    int libraryHeight = getHeight() - deckHeight - mixerHeight - statusHeight; // Music library takes the rest
+
+    // Arrange DeckGUI components at the top, the sampler pads to their right
+    int samplerWidth = 260;
+    int deckWidth = (getWidth() - samplerWidth) / 2;
+    deckGUI1.setBounds(0, 0, deckWidth, deckHeight);
+    deckGUI2.setBounds(deckWidth, 0, deckWidth, deckHeight);
+    samplerPanel.setBounds(deckWidth * 2, 0, getWidth() - deckWidth * 2, deckHeight);
+
+    // Crossfader and EQs below the decks, the meters beside them
+    int metersWidth = 90;
+    mixerPanel.setBounds(0, deckHeight, getWidth() - metersWidth, mixerHeight);
+    levelMeters.setBounds(getWidth() - metersWidth, deckHeight, metersWidth, mixerHeight);
+
+    // Place Music Library at the bottom, recommendations beside it
+    int libraryWidth = getWidth() * 0.65;
+    musicLibrary.setBounds(0, deckHeight + mixerHeight, libraryWidth, libraryHeight);
+    auto sideArea = Rectangle<int>(libraryWidth, deckHeight + mixerHeight, getWidth() - libraryWidth, libraryHeight);
+
+    if (spectrumView.isVisible())
+        spectrumView.setBounds(sideArea.removeFromBottom(jmin(160, sideArea.getHeight() / 2)));
+
+    recommendationPanel.setBounds(sideArea);
+
+    // Status bar - Record button, format and status text
+    auto statusArea = Rectangle<int>(0, getHeight() - statusHeight, getWidth(), statusHeight).reduced(2);
+    recordButton.setBounds(statusArea.removeFromLeft(60));
+    recordFormatBox.setBounds(statusArea.removeFromLeft(80).reduced(2, 0));
+    replayButton.setBounds(statusArea.removeFromLeft(70));
+    autoDJButton.setBounds(statusArea.removeFromRight(80));
+    spectrumButton.setBounds(statusArea.removeFromRight(80).reduced(2, 0));
+    statsButton.setBounds(statusArea.removeFromRight(60));
+    autoDJStatus.setBounds(statusArea.removeFromRight(statusArea.getWidth() / 2));
+    recordStatus.setBounds(statusArea);
+
+    // Stats overlay - Bottom right, just above the status bar
+    if (statsOverlay.isVisible())
+        statsOverlay.setBounds(Rectangle<int>(getWidth() - 380 - 8, getHeight() - statusHeight - statsOverlay.getIdealHeight() - 8,
+                                              380, statsOverlay.getIdealHeight()));
+}
+
+bool MainComponent::keyPressed(const KeyPress& key)
+{
+    if (key == KeyPress('t', ModifierKeys::commandModifier | ModifierKeys::shiftModifier, 0))
+    {
+        if (Tracer::isEnabled())
+            Tracer::stopAndWrite(Tracer::getDefaultFile());
+        else
+            Tracer::start();
+
+        return true;
+    }
+
+    if (key == KeyPress::escapeKey && libraryPreview.isPlaying())
+    {
+        libraryPreview.stop();
+        return true;
+    }
+
+    return false;
+}
+
+void MainComponent::toggleRecording()
+{
+    if (recorder.isRecording())
+    {
+        recorder.stop();
+        DBG("Recording saved to " + recorder.getFile().getFullPathName());
+
+        // The moves go next to the audio, so the set can be rendered again from them
+        if (automation.isRecording())
+        {
+            automation.stopRecording();
+            automation.save(recorder.getFile().withFileExtension(Automation::getFileExtension()));
+        }
+    }
+    else
+    {
+        auto format = recordFormatBox.getSelectedId() == 2 ? SessionRecorder::Format::flac
+                                                           : SessionRecorder::Format::wav;
+        recorder.start(SessionRecorder::getDefaultFile(format), format);
+
+        // Not while replaying - Then only the audio of the replay is recorded
+        if (recorder.isRecording())
+            automation.startRecording();
+    }
+
+    recordButton.setToggleState(recorder.isRecording(), dontSendNotification);
+    timerCallback();
+}
+
+void MainComponent::toggleReplay()
+{
+    if (automation.isPlayingBack())
+    {
+        automation.stopPlayback();
+        replayButton.setToggleState(false, dontSendNotification);
+        timerCallback();
+        return;
+    }
+
+    automationChooser = std::make_unique<FileChooser>("Replay automation", recorder.getFile().getParentDirectory(),
+                                                      "*" + Automation::getFileExtension());
+    automationChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles,
+        [this](const FileChooser& chooser)
+        {
+            auto file = chooser.getResult();
+
+            if (!file.existsAsFile())
+                return;
+
+            if (!automation.load(file) || !automation.startPlayback())
+            {
+                DBG("MainComponent - Couldn't replay " + file.getFullPathName());
+                return;
+            }
+
+            replayFile = file;
+            replayButton.setToggleState(true, dontSendNotification);
+            timerCallback();
+        });
+}
+
+void MainComponent::loadIntoIdleDeck(const File& file)
+{
+    if (player1.isPlaying() && !player2.isPlaying())
+        deckGUI2.loadTrack(file, false);
+    else if (player2.isPlaying() && !player1.isPlaying())
+        deckGUI1.loadTrack(file, false);
+    else if (!player1.isPlaying())
+        deckGUI1.loadTrack(file); // Nothing playing yet, start straight away
+    else
+        DBG("Both decks are playing, stop one before loading " + file.getFileName());
+}
+
+void MainComponent::previewTrack(const File& file, double position)
+{
+    if (!mixerSource.isCueBusRouted())
+        DBG("No headphone outputs, the preview of " + file.getFileName() + " won't be heard");
+
+    if (auto snippets = snippetCache.find(file))
+    {
+        pendingPreview = File();
+        libraryPreview.play(snippets, position);
+        musicLibrary.setPreviewTrack(file);
+        return;
+    }
+
+    // Not decoded yet - It jumps the queue and plays when it arrives
+    pendingPreview = file;
+    pendingPreviewPosition = position;
+    snippetCache.request(file);
+}
+
+void MainComponent::saveSession()
+{
+    SessionSnapshot::State state;
+    state.decks.push_back(SessionSnapshot::capture(player1));
+    state.decks.push_back(SessionSnapshot::capture(player2));
+    state.crossfader = mixerSource.getCrossfader();
+    state.autoDJQueue = autoDJ.getQueue();
+
+    sessionSnapshot.save(state);
+}
+
+void MainComponent::resumeSession()
+{
+    TRACE_SPAN("MainComponent::resumeSession");
+
+    SessionSnapshot::State state;
+
+    if (!sessionSnapshot.load(state))
+        return;
+
+    DJAudioPlayer* players[] = { &player1, &player2 };
+    DeckGUI* decks[] = { &deckGUI1, &deckGUI2 };
+
+    for (size_t i = 0; i < state.decks.size() && i < 2; ++i)
+    {
+        if (SessionSnapshot::restore(*players[i], state.decks[i]))
+        {
+            decks[i]->showLoadedTrack();
+            resumingDecks.add(players[i]);
+        }
+    }
+
+    mixerSource.setCrossfader(state.crossfader);
+
+    for (auto& file : state.autoDJQueue)
+        if (file.existsAsFile())
+            autoDJ.addToQueue(file);
+}
+
+void MainComponent::checkResumedDecks()
+{
+    auto seconds = (Time::getMillisecondCounterHiRes() - launchTime) / 1000.0;
+
+    // Ready once the next second of every resumed deck is decoded
+    auto ready = std::all_of(resumingDecks.begin(), resumingDecks.end(), [](DJAudioPlayer* player)
+    {
+        return player->waitUntilBuffered(1.0, 0);
+    });
+
+    if (!ready && seconds < 10.0)
+        return;
+
+    resumeStatus = ready ? "Resumed the last session, ready in " + String(seconds, 1) + " s"
+                         : "Resumed the last session, still buffering";
+    DBG("MainComponent - " + resumeStatus);
+    resumingDecks.clear();
+}
+
+void MainComponent::updateOutputLatency()
+{
+    // The limiter's delay, plus the device's own buffering when it reports it
+    auto latencySamples = mixerSource.getLatencySamples();
+
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+        latencySamples += device->getOutputLatencyInSamples();
+
+    auto seconds = latencySamples / outputSampleRate;
+    player1.setOutputLatency(seconds);
+    player2.setOutputLatency(seconds);
+}
+
+void MainComponent::updateRecommendations()
+{
+    // the playing deck; with both playing, the one the crossfader favours
+    DJAudioPlayer* active = nullptr;
+
+    if (player1.isPlaying() && player2.isPlaying())
+        active = mixerSource.getCrossfader() < 0.5f ? &player1 : &player2;
+    else if (player1.isPlaying())
+        active = &player1;
+    else if (player2.isPlaying())
+        active = &player2;
+    else if (player1.isLoaded())
+        active = &player1;
+    else if (player2.isLoaded())
+        active = &player2;
+
+    if (active != nullptr)
+        recommendationPanel.setReference(active->getLoadedFile(), active->getAnalysis());
+}
+
+void MainComponent::timerCallback()
+{
+    autoDJStatus.setText(autoDJ.getStatusText(), dontSendNotification);
+    mixerPanel.refreshCrossfader();
+    mixerPanel.refreshLimiter();
+    updateOutputLatency(); // The limiter's look-ahead may have changed
+    updateRecommendations();
+
+    // Cheap to capture - The snapshot writer decides when it's worth writing out
+    saveSession();
+
+    if (!resumingDecks.isEmpty())
+        checkResumedDecks();
+
+    // Memory budget - Caches that grew since the last tick give back what they can, cheapest first
+    MemoryBudget::getInstance().enforce();
+
+    // Snippets for the rows on screen and a screenful either side, the rest is cancelled
+    snippetCache.setWanted(musicLibrary.getTracksAroundView(20));
+    musicLibrary.setPreviewTrack(libraryPreview.isPlaying() ? libraryPreview.getFile() : File());
+
+    if (duplicateFinder.collectResults())
+        musicLibrary.setDuplicates(duplicateFinder.findDuplicatesIn(musicLibrary.getTracks()));
+
+    // Replay - The button lets go once the last event has played
+    if (replayButton.getToggleState() && !automation.isPlayingBack())
+        replayButton.setToggleState(false, dontSendNotification);
+
+    if (!recorder.isRecording() && automation.isPlayingBack())
+    {
+        recordStatus.setText("Replaying " + replayFile.getFileName(), dontSendNotification);
+        return;
+    }
+
+    if (!recorder.isRecording())
+    {
+        recordStatus.setText(recorder.getFile() == File() ? (resumeStatus.isNotEmpty() ? resumeStatus : "Not recording")
+                                                          : "Saved " + recorder.getFile().getFileName(),
+                             dontSendNotification);
+        return;
+    }
+
+    auto seconds = (int) recorder.getRecordedSeconds();
+    auto text = "Recording " + recorder.getFile().getFileName()
+              + "  " + String(seconds / 60) + ":" + String(seconds % 60).paddedLeft('0', 2);
+
+    if (recorder.getNumDroppedBlocks() > 0)
+        text << "  (" << recorder.getNumDroppedBlocks() << " blocks dropped)";
+
+    if (automation.getNumDropped() > 0)
+        text << "  (" << automation.getNumDropped() << " control changes dropped)";
+
+    recordStatus.setText(text, dontSendNotification);
+}
+
+
@@ -1,58 +1,148 @@
-/*
-  ==============================================================================
-
-    This file was auto-generated!
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include "../JuceLibraryCode/JuceHeader.h"
-#include "DJAudioPlayer.h"
-#include "DeckGUI.h"
-#include "MusicLibrary.h"
-
-
-//==============================================================================
-/*
-    This component lives inside our window, and this is where you should put all
-    your controls and content.
-*/
-class MainComponent   : public AudioAppComponent
-{
-public:
-    //==============================================================================
-    MainComponent();
-    ~MainComponent();
-
-    //==============================================================================
-    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-
-    //==============================================================================
-    void paint (Graphics& g) override;
-    void resized() override;
-
-private:
-    //==============================================================================
-    // Your private member variables go here...
-
-    AudioFormatManager formatManager;
-
-    MusicLibrary musicLibrary;
-    
-    AudioThumbnailCache thumbCache{100}; 
-
-    DJAudioPlayer player1{formatManager};
-    DeckGUI deckGUI1{1,&player1, formatManager, thumbCache}; 
-
-    DJAudioPlayer player2{formatManager};
-    DeckGUI deckGUI2{2,&player2, formatManager, thumbCache}; 
-
-    MixerAudioSource mixerSource; 
-    
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
-};
+/*
+  ==============================================================================
+
+    This file was auto-generated!
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+#include "DeckGUI.h"
+#include "MusicLibrary.h"
+#include "MasterClock.h"
+#include "DJMixer.h"
+#include "MixerPanel.h"
+#include "LevelMeters.h"
+#include "SpectrumView.h"
+#include "StatsOverlay.h"
+#include "SamplerPanel.h"
+#include "MemoryBudget.h"
+#include "SessionRecorder.h"
+#include "AutoDJ.h"
+#include "Automation.h"
+#include "MidiController.h"
+#include "Recommender.h"
+#include "RecommendationPanel.h"
+#include "DuplicateFinder.h"
+#include "SnippetCache.h"
+#include "LibraryPreview.h"
+#include "SessionSnapshot.h"
+#include "WaveformCache.h"
+#include "Tracer.h"
+
+
+//==============================================================================
+/*
+    This component lives inside our window, and this is where you should put all
+    your controls and content.
+*/
+class MainComponent   : public AudioAppComponent,
+                        public Timer
+{
+public:
+    //==============================================================================
+    MainComponent();
+    ~MainComponent();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+
+    //==============================================================================
+    void paint (Graphics& g) override;
+    void resized() override;
+
+    /** refresh the recorder and Auto DJ status, the recommendations and duplicate flags */
+    void timerCallback() override;
+
+    /** Ctrl+Shift+T starts a trace, and again writes it out; Escape stops the preview */
+    bool keyPressed(const KeyPress& key) override;
+
+private:
+    //==============================================================================
+    // Your private member variables go here...
+
+    double launchTime = Time::getMillisecondCounterHiRes(); // First, so resuming is timed from here
+
+    AudioFormatManager formatManager;
+
+    MusicLibrary musicLibrary;
+    
+    WaveformCache thumbCache{100}; // Kept on disk too, so waveforms are back at once after a restart
+
+    MasterClock masterClock;
+
+    DJAudioPlayer player1{formatManager};
+    DeckGUI deckGUI1{1,&player1, formatManager, thumbCache}; 
+
+    DJAudioPlayer player2{formatManager};
+    DeckGUI deckGUI2{2,&player2, formatManager, thumbCache}; 
+
+    DJMixer mixerSource; 
+    MixerPanel mixerPanel{mixerSource};
+
+    SamplerBank sampler{formatManager, masterClock};
+    SamplerPanel samplerPanel{sampler};
+
+    LevelMeters levelMeters;
+    SpectrumView spectrumView;
+    TextButton spectrumButton{"SPECTRUM"};
+    StatsOverlay statsOverlay{mixerSource};
+    TextButton statsButton{"STATS"};
+
+    SessionRecorder recorder;
+    TextButton recordButton{"REC"};
+    ComboBox recordFormatBox;
+    Label recordStatus;
+
+    AutoDJ autoDJ{player1, player2, mixerSource};
+    TextButton autoDJButton{"AUTO DJ"};
+    Label autoDJStatus;
+
+    Automation automation{player1, player2, mixerSource, masterClock};
+    TextButton replayButton{"REPLAY"};
+    std::unique_ptr<FileChooser> automationChooser;
+    File replayFile;
+
+    MidiController midiController{player1, player2, mixerSource};
+
+    Recommender recommender;
+    RecommendationPanel recommendationPanel{recommender};
+
+    DuplicateFinder duplicateFinder;
+
+    SnippetCache snippetCache{formatManager};
+    LibraryPreview libraryPreview;
+    File pendingPreview; // Clicked before its snippets were ready
+    double pendingPreviewPosition = 0.0;
+
+    SessionSnapshot sessionSnapshot;
+    Array<DJAudioPlayer*> resumingDecks; // Restored, still filling their read-ahead
+    String resumeStatus;
+
+    void toggleRecording();
+    /** pick an automation file and play it back through the decks, or stop playing one */
+    void toggleReplay();
+    /** load into a deck that isn't playing, so a live deck is never cut off */
+    void loadIntoIdleDeck(const File& file);
+    /** point the recommendations at the deck the audience is hearing */
+    void updateRecommendations();
+    /** play a library track in the headphones, as soon as its snippets are decoded */
+    void previewTrack(const File& file, double position);
+    /** hand the decks, crossfader and Auto DJ queue to the snapshot writer */
+    void saveSession();
+    /** put the decks back as the last snapshot left them, cued and buffering */
+    void resumeSession();
+    /** note how long after launch the resumed decks were ready to play */
+    void checkResumedDecks();
+    /** tell the decks how far behind their playheads the speakers are */
+    void updateOutputLatency();
+    double outputSampleRate = 44100.0;
+    
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    MasterClock.cpp
+    Created: 19 Oct 2026 1:40:02pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MasterClock.h"
+#include "DJAudioPlayer.h"
+
+namespace
+{
+    // fraction of the master deck's phase error taken up per block
+    const double phaseFollowRate = 0.25;
+}
+
+MasterClock::MasterClock()
+{
+}
+
+void MasterClock::prepareToPlay(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    samplePosition = 0;
+}
+
+void MasterClock::beginBlock(int numSamples)
+{
+    ignoreUnused(numSamples);
+
+    auto* deck = master.load();
+
+    if (deck == nullptr || !deck->isPlaying() || !deck->hasBeatGrid())
+        return;
+
+    tempo = deck->getEffectiveBpm();
+
+    auto error = wrapPhase(deck->getBeatPosition() - beatPosition.load());
+    beatPosition = beatPosition.load() + error * phaseFollowRate;
+}
+
+void MasterClock::endBlock(int numSamples)
+{
+    beatPosition = beatPosition.load() + numSamples * tempo.load() / (60.0 * sampleRate);
+    samplePosition += numSamples;
+}
+
+void MasterClock::setMaster(DJAudioPlayer* deck)
+{
+    master = deck;
+}
+
+double MasterClock::wrapPhase(double beats)
+{
+    return beats - std::floor(beats + 0.5);
+}
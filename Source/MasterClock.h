@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    MasterClock.h
+    Created: 19 Oct 2026 1:40:02pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+class DJAudioPlayer;
+
+//==============================================================================
+/*
+    Sample-counting tempo clock shared by every deck.
+
+    MainComponent calls beginBlock() before the decks render and endBlock()
+    after, both on the audio thread. While the master deck is playing with a
+    beat grid the clock takes its tempo and is pulled onto its phase;
+    otherwise it free-runs at the last tempo. Synced decks read the clock's
+    tempo and beat position at the start of each block and correct themselves
+    towards it, so switching the master mid-song leaves the phase untouched.
+*/
+class MasterClock
+{
+public:
+    MasterClock();
+
+    void prepareToPlay(double sampleRate);
+
+    void beginBlock(int numSamples);
+    void endBlock(int numSamples);
+
+    void setMaster(DJAudioPlayer* deck);
+    DJAudioPlayer* getMaster() const { return master.load(); }
+
+    /** tempo in beats per minute */
+    double getTempo() const { return tempo.load(); }
+    /** beats elapsed at the start of the current block */
+    double getBeatPosition() const { return beatPosition.load(); }
+    /** output samples rendered since the audio device started */
+    int64 getSamplePosition() const { return samplePosition.load(); }
+    double getSampleRate() const { return sampleRate; }
+
+    /** fold a beat difference into [-0.5, 0.5) */
+    static double wrapPhase(double beats);
+
+private:
+    std::atomic<DJAudioPlayer*> master{ nullptr };
+
+    double sampleRate = 44100.0;
+    std::atomic<double> tempo{ 120.0 };
+    std::atomic<double> beatPosition{ 0.0 };
+    std::atomic<int64> samplePosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterClock)
+};
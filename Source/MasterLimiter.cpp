@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    MasterLimiter.cpp
+    Created: 23 Oct 2026 10:21:44am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MasterLimiter.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const float defaultCeilingDb = -1.0f;
+    const double releaseMs = 120.0;
+}
+
+MasterLimiter::MasterLimiter()
+{
+    // a Blackman windowed sinc at 4x, split into one short filter per phase
+    const int length = numPhases * tapsPerPhase;
+    const double centre = (length - 1) / 2.0;
+
+    for (int phase = 0; phase < numPhases; ++phase)
+    {
+        auto sum = 0.0;
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+        {
+            auto n = tap * numPhases + phase;
+            auto x = (n - centre) / numPhases;
+            auto sinc = x == 0.0 ? 1.0 : std::sin(MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+            auto window = 0.42 - 0.5 * std::cos(MathConstants<double>::twoPi * (n + 0.5) / length)
+                        + 0.08 * std::cos(2.0 * MathConstants<double>::twoPi * (n + 0.5) / length);
+
+            coefficients[phase][tap] = (float) (sinc * window);
+            sum += sinc * window;
+        }
+
+        // each phase passes DC at unity, so a steady level reads as itself
+        for (auto& coefficient : coefficients[phase])
+            coefficient = (float) (coefficient / sum);
+    }
+
+    setCeilingDb(defaultCeilingDb);
+}
+
+void MasterLimiter::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+    blockSize = jmax(1, maximumBlockSize);
+
+    auto maxLookAhead = (int) std::ceil(maxLookAheadMs * 0.001 * sampleRate);
+
+    detectorHistory.setSize(2, tapsPerPhase - 1 + blockSize);
+    detectorHistory.clear();
+    peaks.allocate((size_t) blockSize, true);
+    phaseOutput.allocate((size_t) blockSize, true);
+    gains.allocate((size_t) blockSize, true);
+
+    // the longest hold, which is also the most the queue keeps
+    holdCapacity = maxLookAhead + 2;
+    holdValues.allocate((size_t) holdCapacity, true);
+    holdIndices.allocate((size_t) holdCapacity, true);
+    boxValues.allocate((size_t) maxLookAhead + 1, true);
+
+    delayLine.setSize(4, maxLookAhead + detectorDelay + blockSize);
+    delayLine.clear();
+    delayWritePosition = 0;
+
+    releaseCoefficient = (float) (1.0 - std::exp(-1.0 / (releaseMs * 0.001 * sampleRate)));
+    sampleCount = 0;
+
+    // the latency is known as soon as the device is set up, before the first block
+    resetEnvelope(jlimit(0, maxLookAhead, roundToInt(lookAheadMs.load() * 0.001 * sampleRate)));
+}
+
+void MasterLimiter::setCeilingDb(float ceilingDb)
+{
+    ceiling = Decibels::decibelsToGain(jmin(0.0f, ceilingDb));
+}
+
+void MasterLimiter::setLookAheadMs(float newLookAheadMs)
+{
+    lookAheadMs = jlimit(0.0f, maxLookAheadMs, newLookAheadMs);
+
+    // reported now, so whatever compensates for it doesn't wait for the next block
+    latency = roundToInt(lookAheadMs.load() * 0.001 * sampleRate) + detectorDelay;
+}
+
+void MasterLimiter::resetEnvelope(int lookAheadSamples)
+{
+    lookAhead = lookAheadSamples;
+    latency = lookAhead + detectorDelay;
+
+    holdStart = 0;
+    holdCount = 0;
+    envelope = 1.0f;
+
+    for (int i = 0; i <= lookAhead; ++i)
+        boxValues[i] = 1.0f;
+
+    boxPosition = 0;
+    boxSum = lookAhead + 1;
+}
+
+//==============================================================================
+void MasterLimiter::process(AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (blockSize == 0)
+        return;
+
+    auto deepest = 1.0f;
+
+    for (int done = 0; done < numSamples;)
+    {
+        auto numThisTime = jmin(blockSize, numSamples - done);
+        processChunk(buffer, startSample + done, numThisTime);
+        deepest = jmin(deepest, FloatVectorOperations::findMinimum(gains.get(), numThisTime));
+        done += numThisTime;
+    }
+
+    gainReductionDb = Decibels::gainToDecibels(deepest);
+}
+
+void MasterLimiter::findTruePeaks(const float* input, float* history, int numSamples)
+{
+    // the last few inputs of the previous chunk sit in front of this one
+    auto* current = history + tapsPerPhase - 1;
+    FloatVectorOperations::copy(current, input, numSamples);
+
+    for (int phase = 0; phase < numPhases; ++phase)
+    {
+        FloatVectorOperations::clear(phaseOutput, numSamples);
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+            FloatVectorOperations::addWithMultiply(phaseOutput, current - tap, coefficients[phase][tap], numSamples);
+
+        FloatVectorOperations::abs(phaseOutput, phaseOutput, numSamples);
+        FloatVectorOperations::max(peaks, peaks, phaseOutput, numSamples);
+    }
+
+    // and the samples themselves, lined up with the interpolated ones
+    FloatVectorOperations::abs(phaseOutput, current - detectorDelay, numSamples);
+    FloatVectorOperations::max(peaks, peaks, phaseOutput, numSamples);
+
+    memmove(history, history + numSamples, sizeof(float) * (size_t) (tapsPerPhase - 1));
+}
+
+void MasterLimiter::processChunk(AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    auto wanted = jlimit(0, holdCapacity - 2, roundToInt(lookAheadMs.load() * 0.001 * sampleRate));
+    if (wanted != lookAhead)
+        resetEnvelope(wanted);
+
+    auto numChannels = jmin(4, buffer.getNumChannels());
+    auto numMasterChannels = jmin(2, numChannels);
+    auto limit = ceiling.load();
+
+    FloatVectorOperations::clear(peaks, numSamples);
+    for (int channel = 0; channel < numMasterChannels; ++channel)
+        findTruePeaks(buffer.getReadPointer(channel, startSample), detectorHistory.getWritePointer(channel), numSamples);
+
+    // the gain each sample needs on its own
+    for (int i = 0; i < numSamples; ++i)
+        gains[i] = limit / jmax(peaks[i], limit);
+
+    // held for the look-ahead, released smoothly, then averaged over the look-ahead so the
+    // ramp down has finished by the time the peak comes out of the delay. The hold runs a
+    // sample longer, for a peak that falls between that sample and the next.
+    auto window = lookAhead + 1;
+    auto holdLength = window + 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto value = gains[i];
+
+        // the minimum of the last holdLength gains is at the front of an ascending queue. The
+        // oldest goes before the new one comes in, so a rising run never holds more than that.
+        if (holdCount > 0 && holdIndices[holdStart] <= sampleCount - holdLength)
+        {
+            holdStart = (holdStart + 1) % holdCapacity;
+            --holdCount;
+        }
+
+        while (holdCount > 0 && holdValues[(holdStart + holdCount - 1) % holdCapacity] >= value)
+            --holdCount;
+
+        auto back = (holdStart + holdCount) % holdCapacity;
+        holdValues[back] = value;
+        holdIndices[back] = sampleCount;
+        ++holdCount;
+
+        auto held = holdValues[holdStart];
+        envelope = held < envelope ? held : envelope + (held - envelope) * releaseCoefficient;
+
+        boxSum += envelope - boxValues[boxPosition];
+        boxValues[boxPosition] = envelope;
+        boxPosition = boxPosition + 1 < window ? boxPosition + 1 : 0;
+
+        gains[i] = jmin(1.0f, (float) (boxSum / window));
+        ++sampleCount;
+    }
+
+    // delay every channel by the latency, limiting the master pair on the way out
+    auto ringSize = delayLine.getNumSamples();
+    auto readPosition = (delayWritePosition - (lookAhead + detectorDelay) + ringSize) % ringSize;
+    auto firstWrite = jmin(numSamples, ringSize - delayWritePosition);
+    auto firstRead = jmin(numSamples, ringSize - readPosition);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* ring = delayLine.getWritePointer(channel);
+        auto* audio = buffer.getWritePointer(channel, startSample);
+
+        FloatVectorOperations::copy(ring + delayWritePosition, audio, firstWrite);
+        FloatVectorOperations::copy(ring, audio + firstWrite, numSamples - firstWrite);
+        FloatVectorOperations::copy(audio, ring + readPosition, firstRead);
+        FloatVectorOperations::copy(audio + firstRead, ring, numSamples - firstRead);
+
+        if (channel < numMasterChannels)
+            FloatVectorOperations::multiply(audio, gains, numSamples);
+    }
+
+    delayWritePosition = (delayWritePosition + numSamples) % ringSize;
+}
+
+//==============================================================================
+void MasterLimiter::benchmark()
+{
+    const double rate = 48000.0;
+    const double secondsOfAudio = 20.0;
+
+    std::cout << "Master limiter, " << rate / 1000.0 << " kHz, 4 channels, default look-ahead" << std::endl;
+
+    Random random(20261023);
+
+    for (auto size : { 16, 32, 64, 128, 256, 512 })
+    {
+        MasterLimiter limiter;
+        limiter.prepare(rate, size);
+
+        AudioBuffer<float> block(4, size);
+        auto numBlocks = (int) (rate * secondsOfAudio) / size;
+        int64 ticks = 0;
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            // loud enough that the limiter is working the whole time
+            for (int channel = 0; channel < 4; ++channel)
+                for (int n = 0; n < size; ++n)
+                    block.setSample(channel, n, 3.0f * (random.nextFloat() - 0.5f));
+
+            auto start = Time::getHighResolutionTicks();
+            limiter.process(block, 0, size);
+            ticks += Time::getHighResolutionTicks() - start;
+        }
+
+        auto seconds = Time::highResolutionTicksToSeconds(ticks);
+        std::cout << "  " << String(size).paddedLeft(' ', 3) << " samples: "
+                  << String(seconds * 1.0e6 / numBlocks, 2) << " us per block, "
+                  << String(100.0 * seconds / secondsOfAudio, 3) << "% of one core" << std::endl;
+    }
+}
+
+int MasterLimiter::check()
+{
+    const double rate = 48000.0;
+    const int numSamples = (int) rate;
+    const float tolerance = 1.0e-4f;
+
+    std::cout << "Master limiter, " << maxLookAheadMs << " ms look-ahead, a level falling on every sample" << std::endl;
+
+    // every sample needs a little less reduction than the one before, so no gain is ever
+    // dropped from the back of the hold queue and it stays as full as it can get
+    AudioBuffer<float> input(2, numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        for (int channel = 0; channel < 2; ++channel)
+            input.setSample(channel, i, 4.0f - 3.0f * (float) i / (float) numSamples);
+
+    CheckResults results;
+
+    for (auto size : { 1, 64, 512 })
+    {
+        MasterLimiter limiter;
+        limiter.setLookAheadMs(maxLookAheadMs);
+        limiter.prepare(rate, size);
+
+        AudioBuffer<float> output(input);
+        for (int start = 0; start < numSamples; start += size)
+            limiter.process(output, start, jmin(size, numSamples - start));
+
+        auto ceilingGain = limiter.ceiling.load();
+        auto peak = output.getMagnitude(0, numSamples);
+        std::cout << "  " << String(size).paddedLeft(' ', 3) << " samples: peak "
+                  << String(Decibels::gainToDecibels(peak), 3) << " dB, ceiling "
+                  << String(Decibels::gainToDecibels(ceilingGain), 3) << " dB" << std::endl;
+
+        results.expect(peak <= ceilingGain + tolerance, String(size) + " sample blocks went over the ceiling");
+    }
+
+    return results.finish();
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    MasterLimiter.h
+    Created: 23 Oct 2026 10:21:44am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Look-ahead true-peak limiter on the master bus, so two loud decks summed
+    at full volume are held under the ceiling instead of clipping.
+
+    Peaks are detected between the samples as well as on them: the signal is
+    interpolated at 4x by a polyphase FIR, one vector pass per tap. The gain
+    each sample needs is held for the look-ahead time, released smoothly and
+    averaged over the same time, so it has ramped all the way down by the
+    time the delayed peak comes through.
+
+    The audio is delayed by the look-ahead plus the detector's own delay,
+    which getLatencySamples reports. The headphone cue channels go through a
+    matching delay without limiting, so they stay in time with the speakers.
+
+    Everything is allocated in prepare; process never allocates or locks.
+*/
+class MasterLimiter
+{
+public:
+    MasterLimiter();
+
+    static constexpr float maxLookAheadMs = 10.0f;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    /** limits channels 0-1 and delays channels 2-3 by the same latency */
+    void process(AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    /** the most the output may reach, in dB true peak */
+    void setCeilingDb(float ceilingDb);
+    /** how far ahead peaks are seen, up to maxLookAheadMs; changes the latency */
+    void setLookAheadMs(float lookAheadMs);
+
+    /** how much later the output is than the input */
+    int getLatencySamples() const { return latency.load(); }
+    /** the deepest gain reduction in the last block, 0 or less */
+    float getGainReductionDb() const { return gainReductionDb.load(); }
+
+    /** times process at small block sizes and prints the cost of each */
+    static void benchmark();
+    /** limits a level that falls on every sample at the longest look-ahead, which keeps the
+        hold queue full, and checks nothing gets past the ceiling; returns the process exit code */
+    static int check();
+
+private:
+    /** one chunk no longer than the prepared block size */
+    void processChunk(AudioBuffer<float>& buffer, int startSample, int numSamples);
+    void findTruePeaks(const float* input, float* history, int numSamples);
+    /** a new look-ahead starts from no gain reduction */
+    void resetEnvelope(int lookAheadSamples);
+
+    static constexpr int numPhases = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int detectorDelay = tapsPerPhase / 2;
+
+    float coefficients[numPhases][tapsPerPhase];
+
+    double sampleRate = 44100.0;
+    int blockSize = 0;
+    float releaseCoefficient = 0.0f;
+
+    std::atomic<float> ceiling{ 1.0f };
+    std::atomic<float> lookAheadMs{ 5.0f };
+    std::atomic<int> latency{ 0 };
+    std::atomic<float> gainReductionDb{ 0.0f };
+
+    // audio thread state
+    int lookAhead = -1;
+    AudioBuffer<float> detectorHistory;   // the last tapsPerPhase - 1 inputs, then the block
+    HeapBlock<float> peaks, phaseOutput, gains;
+
+    HeapBlock<float> holdValues;          // ascending minimum over the window, as a ring
+    HeapBlock<int64> holdIndices;
+    int holdStart = 0, holdCount = 0, holdCapacity = 0;
+    int64 sampleCount = 0;
+    float envelope = 1.0f;
+
+    HeapBlock<float> boxValues;           // the last lookAhead + 1 envelope values
+    int boxPosition = 0;
+    double boxSum = 0.0;
+
+    AudioBuffer<float> delayLine;
+    int delayWritePosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterLimiter)
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    MemoryBudget.cpp
+    Created: 25 Oct 2026 10:08:34am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MemoryBudget.h"
+#include "Tracer.h"
+
+namespace
+{
+    const int64 maxDefaultLimitMB = 1024;
+}
+
+//==============================================================================
+MemoryBudget::Consumer::Consumer(const String& _subsystem, Cost _cost)
+    : subsystem(_subsystem), cost(_cost)
+{
+}
+
+MemoryBudget::Consumer::~Consumer()
+{
+    // the derived destructor should have left already; by now the overrides are gone
+    jassert(!added);
+}
+
+void MemoryBudget::Consumer::addToBudget()
+{
+    MemoryBudget::getInstance().add(this);
+}
+
+void MemoryBudget::Consumer::removeFromBudget()
+{
+    MemoryBudget::getInstance().remove(this);
+}
+
+//==============================================================================
+MemoryBudget& MemoryBudget::getInstance()
+{
+    // outlives every consumer, as it is built before the first one is added
+    static MemoryBudget budget;
+    return budget;
+}
+
+MemoryBudget::MemoryBudget() : limit(getDefaultLimit())
+{
+    add(&analysisScratch);
+}
+
+MemoryBudget::~MemoryBudget()
+{
+    remove(&analysisScratch);
+}
+
+size_t MemoryBudget::getDefaultLimit()
+{
+    auto megabytes = jmin(maxDefaultLimitMB, (int64) SystemStats::getMemorySizeInMegabytes() / 4);
+    return (size_t) jmax((int64) 64, megabytes) * 1024 * 1024;
+}
+
+void MemoryBudget::add(Consumer* consumer)
+{
+    const ScopedLock sl(lock);
+    consumers.addIfNotAlreadyThere(consumer);
+    consumer->added = true;
+}
+
+void MemoryBudget::remove(Consumer* consumer)
+{
+    // waits for anything asking it about its memory
+    const ScopedLock sl(lock);
+    consumers.removeFirstMatchingValue(consumer);
+    consumer->added = false;
+}
+
+size_t MemoryBudget::getUsedBytes() const
+{
+    const ScopedLock sl(lock);
+    size_t total = 0;
+
+    for (auto* consumer : consumers)
+        total += consumer->getUsedBytes();
+
+    return total;
+}
+
+bool MemoryBudget::makeRoom(size_t numBytes, Cost cost, const Consumer* asking)
+{
+    auto used = getUsedBytes();
+
+    if (used + numBytes <= limit)
+        return true;
+
+    TRACE_SPAN("MemoryBudget::makeRoom");
+
+    // the lock keeps every consumer in the list alive until it has been asked
+    const ScopedLock sl(lock);
+    auto toFree = used + numBytes - limit;
+
+    // cheapest to get back first, and never anything dearer than what it makes room for
+    for (auto level = (int) Cost::reload; level <= (int) cost; ++level)
+    {
+        for (auto* consumer : consumers)
+        {
+            if (consumer == asking || (int) consumer->cost != level || consumer->getEvictableBytes() == 0)
+                continue;
+
+            auto freed = consumer->evict(toFree);
+            evictedBytes += (int64) freed;
+            toFree -= jmin(toFree, freed);
+
+            if (toFree == 0)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool MemoryBudget::enforce()
+{
+    return makeRoom(0, Cost::analyse);
+}
+
+std::vector<MemoryBudget::Usage> MemoryBudget::getUsage() const
+{
+    const ScopedLock sl(lock);
+    std::vector<Usage> usage;
+
+    for (auto* consumer : consumers)
+    {
+        auto existing = std::find_if(usage.begin(), usage.end(), [consumer](const Usage& u)
+        {
+            return u.subsystem == consumer->subsystem;
+        });
+
+        if (existing == usage.end())
+        {
+            usage.push_back({ consumer->subsystem, consumer->cost, 0, 0 });
+            existing = usage.end() - 1;
+        }
+
+        existing->usedBytes += consumer->getUsedBytes();
+        existing->evictableBytes += consumer->getEvictableBytes();
+    }
+
+    return usage;
+}
+
+String MemoryBudget::getCostName(Cost cost)
+{
+    switch (cost)
+    {
+        case Cost::reload:  return "reload";
+        case Cost::decode:  return "decode";
+        case Cost::analyse: return "analyse";
+    }
+
+    return {};
+}
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    MemoryBudget.h
+    Created: 25 Oct 2026 10:08:34am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    One limit on the memory every cache and buffer in the app holds together.
+
+    Each consumer registers under a subsystem name with what it costs to get
+    evicted memory back. It reports how much it holds and how much of that it
+    could give up; the rest is pinned, like the buffers of a loaded deck or
+    the snippets a preview is playing. When the total goes over the limit, the
+    cheapest memory goes first: what can be read back from disk, then what has
+    to be decoded again. A consumer about to grow asks for room first, and may
+    only push out memory that is as cheap or cheaper to rebuild than its own.
+
+    Memory that is never given back, such as scratch space while a track is
+    analysed, is counted with a Tally. Everything is shown per subsystem in
+    the stats overlay.
+
+    Consumers are asked about their memory and evicted on the message thread,
+    where they are created and destroyed. Each joins the budget at the end of
+    its constructor and leaves at the start of its destructor, so it is never
+    asked while only partly built, and the budget holds its lock while it asks.
+    The one Tally for analysis scratch belongs to the budget and can be counted
+    on from any thread.
+*/
+class MemoryBudget
+{
+public:
+    /** what getting evicted memory back costs; the cheapest is evicted first */
+    enum class Cost
+    {
+        reload,     // read back from a cache file
+        decode,     // decoded from the track again
+        analyse     // the track analysed again
+    };
+
+    /** counted once it calls addToBudget() */
+    class Consumer
+    {
+    public:
+        Consumer(const String& subsystem, Cost cost);
+        virtual ~Consumer();
+
+        virtual size_t getUsedBytes() const = 0;
+        /** what could be evicted; the rest of the used bytes are pinned */
+        virtual size_t getEvictableBytes() const { return 0; }
+        /** message thread: give up at least numBytes if that much isn't pinned, least
+            valuable first; returns how much was freed */
+        virtual size_t evict(size_t numBytes) { ignoreUnused(numBytes); return 0; }
+
+    protected:
+        /** message thread: last thing in the derived constructor, once the overrides can be asked */
+        void addToBudget();
+        /** message thread: first thing in the derived destructor, while the overrides still can */
+        void removeFromBudget();
+
+    private:
+        friend class MemoryBudget;
+        const String subsystem;
+        const Cost cost;
+        bool added = false;
+
+        JUCE_DECLARE_NON_COPYABLE(Consumer)
+    };
+
+    /** bytes added and taken away from any thread, never evicted */
+    class Tally : public Consumer
+    {
+    public:
+        explicit Tally(const String& subsystem) : Consumer(subsystem, Cost::analyse) {}
+
+        size_t getUsedBytes() const override { return (size_t) jmax((int64) 0, bytes.load()); }
+
+        /** counts numBytes for as long as it's in scope */
+        struct Scoped
+        {
+            Scoped(Tally& _tally, size_t _numBytes) : tally(_tally), numBytes((int64) _numBytes) { tally.bytes += numBytes; }
+            ~Scoped() { tally.bytes -= numBytes; }
+
+            Tally& tally;
+            const int64 numBytes;
+
+            JUCE_DECLARE_NON_COPYABLE(Scoped)
+        };
+
+    private:
+        std::atomic<int64> bytes{ 0 };
+    };
+
+    /** a subsystem's consumers added together */
+    struct Usage
+    {
+        String subsystem;
+        Cost cost = Cost::reload;
+        size_t usedBytes = 0;
+        size_t evictableBytes = 0;
+    };
+
+    static MemoryBudget& getInstance();
+
+    /** a File, its path and its entry in a lookup, roughly; what the library's consumers
+        count for every track they know */
+    static constexpr size_t bytesPerPath = 160;
+
+    /** the buffers of analyses in progress, on every pool that runs them */
+    Tally& getAnalysisScratch() { return analysisScratch; }
+
+    /** a quarter of the machine's memory, and no more than 1 GB */
+    static size_t getDefaultLimit();
+
+    void setLimit(size_t numBytes) { limit = numBytes; }
+    size_t getLimit() const { return limit; }
+    size_t getUsedBytes() const;
+    /** everything evicted to stay under the limit so far */
+    int64 getEvictedBytes() const { return evictedBytes; }
+
+    /** Message thread. Evicts memory no dearer than cost from everyone but the asker until
+        numBytes more fit under the limit; false if they still don't. */
+    bool makeRoom(size_t numBytes, Cost cost, const Consumer* asking = nullptr);
+    /** message thread: back under the limit; false if what's pinned alone is over it */
+    bool enforce();
+
+    /** per subsystem, in the order they first registered */
+    std::vector<Usage> getUsage() const;
+    static String getCostName(Cost cost);
+
+private:
+    MemoryBudget();
+    ~MemoryBudget();
+
+    void add(Consumer* consumer);
+    void remove(Consumer* consumer);
+
+    CriticalSection lock;
+    Array<Consumer*> consumers;
+    std::atomic<size_t> limit;
+    std::atomic<int64> evictedBytes{ 0 };
+    Tally analysisScratch{ "Analysis scratch" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MemoryBudget)
+};
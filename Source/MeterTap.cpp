@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    MeterTap.cpp
+    Created: 23 Oct 2026 2:16:47pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MeterTap.h"
+
+MeterTap::MeterTap()
+{
+    ring.setSize(numChannels, capacity);
+    ring.clear();
+}
+
+void MeterTap::push(const float* left, const float* right, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    if (fifo.getFreeSpace() < numSamples)
+    {
+        ++numDropped;
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    const float* inputs[numChannels] = { left, right };
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        FloatVectorOperations::copy(ring.getWritePointer(channel, start1), inputs[channel], size1);
+
+        if (size2 > 0)
+            FloatVectorOperations::copy(ring.getWritePointer(channel, start2), inputs[channel] + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+int MeterTap::pull(AudioBuffer<float>& dest)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(jmin(fifo.getNumReady(), dest.getNumSamples()), start1, size1, start2, size2);
+
+    for (int channel = 0; channel < jmin(numChannels, dest.getNumChannels()); ++channel)
+    {
+        dest.copyFrom(channel, 0, ring, channel, start1, size1);
+
+        if (size2 > 0)
+            dest.copyFrom(channel, size1, ring, channel, start2, size2);
+    }
+
+    fifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    MeterTap.h
+    Created: 23 Oct 2026 2:16:47pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    A stereo signal handed from the audio thread to the GUI for metering.
+
+    The audio thread copies each block into a lock-free ring and does nothing
+    else; when the GUI has fallen behind and the block doesn't fit, the whole
+    block is dropped rather than waiting or overwriting. One GUI-side reader
+    pulls whatever has arrived and does the measuring.
+
+    The ring is allocated here and never resized, so prepare can be called
+    while the reader is running.
+*/
+class MeterTap
+{
+public:
+    static constexpr int numChannels = 2;
+    static constexpr int capacity = 1 << 15;
+
+    MeterTap();
+
+    /** whichever thread prepares the audio */
+    void prepare(double sampleRate) { currentSampleRate = sampleRate; }
+    double getSampleRate() const { return currentSampleRate.load(); }
+
+    /** audio thread: copy a block in, or drop it if there is no room */
+    void push(const float* left, const float* right, int numSamples) noexcept;
+
+    /** reader: moves everything waiting into dest, up to its size; returns how many samples */
+    int pull(AudioBuffer<float>& dest);
+
+    /** blocks the reader was too late for */
+    int64 getNumDropped() const { return numDropped.load(); }
+
+private:
+    AbstractFifo fifo{ capacity };
+    AudioBuffer<float> ring;
+    std::atomic<double> currentSampleRate{ 44100.0 };
+    std::atomic<int64> numDropped{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterTap)
+};
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    MidiCheck.cpp
+    Created: 27 Oct 2026 2:18:40pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MidiCheck.h"
+#include "MidiController.h"
+#include "EngineStress.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const double trackSeconds = 2.0;
+    const double timeoutMs = 3000.0;
+    const char* const portName = "OtoDecks MIDI check";
+
+    // what the default mapping sends for each control
+    const int volumeValue = 64;
+    const int crossfaderValue = 127;
+
+    /** a quiet tone, enough for the deck to load and cue */
+    File writeTestTrack(const File& file)
+    {
+        file.deleteFile();
+
+        WavAudioFormat wav;
+        std::unique_ptr<FileOutputStream> stream(new FileOutputStream(file));
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 16, {}, 0));
+
+        if (writer == nullptr)
+            return {};
+
+        stream.release(); // the writer owns it now
+
+        auto numSamples = (int) (trackSeconds * sampleRate);
+        AudioBuffer<float> buffer(2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < 2; ++channel)
+                buffer.setSample(channel, i, 0.25f * (float) std::sin(MathConstants<double>::twoPi * 440.0 * i / sampleRate));
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        return file;
+    }
+
+    /** the deck keeps its gain as a float */
+    bool hasVolume(const DJAudioPlayer& deck)
+    {
+        return std::abs(deck.getGain() - volumeValue / 127.0) < 1.0e-6;
+    }
+}
+
+//==============================================================================
+int MidiCheck::run()
+{
+    std::cout << "OtoDecks MIDI check, virtual port" << std::endl;
+
+    auto output = MidiOutput::createNewDevice(portName);
+
+    // a machine without the ALSA sequencer can't run this, which isn't a failure of the mapping
+    if (output == nullptr)
+        return CheckResults::skip("couldn't create a virtual MIDI port, this needs the ALSA sequencer");
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto track = writeTestTrack(File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks MIDI check.wav"));
+    CheckResults results;
+
+    if (!results.expect(track.existsAsFile(), "couldn't write the test track"))
+        return results.finish();
+
+    DJAudioPlayer deckA(formatManager), deckB(formatManager);
+    DJMixer mixer;
+    mixer.addDeck(&deckA, DJMixer::CrossfaderSide::left);
+    mixer.addDeck(&deckB, DJMixer::CrossfaderSide::right);
+    mixer.prepareToPlay(blockSize, sampleRate);
+    deckA.loadURL(URL(track));
+
+    AudioDeviceManager deviceManager;
+    MidiController controller(deckA, deckB, mixer);
+    controller.prepareToPlay(blockSize, sampleRate);
+    controller.attach(deviceManager);
+
+    auto opened = false;
+    for (auto& device : MidiInput::getAvailableDevices())
+        if (device.name == portName && deviceManager.isMidiInputDeviceEnabled(device.identifier))
+            opened = true;
+
+    results.expect(opened, "the virtual port wasn't opened as an input");
+    results.expect(deckA.waitUntilBuffered(trackSeconds, 5000), "the test track's read-ahead never filled");
+
+    if (results.hasPassed())
+    {
+        // deck 1 is on channel 1 and deck 2 on channel 2, the crossfader is on CC 8 of either
+        output->sendMessageNow(MidiMessage::controllerEvent(1, 1, volumeValue));
+        output->sendMessageNow(MidiMessage::controllerEvent(2, 3, 0));
+        output->sendMessageNow(MidiMessage::controllerEvent(1, 8, crossfaderValue));
+        output->sendMessageNow(MidiMessage::noteOn(1, 4, (uint8) 100));
+        output->sendMessageNow(MidiMessage::noteOn(1, 0, (uint8) 100));
+
+        auto allArrived = [&]
+        {
+            return deckA.isPlaying() && deckA.hasHotCue(0)
+                && hasVolume(deckA)
+                && mixer.getBandGain(1, DeckEQ::low) == 0.0f
+                && mixer.getCrossfader() == crossfaderValue / 127.0f;
+        };
+
+        auto cueSetInBlock = false;
+        auto endTime = Time::getMillisecondCounterHiRes() + timeoutMs;
+
+        while (!allArrived() && Time::getMillisecondCounterHiRes() < endTime)
+        {
+            // one audio block, then a turn of the message loop
+            auto hadCue = deckA.hasHotCue(0);
+            controller.beginBlock(blockSize);
+
+            for (int done = 0; done < blockSize;)
+                done += controller.applyEvents(done, blockSize - done);
+
+            cueSetInBlock = cueSetInBlock || (!hadCue && deckA.hasHotCue(0));
+            EngineStress::dispatchMessages(5);
+        }
+
+        std::cout << "  deck 1 gain " << deckA.getGain() << ", deck 2 low " << mixer.getBandGain(1, DeckEQ::low)
+                  << ", crossfader " << mixer.getCrossfader() << (deckA.isPlaying() ? ", playing" : ", stopped")
+                  << (deckA.hasHotCue(0) ? ", hot cue 1 set" : "") << std::endl;
+
+        results.expect(hasVolume(deckA), "the volume fader didn't reach deck 1");
+        results.expect(mixer.getBandGain(1, DeckEQ::low) == 0.0f, "the low EQ knob didn't reach deck 2");
+        results.expect(mixer.getCrossfader() == crossfaderValue / 127.0f, "the crossfader didn't move");
+        results.expect(deckA.isPlaying(), "the play button didn't start deck 1");
+        results.expect(deckA.hasHotCue(0), "hot cue 1 was never set");
+        results.expect(!cueSetInBlock, "hot cue 1 was set from the audio block instead of the message thread");
+    }
+
+    controller.detach();
+    mixer.releaseResources();
+    track.deleteFile();
+
+    return results.finish();
+}
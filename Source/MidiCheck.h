@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    MidiCheck.h
+    Created: 27 Oct 2026 2:18:40pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of the MIDI mapping through a real port, started with
+    --midi-check.
+
+    A virtual MIDI output is created the way a controller's driver or another
+    app would create an ALSA sequencer port. The MidiController must find it
+    as a new input and open it. A fader, an EQ knob, the crossfader, the play
+    button and a hot cue are then sent through it while this thread stands in
+    for the audio device and the message loop in turn. Every control has to
+    reach its deck or the mixer, and the hot cue must only be set once the
+    message loop has run, never from the audio block.
+
+    This needs the ALSA sequencer; where virtual ports aren't supported the
+    check fails straight away.
+*/
+class MidiCheck
+{
+public:
+    /** sends the messages and checks where they landed, printing progress; returns the process exit code */
+    static int run();
+};
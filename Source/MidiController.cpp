@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    MidiController.cpp
+    Created: 20 Oct 2026 4:37:52pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MidiController.h"
+
+namespace
+{
+    // events closer together than this are applied in one go, matching the EQ's sub-blocks
+    const int minSegment = 16;
+    // how much audio one jog tick moves the record by while it's touched
+    const double jogSecondsPerTick = 0.01;
+    const int deviceCheckIntervalMs = 2000;
+}
+
+MidiController::MidiController(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& _mixer)
+    : decks{ &deckA, &deckB },
+      mixer(_mixer)
+{
+    setMappings(getDefaultMappings());
+}
+
+MidiController::~MidiController()
+{
+    detach();
+    cancelPendingUpdate();
+}
+
+Array<MidiController::Mapping> MidiController::getDefaultMappings()
+{
+    Array<Mapping> defaults;
+
+    for (int deck = 0; deck < 2; ++deck)
+    {
+        auto channel = deck + 1;
+
+        for (int cue = 0; cue < CueWindowSource::maxCues; ++cue)
+            defaults.add({ channel, false, cue, Action::hotCue, deck, cue });
+
+        defaults.add({ channel, false, 4, Action::play, deck, 0 });
+        defaults.add({ channel, false, 5, Action::stop, deck, 0 });
+        defaults.add({ channel, false, 6, Action::sync, deck, 0 });
+        defaults.add({ channel, false, 7, Action::pfl, deck, 0 });
+        defaults.add({ channel, false, 8, Action::jogTouch, deck, 0 });
+
+        defaults.add({ channel, true, 1, Action::volume, deck, 0 });
+        defaults.add({ channel, true, 2, Action::speed, deck, 0 });
+        defaults.add({ channel, true, 3, Action::eq, deck, DeckEQ::low });
+        defaults.add({ channel, true, 4, Action::eq, deck, DeckEQ::mid });
+        defaults.add({ channel, true, 5, Action::eq, deck, DeckEQ::high });
+        defaults.add({ channel, true, 6, Action::filter, deck, 0 });
+        defaults.add({ channel, true, 7, Action::jog, deck, 0 });
+    }
+
+    for (int channel = 1; channel <= 16; ++channel)
+        defaults.add({ channel, true, 8, Action::crossfader, 0, 0 });
+
+    return defaults;
+}
+
+void MidiController::setMappings(const Array<Mapping>& newMappings)
+{
+    mappings = newMappings;
+
+    for (auto& kind : lookup)
+        for (auto& channel : kind)
+            for (auto& entry : channel)
+                entry = -1;
+
+    for (int i = 0; i < mappings.size(); ++i)
+    {
+        auto& mapping = mappings.getReference(i);
+
+        if (isPositiveAndBelow(mapping.channel - 1, 16) && isPositiveAndBelow(mapping.number, 128))
+            lookup[mapping.isController ? 1 : 0][mapping.channel - 1][mapping.number] = (int16) i;
+    }
+}
+
+//==============================================================================
+void MidiController::attach(AudioDeviceManager& deviceManager)
+{
+    detach();
+
+    attachedManager = &deviceManager;
+    attachedManager->addMidiInputDeviceCallback({}, &collector);
+
+    openNewInputs();
+    startTimer(deviceCheckIntervalMs);
+}
+
+void MidiController::detach()
+{
+    stopTimer();
+
+    if (attachedManager != nullptr)
+        attachedManager->removeMidiInputDeviceCallback({}, &collector);
+
+    attachedManager = nullptr;
+}
+
+void MidiController::timerCallback()
+{
+    openNewInputs();
+}
+
+void MidiController::openNewInputs()
+{
+    for (auto& device : MidiInput::getAvailableDevices())
+    {
+        if (!attachedManager->isMidiInputDeviceEnabled(device.identifier))
+        {
+            DBG("MidiController - Opening " + device.name);
+            attachedManager->setMidiInputDeviceEnabled(device.identifier, true);
+        }
+    }
+}
+
+//==============================================================================
+void MidiController::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    collector.reset(sampleRate);
+    pending.ensureSize((size_t) jmax(256, samplesPerBlockExpected) * 3);
+}
+
+void MidiController::beginBlock(int numSamples)
+{
+    pending.clear();
+    collector.removeNextBlockOfMessages(pending, numSamples);
+    appliedUpTo = 0;
+}
+
+int MidiController::applyEvents(int position, int numSamplesLeft)
+{
+    auto from = appliedUpTo;
+    appliedUpTo = jmax(appliedUpTo, position + minSegment);
+
+    for (auto it = pending.findNextSamplePosition(from); it != pending.cend(); ++it)
+    {
+        const auto metadata = *it;
+
+        if (metadata.samplePosition >= appliedUpTo)
+            return jlimit(1, numSamplesLeft, metadata.samplePosition - position);
+
+        handle(metadata.getMessage());
+    }
+
+    return numSamplesLeft;
+}
+
+void MidiController::handleAsyncUpdate()
+{
+    auto numReady = hotCueFifo.getNumReady();
+
+    if (numReady == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    hotCueFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        auto& press = hotCuePresses[i < size1 ? start1 + i : start2 + i - size1];
+        auto& deck = *decks[jlimit(0, 1, press.deck)];
+
+        if (deck.hasHotCue(press.index))
+            deck.jumpToHotCue(press.index);
+        else
+            deck.setHotCue(press.index);
+    }
+
+    hotCueFifo.finishedRead(size1 + size2);
+}
+
+DJAudioPlayer* MidiController::deckFor(const Mapping& mapping) const
+{
+    return decks[jlimit(0, 1, mapping.deck)];
+}
+
+void MidiController::handle(const MidiMessage& message)
+{
+    auto isController = message.isController();
+
+    if (!isController && !message.isNoteOnOrOff())
+        return;
+
+    auto number = isController ? message.getControllerNumber() : message.getNoteNumber();
+    auto index = lookup[isController ? 1 : 0][message.getChannel() - 1][number];
+
+    if (index < 0)
+        return;
+
+    auto& mapping = mappings.getReference(index);
+    auto& deck = *deckFor(mapping);
+    auto value = isController ? message.getControllerValue() : 0;
+    auto isDown = message.isNoteOn();
+
+    switch (mapping.action)
+    {
+        case Action::play:     if (isDown) deck.start(); break;
+        case Action::stop:     if (isDown) deck.stop(); break;
+        case Action::sync:     if (isDown) deck.setSyncEnabled(!deck.isSyncEnabled()); break;
+        case Action::pfl:      if (isDown) mixer.setPfl(mapping.deck, !mixer.isPfl(mapping.deck)); break;
+
+        case Action::hotCue:
+            if (isDown && hotCueFifo.getFreeSpace() > 0)
+            {
+                int start1, size1, start2, size2;
+                hotCueFifo.prepareToWrite(1, start1, size1, start2, size2);
+                hotCuePresses[size1 > 0 ? start1 : start2] = { mapping.deck, mapping.index };
+                hotCueFifo.finishedWrite(1);
+                triggerAsyncUpdate();
+            }
+            break;
+
+        case Action::jogTouch:
+            if (isDown)
+            {
+                jogOffset[mapping.deck] = 0.0;
+                deck.beginScratch();
+            }
+            else
+            {
+                deck.endScratch();
+            }
+            break;
+
+        case Action::jog:
+            // relative encoder: the distance from 64 is the number of ticks, signed
+            if (deck.isScratching())
+            {
+                jogOffset[mapping.deck] += (value < 64 ? value : value - 128) * jogSecondsPerTick;
+                deck.scratchTo(jogOffset[mapping.deck]);
+            }
+            break;
+
+        case Action::volume:     deck.setGain(value / 127.0); break;
+        case Action::speed:      deck.setSpeed(std::pow(2.0, (value - 64) / 64.0)); break;
+        case Action::eq:         mixer.setBandGain(mapping.deck, (DeckEQ::Band) mapping.index, jmin(2.0f, value / 64.0f)); break;
+        case Action::filter:     mixer.setFilter(mapping.deck, jlimit(-1.0f, 1.0f, (value - 64) / 63.0f)); break;
+        case Action::crossfader: mixer.setCrossfader(value / 127.0f); break;
+        default:                 break;
+    }
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    MidiController.h
+    Created: 20 Oct 2026 4:37:52pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+#include "DJMixer.h"
+
+//==============================================================================
+/*
+    Turns CC and note messages from any MIDI input into deck and mixer commands.
+
+    Incoming messages are timestamped by a MidiMessageCollector as they arrive.
+    At the start of every audio block they are laid out across the block, and
+    the engine renders up to each one before applying it, so a fader move or a
+    jog tick takes effect at its own sample offset rather than whenever the
+    message thread gets round to it.
+
+    The default mapping gives each deck its own MIDI channel (deck 1 on 1,
+    deck 2 on 2), with the crossfader on CC 8 of any channel:
+
+        notes 0-3  hot cues          CC 1  volume
+        note  4    play              CC 2  speed, 64 is normal
+        note  5    stop              CC 3-5  low, mid and high EQ, 64 is flat
+        note  6    sync on/off       CC 6  filter, 64 is off
+        note  7    headphone cue     CC 7  jog, relative: 1-63 forwards, 65-127 back
+        note  8    jog touch
+
+    Faders, knobs, the jog wheel and the transport buttons only set values the
+    decks and mixer keep as atomics, so they are applied on the audio thread.
+    A hot cue press can land while the deck is swapping tracks, and setting a
+    cue reaches into the deck's read-ahead, so those are passed through a
+    FIFO to the message thread and applied there instead.
+
+    Inputs that appear while the app is running, such as a virtual ALSA port,
+    are opened when the device list is next checked.
+*/
+class MidiController : private Timer,
+                       private AsyncUpdater
+{
+public:
+    enum class Action
+    {
+        play, stop, sync, pfl, hotCue, jogTouch,       // notes
+        volume, speed, eq, filter, jog, crossfader     // controllers
+    };
+
+    struct Mapping
+    {
+        int channel;        // 1 to 16
+        bool isController;  // a CC, otherwise a note
+        int number;
+        Action action;
+        int deck;           // 0 or 1, ignored for the crossfader
+        int index;          // hot cue number or EQ band
+    };
+
+    MidiController(DJAudioPlayer& deckA, DJAudioPlayer& deckB, DJMixer& mixer);
+    ~MidiController() override;
+
+    static Array<Mapping> getDefaultMappings();
+    /** replaces the mapping; call before attach() */
+    void setMappings(const Array<Mapping>& newMappings);
+
+    /** opens every MIDI input on the device manager and keeps opening new ones */
+    void attach(AudioDeviceManager& deviceManager);
+    void detach();
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate);
+
+    /** audio thread: collects the messages that arrived since the last block */
+    void beginBlock(int numSamples);
+    /** audio thread: applies the events due at this offset into the block and
+        returns how many samples can be rendered before the next one */
+    int applyEvents(int position, int numSamplesLeft);
+
+private:
+    struct HotCuePress
+    {
+        int deck;
+        int index;
+    };
+
+    void timerCallback() override;
+    /** message thread: sets or jumps to the hot cues pressed since the last update */
+    void handleAsyncUpdate() override;
+    void openNewInputs();
+    void handle(const MidiMessage& message);
+    DJAudioPlayer* deckFor(const Mapping& mapping) const;
+
+    DJAudioPlayer* decks[2];
+    DJMixer& mixer;
+
+    Array<Mapping> mappings;
+    // index into mappings for [cc or note][channel][number], -1 when unmapped
+    int16 lookup[2][16][128];
+
+    AudioDeviceManager* attachedManager = nullptr;
+    MidiMessageCollector collector;
+
+    // hot cue presses from the audio thread, applied on the message thread
+    AbstractFifo hotCueFifo{ 64 };
+    HotCuePress hotCuePresses[64];
+
+    // audio thread only
+    MidiBuffer pending;
+    int appliedUpTo = 0;
+    double jogOffset[2] = { 0.0, 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiController)
+};
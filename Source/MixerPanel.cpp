@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    MixerPanel.cpp
+    Created: 19 Oct 2026 4:48:55pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "MixerPanel.h"
+#include "Tracer.h"
+
+MixerPanel::MixerPanel(DJMixer& _mixer)
+    : mixer(_mixer)
+{
+    for (int deck = 0; deck < 2; ++deck)
+    {
+        auto& strip = strips[deck];
+        customizeKnob(strip.bandSliders[DeckEQ::low], 0.0, 2.0, 1.0, Colours::red);
+        customizeKnob(strip.bandSliders[DeckEQ::mid], 0.0, 2.0, 1.0, Colours::yellow);
+        customizeKnob(strip.bandSliders[DeckEQ::high], 0.0, 2.0, 1.0, Colours::cyan);
+        customizeKnob(strip.filterSlider, -1.0, 1.0, 0.0, Colours::orange);
+
+        // Headphone cue - Pre-fader listen for this deck
+        strip.pflButton.setClickingTogglesState(true);
+        strip.pflButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+        strip.pflButton.setColour(TextButton::buttonOnColourId, Colours::orange);
+        strip.pflButton.onClick = [this, deck] { mixer.setPfl(deck, strips[deck].pflButton.getToggleState()); };
+        addAndMakeVisible(strip.pflButton);
+    }
+
+    customizeKnob(cueMixSlider, 0.0, 1.0, 0.0, Colours::lightgreen);
+    cueMixSlider.setTooltip("Headphones: cue to master");
+
+    // Master limiter - Ceiling in dB true peak, look-ahead in ms
+    customizeKnob(ceilingSlider, -12.0, 0.0, -1.0, Colours::red);
+    ceilingSlider.setTooltip("Master limiter ceiling (dBTP)");
+    customizeKnob(lookAheadSlider, 0.5, MasterLimiter::maxLookAheadMs, 5.0, Colours::red);
+    lookAheadSlider.setTooltip("Master limiter look-ahead (ms)");
+
+    gainReductionLabel.setFont(Font(11.0f));
+    gainReductionLabel.setJustificationType(Justification::centred);
+    gainReductionLabel.setColour(Label::textColourId, Colours::red);
+    addAndMakeVisible(gainReductionLabel);
+
+    // Crossfader - Horizontal, centred on double-click
+    crossfaderSlider.setSliderStyle(Slider::LinearHorizontal);
+    crossfaderSlider.setRange(0.0, 1.0);
+    crossfaderSlider.setValue(0.5, dontSendNotification);
+    crossfaderSlider.setDoubleClickReturnValue(true, 0.5);
+    crossfaderSlider.setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+    crossfaderSlider.setColour(Slider::thumbColourId, Colours::white);
+    crossfaderSlider.setColour(Slider::trackColourId, Colours::darkgrey);
+    crossfaderSlider.addListener(this);
+    addAndMakeVisible(crossfaderSlider);
+
+    curveBox.addItem("Linear", 1 + (int) DJMixer::CrossfaderCurve::linear);
+    curveBox.addItem("Constant Power", 1 + (int) DJMixer::CrossfaderCurve::constantPower);
+    curveBox.addItem("Cut", 1 + (int) DJMixer::CrossfaderCurve::cut);
+    curveBox.setSelectedId(1 + (int) DJMixer::CrossfaderCurve::constantPower, dontSendNotification);
+    curveBox.addListener(this);
+    addAndMakeVisible(curveBox);
+}
+
+MixerPanel::~MixerPanel()
+{
+}
+
+void MixerPanel::customizeKnob(Slider& knob, double minimum, double maximum, double defaultValue, Colour colour)
+{
+    knob.setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+    knob.setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+    knob.setRange(minimum, maximum);
+    knob.setValue(defaultValue, dontSendNotification);
+    knob.setDoubleClickReturnValue(true, defaultValue);
+    knob.setColour(Slider::rotarySliderFillColourId, colour);
+    knob.addListener(this);
+    addAndMakeVisible(knob);
+}
+
+void MixerPanel::paint(Graphics& g)
+{
+    TRACE_SPAN("MixerPanel::paint");
+
+    g.fillAll(Colours::black);
+
+    g.setColour(Colours::grey);
+    g.setFont(12.0f);
+
+    auto labels = getLocalBounds().removeFromBottom(14);
+    auto stripWidth = getWidth() / 3;
+    g.drawText("LOW  MID  HIGH  FILTER", labels.removeFromLeft(stripWidth), Justification::centred);
+    g.drawText("CROSSFADER", labels.removeFromLeft(stripWidth), Justification::centred);
+    g.drawText("LOW  MID  HIGH  FILTER", labels, Justification::centred);
+
+    g.setColour(Colours::darkgrey);
+    g.drawRect(getLocalBounds(), 1);
+}
+
+void MixerPanel::layoutStrip(DeckStrip& strip, Rectangle<int> area)
+{
+    strip.pflButton.setBounds(area.removeFromRight(50).reduced(4, 14));
+
+    auto knobWidth = area.getWidth() / (DeckEQ::numBands + 1);
+
+    for (auto& knob : strip.bandSliders)
+        knob.setBounds(area.removeFromLeft(knobWidth).reduced(2));
+
+    strip.filterSlider.setBounds(area.reduced(2));
+}
+
+void MixerPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(4);
+    bounds.removeFromBottom(12); // Leave room for the labels
+
+    auto stripWidth = bounds.getWidth() / 3;
+    layoutStrip(strips[0], bounds.removeFromLeft(stripWidth));
+    auto centre = bounds.removeFromLeft(stripWidth);
+    layoutStrip(strips[1], bounds);
+
+    cueMixSlider.setBounds(centre.removeFromRight(50).reduced(2));
+
+    auto limiterArea = centre.removeFromLeft(80);
+    gainReductionLabel.setBounds(limiterArea.removeFromBottom(14));
+    ceilingSlider.setBounds(limiterArea.removeFromLeft(40).reduced(2));
+    lookAheadSlider.setBounds(limiterArea.reduced(2));
+
+    curveBox.setBounds(centre.removeFromTop(centre.getHeight() / 2).reduced(20, 4));
+    crossfaderSlider.setBounds(centre.reduced(8, 0));
+}
+
+void MixerPanel::sliderValueChanged(Slider* slider)
+{
+    if (slider == &crossfaderSlider)
+    {
+        mixer.setCrossfader((float) slider->getValue());
+        return;
+    }
+
+    if (slider == &cueMixSlider)
+    {
+        mixer.setCueMix((float) slider->getValue());
+        return;
+    }
+
+    if (slider == &ceilingSlider)
+    {
+        mixer.getLimiter().setCeilingDb((float) slider->getValue());
+        return;
+    }
+
+    if (slider == &lookAheadSlider)
+    {
+        mixer.getLimiter().setLookAheadMs((float) slider->getValue());
+        return;
+    }
+
+    for (int deck = 0; deck < 2; ++deck)
+    {
+        auto& strip = strips[deck];
+
+        for (int band = 0; band < DeckEQ::numBands; ++band)
+            if (slider == &strip.bandSliders[band])
+                mixer.setBandGain(deck, (DeckEQ::Band) band, (float) slider->getValue());
+
+        if (slider == &strip.filterSlider)
+            mixer.setFilter(deck, (float) slider->getValue());
+    }
+}
+
+void MixerPanel::comboBoxChanged(ComboBox* comboBox)
+{
+    if (comboBox == &curveBox)
+        mixer.setCrossfaderCurve((DJMixer::CrossfaderCurve) (curveBox.getSelectedId() - 1));
+}
+
+void MixerPanel::refreshLimiter()
+{
+    auto reduction = mixer.getLimiter().getGainReductionDb();
+    gainReductionLabel.setText(reduction < -0.1f ? "GR " + String(reduction, 1) + " dB" : String(),
+                               dontSendNotification);
+}
+
+void MixerPanel::refreshCrossfader()
+{
+    if (!crossfaderSlider.isMouseButtonDown())
+        crossfaderSlider.setValue(mixer.getCrossfader(), dontSendNotification);
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    MixerPanel.h
+    Created: 19 Oct 2026 4:48:55pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJMixer.h"
+
+//==============================================================================
+/*
+    Strip between the decks: EQ, filter and headphone cue for each deck either
+    side of the crossfader, its curve selector and the cue/master blend, plus
+    the master limiter's ceiling and look-ahead.
+*/
+class MixerPanel : public Component,
+                   public Slider::Listener,
+                   public ComboBox::Listener
+{
+public:
+    MixerPanel(DJMixer& mixer);
+    ~MixerPanel();
+
+    void paint(Graphics&) override;
+    void resized() override;
+
+    /** implement Slider::Listener */
+    void sliderValueChanged(Slider* slider) override;
+
+    /** implement ComboBox::Listener */
+    void comboBoxChanged(ComboBox* comboBox) override;
+
+    /** move the crossfader to where the mixer has it, when something else is driving it */
+    void refreshCrossfader();
+    /** show how hard the master limiter is working */
+    void refreshLimiter();
+
+private:
+    struct DeckStrip
+    {
+        Slider bandSliders[DeckEQ::numBands];
+        Slider filterSlider;
+        TextButton pflButton{ "CUE" };
+    };
+
+    void customizeKnob(Slider& knob, double minimum, double maximum, double defaultValue, Colour colour);
+    void layoutStrip(DeckStrip& strip, Rectangle<int> area);
+
+    DJMixer& mixer;
+
+    DeckStrip strips[2];
+    Slider crossfaderSlider;
+    ComboBox curveBox;
+    Slider cueMixSlider;
+    Slider ceilingSlider;
+    Slider lookAheadSlider;
+    Label gainReductionLabel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixerPanel)
+};
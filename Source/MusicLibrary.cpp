@@ -1,331 +1,381 @@
-#include "MusicLibrary.h"
-#include "../JuceLibraryCode/JuceHeader.h"
-
-MusicLibrary::MusicLibrary()
-{
-    std::cout << "MusicLibrary initialized!" << std::endl;
-    // Set library file path
-    libraryFilePath = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("music_library.txt").getFullPathName();
-
-    // Configure table
-    addAndMakeVisible(table);
-    table.setModel(this);
-    table.setHeaderHeight(30);
-
-    // Add columns without fixed width (we'll set them in resized())
-    table.getHeader().addColumn("Track Name", 1, 100); // Placeholder width
-    table.getHeader().addColumn("Delete", 2, 80);      // Fixed width
-
-    // Add search box
-    addAndMakeVisible(searchBox);
-    searchBox.setTextToShowWhenEmpty("Search for a track...", Colours::grey);
-    searchBox.addListener(this);
-
-    // Add button
-    addAndMakeVisible(addButton);
-    addButton.addListener(this);
-
-    // Load saved library
-    loadLibrary();
-}
-
-MusicLibrary::~MusicLibrary() {}
-
-void MusicLibrary::paint(Graphics& g)
-{
-    // Apply a gradient background to the music library
-    ColourGradient gradient(Colours::midnightblue, 0.0f, 0.0f, Colours::darkslateblue, getWidth(), getHeight(), false);
-    g.setGradientFill(gradient);
-    g.fillAll();
-
-    // Apply a soft shadow effect for the search box and button
-    g.setColour(Colours::black.withAlpha(0.2f));
-    g.fillRoundedRectangle(searchBox.getBounds().toFloat(), 8.0f);
-    g.fillRoundedRectangle(addButton.getBounds().toFloat(), 8.0f);
-
-  
-    //// Add smooth fade-in effect for text (e.g., "Add Music" button)
-    g.setColour(Colours::green.withAlpha(0.8f));
-    g.setFont(18.0f);
-    g.drawText("Add Music", addButton.getBounds(), Justification::centred, true);
-
-    //// Optional: Add some subtle hover effect for the button (optional)
-    if (addButton.isMouseOver())
-    {
-        g.setColour(Colours::green.withAlpha(0.6f));
-        g.setFont(18.0f);
-        g.drawText("Add Music", addButton.getBounds(), Justification::centred, true);
-    }
-}
-
-
-void MusicLibrary::resized()
-{
-    // Animations for resizing with smooth transitions
-    const int margin = 10;
-    const int buttonWidth = 80;
-    const int buttonHeight = 30;
-
-    int tableWidth = getWidth();  // Get available width
-    int deleteColumnWidth = 80;   // Fixed width for delete button
-    int trackColumnWidth = tableWidth - deleteColumnWidth - 20; // Remaining width
-
-    table.getHeader().setColumnWidth(1, trackColumnWidth);
-    table.getHeader().setColumnWidth(2, deleteColumnWidth);
-
-    // Search box should be responsive
-    searchBox.setBounds(margin, margin, getWidth() - buttonWidth - 2 * margin, buttonHeight);
-
-    // Button with smooth shadow effect
-    addButton.setBounds(getWidth() - buttonWidth - margin, margin, buttonWidth, buttonHeight);
-
-    // Table should take the remaining height and width
-    table.setBounds(margin, margin + buttonHeight + 10, getWidth() - 2 * margin, getHeight() - margin - buttonHeight - 20);
-    //table.getViewport()->getViewedComponent()->removeAllChildren();
-
-    table.updateContent();
-    table.repaint();       // Redraws the table
-
-}
-
-
-// Table methods
-int MusicLibrary::getNumRows()
-{
-    return tracks.size();
-}
-
-void MusicLibrary::paintRowBackground(Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
-{
-    if (rowIsSelected)
-    {
-        g.setColour(Colours::red.withAlpha(0.5f)); // Better contrast for selected row
-    }
-    else
-    {
-        g.setColour(rowNumber % 2 == 0 ? Colours::green.withAlpha(0.4f) : Colours::blue.withAlpha(0.4f));
-    }
-
-    g.fillRect(0, 0, width, height);
-}
-
-
-
-
-void MusicLibrary::paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool rowSelected)
-{
-    if (rowNumber < displayedTracks.size())
-    {
-        g.setColour(Colours::white);
-        g.drawText(displayedTracks[rowNumber].getFileName(), 2, 0, width - 4, height, Justification::centredLeft);
-    }
-    else
-    {
-        g.setColour(Colours::grey);
-        g.drawText("No Tracks Available", 2, 0, width - 4, height, Justification::centredLeft);
-    }
-}
-
-
-Component* MusicLibrary::refreshComponentForCell(int rowNumber, int columnId, bool isRowSelected, Component* existingComponentToUpdate)
-{
-    if (columnId == 2) // Delete button column
-    {
-        auto* deleteButton = dynamic_cast<TextButton*>(existingComponentToUpdate);
-        if (!deleteButton)
-        {
-            deleteButton = new TextButton("X");
-            deleteButton->setColour(TextButton::buttonColourId, Colours::red);
-            deleteButton->onClick = [this, rowNumber]() { deleteTrack(rowNumber); };
-        }
-        return deleteButton;
-    }
-    return nullptr;
-}
-
-
-
-void MusicLibrary::deleteTrack(int rowNumber)
-{
-    if (rowNumber >= 0 && rowNumber < displayedTracks.size())
-    {
-        File trackToDelete = displayedTracks[rowNumber];
-        tracks.erase(std::remove(tracks.begin(), tracks.end(), trackToDelete), tracks.end());
-        displayedTracks.erase(displayedTracks.begin() + rowNumber);
-
-        saveLibrary();
-        table.updateContent();
-    }
-}
-
-
-// Load & Save Library
-void MusicLibrary::loadLibrary()
-{
-    tracks.clear();
-    displayedTracks.clear();
-
-    File libraryFile(libraryFilePath);
-    if (libraryFile.existsAsFile())
-    {
-        StringArray lines;
-        libraryFile.readLines(lines);
-
-        for (const auto& line : lines)
-        {
-            File track(line.trim());
-            if (track.existsAsFile())
-            {
-                tracks.push_back(track);
-            }
-            else
-            {
-                DBG("❌ Skipping invalid file: " + track.getFullPathName());
-            }
-        }
-    }
-
-    displayedTracks = tracks;
-    saveLibrary();
-    table.updateContent();
-}
-
-
-void MusicLibrary::saveLibrary()
-{
-    File libraryFile(libraryFilePath);
-    String data;
-
-    for (const auto& track : tracks)
-        data += track.getFullPathName() + "\n";
-
-    libraryFile.replaceWithText(data);  // ✅ More reliable than deleteFile() + create()
-}
-
-
-
-
-void MusicLibrary::buttonClicked(Button* button)
-{
-    if (button == &addButton)
-    {
-        // Apply a subtle animation or highlight when the button is clicked
-        addButton.setColour(TextButton::buttonOnColourId, Colours::lightgreen);
-
-        DBG("Add Music Button Clicked!");
-
-        MessageManager::callAsync([this]()
-            {
-                DBG("Launching FileChooser...");
-                fileChooser = std::make_unique<FileChooser>("Select Audio Files", File(), "*.mp3;*.wav");
-
-                fileChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectMultipleItems,
-                    [this](const FileChooser& fc)
-                    {
-                        DBG("Inside FileChooser callback!");
-                        auto results = fc.getResults();
-
-                        if (results.isEmpty())
-                        {
-                            DBG("No files selected.");
-                            return;
-                        }
-
-                        DBG("Files selected!");
-                        for (const auto& file : results)
-                        {
-                            // ✅ Check if the file is already in the list before adding
-                            bool exists = std::any_of(tracks.begin(), tracks.end(),
-                                [&file](const File& existingFile)
-                                {
-                                    return existingFile.getFullPathName() == file.getFullPathName();
-                                });
-
-                            if (!exists)
-                            {
-                                DBG("Adding file: " + file.getFullPathName());
-                                tracks.push_back(file);
-                            }
-                            else
-                            {
-                                DBG("File already exists, skipping: " + file.getFullPathName());
-                            }
-                        }
-
-                        displayedTracks = tracks;
-                        saveLibrary();
-                        table.updateContent();
-                        DBG("Library updated!");
-                    });
-            });
-    }
-}
-
-
-// Search Functionality
-void MusicLibrary::textEditorTextChanged(TextEditor& textEditor)
-{
-    String searchText = searchBox.getText().trim();
-
-    if (searchText.isEmpty())
-    {
-        displayedTracks = tracks;
-    }
-    else
-    {
-        displayedTracks.clear();
-        for (const auto& track : tracks)
-        {
-            if (track.getFileNameWithoutExtension().containsIgnoreCase(searchText))
-                displayedTracks.push_back(track);
-        }
-
-        if (displayedTracks.empty())
-        {
-            DBG("No matching tracks found!");
-        }
-    }
-
-    table.updateContent();
-}
-
-
-
-
-// Load Music into Deck
-void MusicLibrary::cellClicked(int rowNumber, int columnId, const MouseEvent& e)
-{
-    if (rowNumber >= 0 && rowNumber < displayedTracks.size())
-    {
-        File selectedFile = displayedTracks[rowNumber];
-
-        DBG("Track selected: " + selectedFile.getFileName());
-
-        if (onTrackSelected) // If DeckGUI is connected, notify it
-        {
-            onTrackSelected(selectedFile);
-        }
-    }
-}
-
-void MusicLibrary::fileSelected(const File& file)
-{
-    DBG("✅ MusicLibrary - Selected track: " + file.getFullPathName());
-
-    if (file.getFullPathName().isEmpty())
-    {
-        DBG("❌ MusicLibrary - Error: File path is empty!");
-        return;
-    }
-
-    if (!file.existsAsFile())
-    {
-        DBG("❌ MusicLibrary - Error: File does not exist! " + file.getFullPathName());
-        return;
-    }
-
-    if (onTrackSelected)
-    {
-        onTrackSelected(file);
-    }
-}
+#include "MusicLibrary.h"
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Tracer.h"
+
+MusicLibrary::MusicLibrary()
+{
+    std::cout << "MusicLibrary initialized!" << std::endl;
+    // Configure table
+    addAndMakeVisible(table);
+    table.setModel(this);
+    table.setHeaderHeight(30);
+
+    // Add columns without fixed width (we'll set them in resized())
+    table.getHeader().addColumn("Track Name", 1, 100); // Placeholder width
+    table.getHeader().addColumn("Delete", 2, 80);      // Fixed width
+    table.getHeader().addColumn("Queue", 3, 80);       // Fixed width
+
+    // Add search box
+    addAndMakeVisible(searchBox);
+    searchBox.setTextToShowWhenEmpty("Search for a track...", Colours::grey);
+    searchBox.addListener(this);
+
+    // Add button
+    addAndMakeVisible(addButton);
+    addButton.addListener(this);
+
+    // Load saved library
+    loadLibrary();
+}
+
+MusicLibrary::~MusicLibrary() {}
+
+void MusicLibrary::paint(Graphics& g)
+{
+    TRACE_SPAN("MusicLibrary::paint");
+
+    // Apply a gradient background to the music library
+    ColourGradient gradient(Colours::midnightblue, 0.0f, 0.0f, Colours::darkslateblue, getWidth(), getHeight(), false);
+    g.setGradientFill(gradient);
+    g.fillAll();
+
+    // Apply a soft shadow effect for the search box and button
+    g.setColour(Colours::black.withAlpha(0.2f));
+    g.fillRoundedRectangle(searchBox.getBounds().toFloat(), 8.0f);
+    g.fillRoundedRectangle(addButton.getBounds().toFloat(), 8.0f);
+
+  
+    //// Add smooth fade-in effect for text (e.g., "Add Music" button)
+    g.setColour(Colours::green.withAlpha(0.8f));
+    g.setFont(18.0f);
+    g.drawText("Add Music", addButton.getBounds(), Justification::centred, true);
+
+    //// Optional: Add some subtle hover effect for the button (optional)
+    if (addButton.isMouseOver())
+    {
+        g.setColour(Colours::green.withAlpha(0.6f));
+        g.setFont(18.0f);
+        g.drawText("Add Music", addButton.getBounds(), Justification::centred, true);
+    }
+}
+
+
+void MusicLibrary::resized()
+{
+    // Animations for resizing with smooth transitions
+    const int margin = 10;
+    const int buttonWidth = 80;
+    const int buttonHeight = 30;
+
+    int tableWidth = getWidth();  // Get available width
+    int deleteColumnWidth = 80;   // Fixed width for delete button
+    int queueColumnWidth = 80;    // Fixed width for queue button
+    int trackColumnWidth = tableWidth - deleteColumnWidth - queueColumnWidth - 20; // Remaining width
+
+    table.getHeader().setColumnWidth(1, trackColumnWidth);
+    table.getHeader().setColumnWidth(2, deleteColumnWidth);
+    table.getHeader().setColumnWidth(3, queueColumnWidth);
+
+    // Search box should be responsive
+    searchBox.setBounds(margin, margin, getWidth() - buttonWidth - 2 * margin, buttonHeight);
+
+    // Button with smooth shadow effect
+    addButton.setBounds(getWidth() - buttonWidth - margin, margin, buttonWidth, buttonHeight);
+
+    // Table should take the remaining height and width
+    table.setBounds(margin, margin + buttonHeight + 10, getWidth() - 2 * margin, getHeight() - margin - buttonHeight - 20);
+    //table.getViewport()->getViewedComponent()->removeAllChildren();
+
+    table.updateContent();
+    table.repaint();       // Redraws the table
+
+}
+
+
+// Table methods
+int MusicLibrary::getNumRows()
+{
+    return collection.getTracks().size();
+}
+
+void MusicLibrary::paintRowBackground(Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
+{
+    if (rowIsSelected)
+    {
+        g.setColour(Colours::red.withAlpha(0.5f)); // Better contrast for selected row
+    }
+    else
+    {
+        g.setColour(rowNumber % 2 == 0 ? Colours::green.withAlpha(0.4f) : Colours::blue.withAlpha(0.4f));
+    }
+
+    g.fillRect(0, 0, width, height);
+}
+
+
+
+
+void MusicLibrary::paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool rowSelected)
+{
+    TRACE_SPAN("MusicLibrary::paintCell");
+
+    if (rowNumber < displayedTracks.size())
+    {
+        if (columnId == 1 && displayedTracks[rowNumber] == previewTrack)
+        {
+            g.setColour(Colours::cyan); // Playing in the headphones
+            g.drawText(String::fromUTF8("\xe2\x96\xb6 ") + displayedTracks[rowNumber].getFileName(),
+                       2, 0, width - 4, height, Justification::centredLeft);
+            return;
+        }
+
+        auto duplicate = duplicates.find(displayedTracks[rowNumber].getFullPathName());
+
+        if (duplicate != duplicates.end())
+        {
+            g.setColour(Colours::orange); // Same recording as another track
+            g.drawText(displayedTracks[rowNumber].getFileName() + "  (duplicate of " + duplicate->second.getFileName() + ")",
+                       2, 0, width - 4, height, Justification::centredLeft);
+            return;
+        }
+
+        g.setColour(Colours::white);
+        g.drawText(displayedTracks[rowNumber].getFileName(), 2, 0, width - 4, height, Justification::centredLeft);
+    }
+    else
+    {
+        g.setColour(Colours::grey);
+        g.drawText("No Tracks Available", 2, 0, width - 4, height, Justification::centredLeft);
+    }
+}
+
+
+Component* MusicLibrary::refreshComponentForCell(int rowNumber, int columnId, bool isRowSelected, Component* existingComponentToUpdate)
+{
+    if (columnId == 2) // Delete button column
+    {
+        auto* deleteButton = dynamic_cast<TextButton*>(existingComponentToUpdate);
+        if (!deleteButton)
+        {
+            deleteButton = new TextButton("X");
+            deleteButton->setColour(TextButton::buttonColourId, Colours::red);
+            deleteButton->onClick = [this, rowNumber]() { deleteTrack(rowNumber); };
+        }
+        return deleteButton;
+    }
+    if (columnId == 3) // Add to Auto DJ queue column
+    {
+        auto* queueButton = dynamic_cast<TextButton*>(existingComponentToUpdate);
+        if (!queueButton)
+        {
+            queueButton = new TextButton("+");
+            queueButton->setColour(TextButton::buttonColourId, Colours::darkgreen);
+        }
+        queueButton->onClick = [this, rowNumber]()
+        {
+            if (rowNumber < displayedTracks.size() && onTrackQueued)
+                onTrackQueued(displayedTracks[rowNumber]);
+        };
+        return queueButton;
+    }
+    return nullptr;
+}
+
+
+
+void MusicLibrary::deleteTrack(int rowNumber)
+{
+    if (rowNumber >= 0 && rowNumber < displayedTracks.size())
+    {
+        File trackToDelete = displayedTracks[rowNumber];
+        collection.remove(trackToDelete);
+        displayedTracks.erase(displayedTracks.begin() + rowNumber);
+
+        saveLibrary();
+        table.updateContent();
+    }
+}
+
+
+void MusicLibrary::setDuplicates(std::map<String, File> duplicateOf)
+{
+    if (duplicateOf == duplicates)
+        return;
+
+    duplicates = std::move(duplicateOf);
+    table.repaint();
+}
+
+
+std::vector<File> MusicLibrary::getTracksAroundView(int extraRows) const
+{
+    std::vector<File> around;
+    auto numRows = (int) displayedTracks.size();
+    auto* viewport = table.getViewport();
+
+    if (numRows == 0 || viewport == nullptr)
+        return around;
+
+    auto rowHeight = jmax(1, table.getRowHeight());
+    auto first = jlimit(0, numRows - 1, viewport->getViewPositionY() / rowHeight);
+    auto last = jlimit(first, numRows - 1, (viewport->getViewPositionY() + viewport->getViewHeight()) / rowHeight);
+
+    for (int row = first; row <= last; ++row)
+        around.push_back(displayedTracks[row]);
+
+    // Then outwards, one row below and one above at a time
+    for (int distance = 1; distance <= extraRows; ++distance)
+    {
+        if (last + distance < numRows)
+            around.push_back(displayedTracks[last + distance]);
+
+        if (first - distance >= 0)
+            around.push_back(displayedTracks[first - distance]);
+    }
+
+    return around;
+}
+
+void MusicLibrary::setPreviewTrack(const File& file)
+{
+    if (file == previewTrack)
+        return;
+
+    previewTrack = file;
+    table.repaint();
+}
+
+
+// Load & Save Library
+void MusicLibrary::loadLibrary()
+{
+    TRACE_SPAN("MusicLibrary::loadLibrary");
+
+    collection.load();
+    displayedTracks = collection.getTracks();
+    saveLibrary();
+    table.updateContent();
+}
+
+
+void MusicLibrary::saveLibrary()
+{
+    TRACE_SPAN("MusicLibrary::saveLibrary");
+
+    collection.save();
+
+    if (onLibraryChanged)
+        onLibraryChanged();
+}
+
+
+
+
+void MusicLibrary::buttonClicked(Button* button)
+{
+    if (button == &addButton)
+    {
+        // Apply a subtle animation or highlight when the button is clicked
+        addButton.setColour(TextButton::buttonOnColourId, Colours::lightgreen);
+
+        DBG("Add Music Button Clicked!");
+
+        MessageManager::callAsync([this]()
+            {
+                DBG("Launching FileChooser...");
+                fileChooser = std::make_unique<FileChooser>("Select Audio Files", File(), "*.mp3;*.wav");
+
+                fileChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectMultipleItems,
+                    [this](const FileChooser& fc)
+                    {
+                        DBG("Inside FileChooser callback!");
+                        auto results = fc.getResults();
+
+                        if (results.isEmpty())
+                        {
+                            DBG("No files selected.");
+                            return;
+                        }
+
+                        DBG("Files selected!");
+                        // ✅ Files already in the library are skipped
+                        auto numAdded = collection.add(results);
+                        DBG("Added " + String(numAdded) + " of " + String(results.size()) + " files");
+
+                        displayedTracks = collection.getTracks();
+                        saveLibrary();
+                        table.updateContent();
+                        DBG("Library updated!");
+                    });
+            });
+    }
+}
+
+
+// Search Functionality
+void MusicLibrary::textEditorTextChanged(TextEditor& textEditor)
+{
+    TRACE_SPAN("MusicLibrary search");
+
+    displayedTracks = collection.search(searchBox.getText());
+
+    if (displayedTracks.empty() && searchBox.getText().trim().isNotEmpty())
+    {
+        DBG("No matching tracks found!");
+    }
+
+    table.updateContent();
+}
+
+
+
+
+// Preview in the headphones, starting as far into the track as the click is across its name
+void MusicLibrary::cellClicked(int rowNumber, int columnId, const MouseEvent& e)
+{
+    if (columnId != 1 || rowNumber < 0 || rowNumber >= displayedTracks.size())
+        return;
+
+    auto position = (double) e.x / (double) jmax(1, table.getHeader().getColumnWidth(1));
+
+    if (onTrackPreviewed)
+        onTrackPreviewed(displayedTracks[rowNumber], jlimit(0.0, 1.0, position));
+}
+
+// Load Music into Deck
+void MusicLibrary::cellDoubleClicked(int rowNumber, int columnId, const MouseEvent& e)
+{
+    if (rowNumber >= 0 && rowNumber < displayedTracks.size())
+    {
+        File selectedFile = displayedTracks[rowNumber];
+
+        DBG("Track selected: " + selectedFile.getFileName());
+
+        if (onTrackSelected) // If DeckGUI is connected, notify it
+        {
+            onTrackSelected(selectedFile);
+        }
+    }
+}
+
+void MusicLibrary::fileSelected(const File& file)
+{
+    DBG("✅ MusicLibrary - Selected track: " + file.getFullPathName());
+
+    if (file.getFullPathName().isEmpty())
+    {
+        DBG("❌ MusicLibrary - Error: File path is empty!");
+        return;
+    }
+
+    if (!file.existsAsFile())
+    {
+        DBG("❌ MusicLibrary - Error: File does not exist! " + file.getFullPathName());
+        return;
+    }
+
+    if (onTrackSelected)
+    {
+        onTrackSelected(file);
+    }
+}
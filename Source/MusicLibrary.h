@@ -1,49 +1,63 @@
-#pragma once
-
-#include "../JuceLibraryCode/JuceHeader.h"
-
-class MusicLibrary : public Component,
-    public TableListBoxModel,
-    public Button::Listener,
-    public TextEditor::Listener
-{
-public:
-    MusicLibrary();
-    ~MusicLibrary();
-
-    void paint(Graphics&) override;
-    void resized() override;
-
-    // Table methods
-    int getNumRows() override;
-    void paintRowBackground(Graphics&, int rowNumber, int width, int height, bool rowIsSelected) override;
-    void paintCell(Graphics&, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
-    void cellClicked(int rowNumber, int columnId, const MouseEvent&) override; // Load Music into Deck
-    Component* refreshComponentForCell(int rowNumber, int columnId, bool isRowSelected, Component* existingComponentToUpdate) override;
-
-    void fileSelected(const File& file);
-    std::function<void(const File&)> onTrackSelected; // Callback for DeckGUI
-
-    // Load & Save Library
-    void loadLibrary();
-    void saveLibrary();
-
-    // Button & TextEditor events
-    void buttonClicked(Button* button) override;
-    void textEditorTextChanged(TextEditor& textEditor) override;
-    std::unique_ptr<FileChooser> fileChooser;
-     
-
-private:
-    TableListBox table;
-    TextButton addButton{ "Add Music" };
-    TextEditor searchBox;
-    std::vector<File> tracks;
-    String libraryFilePath;
-    std::vector<File> displayedTracks; // Stores filtered tracks for display
-    std::map<int, std::unique_ptr<TextButton>> deleteButtons; // Delete buttons for each track
-
-    void deleteTrack(int rowNumber);
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MusicLibrary)
-};
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "TrackCollection.h"
+
+class MusicLibrary : public Component,
+    public TableListBoxModel,
+    public Button::Listener,
+    public TextEditor::Listener
+{
+public:
+    MusicLibrary();
+    ~MusicLibrary();
+
+    void paint(Graphics&) override;
+    void resized() override;
+
+    // Table methods
+    int getNumRows() override;
+    void paintRowBackground(Graphics&, int rowNumber, int width, int height, bool rowIsSelected) override;
+    void paintCell(Graphics&, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
+    void cellClicked(int rowNumber, int columnId, const MouseEvent&) override; // Preview in the headphones
+    void cellDoubleClicked(int rowNumber, int columnId, const MouseEvent&) override; // Load Music into Deck
+    Component* refreshComponentForCell(int rowNumber, int columnId, bool isRowSelected, Component* existingComponentToUpdate) override;
+
+    void fileSelected(const File& file);
+    std::function<void(const File&)> onTrackSelected; // Callback for DeckGUI
+    std::function<void(const File&)> onTrackQueued; // Callback for the Auto DJ queue
+    std::function<void(const File&, double)> onTrackPreviewed; // Track and where along it was clicked, 0 to 1
+    std::function<void()> onLibraryChanged; // Called after tracks are added or removed
+
+    const std::vector<File>& getTracks() const { return collection.getTracks(); }
+    /** flag tracks that are another copy of a library track, keyed by full path */
+    void setDuplicates(std::map<String, File> duplicateOf);
+    /** the visible rows' tracks from the top, then up to extraRows either side, nearest first */
+    std::vector<File> getTracksAroundView(int extraRows) const;
+    /** mark the track playing in the preview, or pass File() when nothing is */
+    void setPreviewTrack(const File& file);
+
+    // Load & Save Library
+    void loadLibrary();
+    void saveLibrary();
+
+    // Button & TextEditor events
+    void buttonClicked(Button* button) override;
+    void textEditorTextChanged(TextEditor& textEditor) override;
+    std::unique_ptr<FileChooser> fileChooser;
+     
+
+private:
+    TableListBox table;
+    TextButton addButton{ "Add Music" };
+    TextEditor searchBox;
+    TrackCollection collection; // Every track, saved to the library file
+    std::vector<File> displayedTracks; // Stores filtered tracks for display
+    std::map<int, std::unique_ptr<TextButton>> deleteButtons; // Delete buttons for each track
+    std::map<String, File> duplicates; // Copies of another library track, by path
+    File previewTrack; // Playing in the headphones
+
+    void deleteTrack(int rowNumber);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MusicLibrary)
+};
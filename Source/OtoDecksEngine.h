@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    OtoDecksEngine.h
+    Created: 23 Oct 2026 5:31:12pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/*
+    Everything in the otodecks_engine library, for tools that link it without
+    the GUI: decks and their sources, the mixer, loading and analysis, and the
+    library's track list.
+
+    A deck is a DJAudioPlayer, mixed by a DJMixer that is pulled like any
+    other AudioSource. Analysis, duplicate detection and snippet decoding run
+    on their own threads; their results arrive on the message thread, so a
+    headless tool needs a ScopedJuceInitialiser_GUI (from juce_events) for as
+    long as it uses them.
+*/
+#include "DJAudioPlayer.h"
+#include "DJMixer.h"
+#include "MasterClock.h"
+#include "SessionRecorder.h"
+#include "AutoDJ.h"
+#include "MidiController.h"
+#include "Recommender.h"
+#include "DuplicateFinder.h"
+#include "SnippetCache.h"
+#include "LibraryPreview.h"
+#include "TrackCollection.h"
+#include "SessionSnapshot.h"
+#include "MemoryBudget.h"
+#include "SamplerBank.h"
+#include "Automation.h"
+#include "Tracer.h"
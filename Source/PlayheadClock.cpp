@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    PlayheadClock.cpp
+    Created: 20 Oct 2026 6:05:19pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "PlayheadClock.h"
+
+namespace
+{
+    // never extrapolate further than this past the last snapshot, in case the device has stalled
+    const double maxExtrapolationMs = 100.0;
+
+    double extrapolate(const PlayheadClock::Snapshot& snapshot, double latencyMs)
+    {
+        auto elapsedMs = jlimit(0.0, maxExtrapolationMs, Time::getMillisecondCounterHiRes() - snapshot.hostTimeMs) - latencyMs;
+        return jlimit(0.0, snapshot.lengthSeconds, snapshot.positionSeconds + snapshot.rate * elapsedMs * 0.001);
+    }
+}
+
+PlayheadClock::PlayheadClock()
+{
+}
+
+void PlayheadClock::publish(double positionSeconds, double lengthSeconds, double newRate)
+{
+    auto count = sequence.load(std::memory_order_relaxed);
+    sequence.store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    position.store(positionSeconds, std::memory_order_relaxed);
+    length.store(lengthSeconds, std::memory_order_relaxed);
+    rate.store(newRate, std::memory_order_relaxed);
+    hostTime.store(Time::getMillisecondCounterHiRes(), std::memory_order_relaxed);
+
+    sequence.store(count + 2, std::memory_order_release);
+}
+
+PlayheadClock::Snapshot PlayheadClock::read() const
+{
+    Snapshot snapshot;
+
+    for (;;)
+    {
+        auto before = sequence.load(std::memory_order_acquire);
+
+        if ((before & 1) == 0)
+        {
+            snapshot.positionSeconds = position.load(std::memory_order_relaxed);
+            snapshot.lengthSeconds = length.load(std::memory_order_relaxed);
+            snapshot.rate = rate.load(std::memory_order_relaxed);
+            snapshot.hostTimeMs = hostTime.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == before)
+                return snapshot;
+        }
+
+        // the audio thread is part way through a write, which takes nanoseconds
+        Thread::yield();
+    }
+}
+
+double PlayheadClock::getPositionSeconds() const
+{
+    auto snapshot = read();
+    return snapshot.lengthSeconds > 0.0 ? extrapolate(snapshot, outputLatencyMs.load()) : 0.0;
+}
+
+double PlayheadClock::getPositionRelative() const
+{
+    auto snapshot = read();
+    return snapshot.lengthSeconds > 0.0 ? extrapolate(snapshot, outputLatencyMs.load()) / snapshot.lengthSeconds : 0.0;
+}
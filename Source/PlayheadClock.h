@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    PlayheadClock.h
+    Created: 20 Oct 2026 6:05:19pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Hands a deck's playhead from the audio thread to the GUI without locks.
+
+    Once per block, after rendering it, the audio thread publishes where the
+    block started in the track, how fast it is moving and the host time it was
+    published at, about when the block goes to the device. The fields sit behind a
+    sequence counter (a seqlock): the writer makes it odd while it writes and
+    even again when done, and a reader retries until it sees the same even
+    value either side of its copy. The writer never waits.
+
+    The GUI then extrapolates from the latest snapshot by the time elapsed
+    since it was taken, so the playhead moves smoothly at the display's rate
+    instead of stepping once per audio block. It is set back by the output
+    latency, so it shows what is being heard rather than what was rendered.
+*/
+class PlayheadClock
+{
+public:
+    struct Snapshot
+    {
+        double positionSeconds = 0.0;
+        double lengthSeconds = 0.0;
+        double rate = 0.0;          // seconds of track per second of real time, negative backwards
+        double hostTimeMs = 0.0;    // Time::getMillisecondCounterHiRes() when taken
+    };
+
+    PlayheadClock();
+
+    /** audio thread: once a block is rendered, publish where it started */
+    void publish(double positionSeconds, double lengthSeconds, double rate);
+
+    /** how long after rendering the audio reaches the speakers, such as the master limiter's delay */
+    void setOutputLatency(double seconds) { outputLatencyMs = seconds * 1000.0; }
+
+    /** any thread: a consistent copy of the latest snapshot */
+    Snapshot read() const;
+
+    /** the playhead now, extrapolated from the latest snapshot and clamped to the track */
+    double getPositionSeconds() const;
+    /** as getPositionSeconds, as a proportion of the track; 0 when nothing is loaded */
+    double getPositionRelative() const;
+
+private:
+    std::atomic<uint32> sequence{ 0 };
+    std::atomic<double> position{ 0.0 }, length{ 0.0 }, rate{ 0.0 }, hostTime{ 0.0 };
+    std::atomic<double> outputLatencyMs{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayheadClock)
+};
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    RecommendationPanel.cpp
+    Created: 21 Oct 2026 11:03:15am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "RecommendationPanel.h"
+
+namespace
+{
+    const int maxRecommendations = 25;
+}
+
+RecommendationPanel::RecommendationPanel(Recommender& _recommender)
+    : recommender(_recommender)
+{
+    list.setModel(this);
+    list.setRowHeight(24);
+    list.setColour(ListBox::backgroundColourId, Colours::transparentBlack);
+    addAndMakeVisible(list);
+
+    statusLabel.setColour(Label::textColourId, Colours::white);
+    statusLabel.setJustificationType(Justification::centredLeft);
+    addAndMakeVisible(statusLabel);
+
+    startTimer(500);
+    timerCallback();
+}
+
+RecommendationPanel::~RecommendationPanel()
+{
+    stopTimer();
+}
+
+void RecommendationPanel::paint(Graphics& g)
+{
+    ColourGradient gradient(Colours::darkslateblue, 0.0f, 0.0f, Colours::midnightblue, getWidth(), getHeight(), false);
+    g.setGradientFill(gradient);
+    g.fillAll();
+
+    g.setColour(Colours::darkgrey);
+    g.drawRect(getLocalBounds(), 1);
+}
+
+void RecommendationPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(10);
+    statusLabel.setBounds(bounds.removeFromTop(30));
+    bounds.removeFromTop(10);
+    list.setBounds(bounds);
+}
+
+void RecommendationPanel::setReference(const File& file, const TrackAnalysis& deckAnalysis)
+{
+    // the deck's own analysis is the most complete; the matrix will do until it lands
+    auto analysed = deckAnalysis.hasMixPoints();
+
+    if (file == referenceFile && (referenceFromDeck || !analysed))
+        return;
+
+    referenceFile = file;
+    referenceFromDeck = analysed;
+
+    if (analysed)
+    {
+        reference = deckAnalysis;
+        recommender.setFeatures(file, deckAnalysis);
+        haveReference = true;
+    }
+    else if (auto row = recommender.indexOf(file); row >= 0)
+    {
+        reference = recommender.getFeatures(row);
+        haveReference = true;
+    }
+    else
+    {
+        haveReference = false;
+    }
+
+    refresh();
+}
+
+void RecommendationPanel::refresh()
+{
+    matches.clear();
+
+    if (haveReference)
+    {
+        auto startTime = Time::getMillisecondCounterHiRes();
+        matches = recommender.findNearest(reference, referenceFile, maxRecommendations);
+        DBG("RecommendationPanel - " + String(recommender.getNumTracks()) + " tracks ranked in "
+            + String(Time::getMillisecondCounterHiRes() - startTime, 2) + " ms");
+    }
+
+    String status;
+
+    if (referenceFile == File())
+        status = "Play next: load a deck";
+    else if (!haveReference)
+        status = "Play next: analysing " + referenceFile.getFileNameWithoutExtension() + "...";
+    else
+        status = "Play next after " + referenceFile.getFileNameWithoutExtension()
+               + " (" + String(reference.bpm, 1) + " BPM, " + TrackAnalyser::getCamelotName(reference.key) + ")";
+
+    if (recommender.getNumPending() > 0)
+        status << "  [" << recommender.getNumPending() << " to analyse]";
+
+    statusLabel.setText(status, dontSendNotification);
+    list.updateContent();
+    list.repaint();
+}
+
+void RecommendationPanel::timerCallback()
+{
+    if (recommender.collectResults())
+    {
+        // the reference itself may just have been analysed
+        if (!haveReference && referenceFile != File())
+        {
+            if (auto row = recommender.indexOf(referenceFile); row >= 0)
+            {
+                reference = recommender.getFeatures(row);
+                haveReference = true;
+            }
+        }
+
+        refresh();
+    }
+}
+
+//==============================================================================
+int RecommendationPanel::getNumRows()
+{
+    return matches.size();
+}
+
+void RecommendationPanel::paintListBoxItem(int rowNumber, Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (!isPositiveAndBelow(rowNumber, matches.size()))
+        return;
+
+    g.setColour(rowIsSelected ? Colours::red.withAlpha(0.5f)
+                              : (rowNumber % 2 == 0 ? Colours::green.withAlpha(0.4f) : Colours::blue.withAlpha(0.4f)));
+    g.fillRect(0, 0, width, height);
+
+    auto index = matches[rowNumber].index;
+    auto features = recommender.getFeatures(index);
+    auto details = (features.bpm > 0.0 ? String(features.bpm, 1) : String("---")) + "  "
+                 + TrackAnalyser::getCamelotName(features.key);
+
+    g.setColour(Colours::white);
+    g.drawText(recommender.getFile(index).getFileNameWithoutExtension(), 4, 0, width - 100, height, Justification::centredLeft);
+    g.setColour(Colours::orange);
+    g.drawText(details, width - 96, 0, 92, height, Justification::centredRight);
+}
+
+void RecommendationPanel::listBoxItemClicked(int row, const MouseEvent&)
+{
+    if (isPositiveAndBelow(row, matches.size()) && onTrackSelected)
+        onTrackSelected(recommender.getFile(matches[row].index));
+}
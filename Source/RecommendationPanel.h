@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    RecommendationPanel.h
+    Created: 21 Oct 2026 11:03:15am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Recommender.h"
+
+//==============================================================================
+/*
+    "Play next" list beside the music library: the library tracks that would
+    follow the track on the active deck best, with their tempo and key.
+    Clicking one loads it like a library row.
+*/
+class RecommendationPanel : public Component,
+                            public ListBoxModel,
+                            public Timer
+{
+public:
+    RecommendationPanel(Recommender& recommender);
+    ~RecommendationPanel();
+
+    void paint(Graphics&) override;
+    void resized() override;
+
+    /** the track to recommend for; its features come from the deck's analysis when that
+        has finished, otherwise from the library's feature matrix */
+    void setReference(const File& file, const TrackAnalysis& deckAnalysis);
+
+    std::function<void(const File&)> onTrackSelected; // Callback for loading a recommendation
+
+    // ListBox methods
+    int getNumRows() override;
+    void paintListBoxItem(int rowNumber, Graphics&, int width, int height, bool rowIsSelected) override;
+    void listBoxItemClicked(int row, const MouseEvent&) override;
+
+    /** picks up finished library analysis */
+    void timerCallback() override;
+
+private:
+    void refresh();
+
+    Recommender& recommender;
+    ListBox list;
+    Label statusLabel;
+
+    File referenceFile;
+    TrackAnalysis reference;
+    bool haveReference = false;
+    bool referenceFromDeck = false;
+    Array<Recommender::Match> matches;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RecommendationPanel)
+};
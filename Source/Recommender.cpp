@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+    Recommender.cpp
+    Created: 21 Oct 2026 10:22:48am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "Recommender.h"
+#include "Tracer.h"
+
+namespace
+{
+    const float tempoTolerance = 0.04f;      // log2 of the tempo ratio that costs 1
+    const float maxTempoDifference = 0.115f; // about 8%; further away is out of range
+    const float outOfRange = 1.0e6f;
+    const float unknownTempoCost = 4.0f;
+    const float unknownKeyCost = 1.0f;
+    const float loudnessTolerance = 6.0f;    // dB that costs 1
+    const float energyTolerance = 0.2f;
+
+    /** how far apart two keys are on the Camelot wheel, turned into a cost */
+    float keyCost(int a, int b)
+    {
+        if (!isPositiveAndBelow(a, 24) || !isPositiveAndBelow(b, 24))
+            return unknownKeyCost;
+
+        auto steps = std::abs(TrackAnalyser::getCamelotNumber(a) - TrackAnalyser::getCamelotNumber(b));
+        auto distance = jmin(steps, 12 - steps) + ((a < 12) != (b < 12) ? 1 : 0);
+
+        if (distance == 0) return 0.0f;
+        if (distance == 1) return 0.25f;
+        return 0.5f * (float) (distance * distance);
+    }
+}
+
+//==============================================================================
+/** works through a list of files on the pool thread, handing each analysis back under the lock */
+class Recommender::AnalysisJob : public ThreadPoolJob
+{
+public:
+    AnalysisJob(Recommender& _owner, std::vector<File> _files)
+        : ThreadPoolJob("Library analysis"), owner(_owner), files(std::move(_files))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        for (auto& file : files)
+        {
+            if (shouldExit())
+                return jobHasFinished;
+
+            TrackAnalysis analysis;
+            std::unique_ptr<AudioFormatReader> reader(owner.formatManager.createReaderFor(file));
+
+            if (reader != nullptr)
+                analysis = TrackAnalyser::analyse(*reader, [this] { return shouldExit(); });
+
+            if (shouldExit())
+                return jobHasFinished;
+
+            const ScopedLock sl(owner.resultsLock);
+            owner.results.add({ file, analysis });
+            --owner.numPending;
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    Recommender& owner;
+    std::vector<File> files;
+};
+
+//==============================================================================
+Recommender::Recommender()
+    : MemoryBudget::Consumer("Library metadata", MemoryBudget::Cost::analyse)
+{
+    formatManager.registerBasicFormats();
+    cacheFile = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("music_library_features.txt");
+    loadCache();
+    addToBudget();
+}
+
+Recommender::~Recommender()
+{
+    removeFromBudget();
+    pool.removeAllJobs(true, 5000);
+}
+
+void Recommender::analyseMissing(const std::vector<File>& candidates)
+{
+    std::vector<File> missing;
+
+    for (auto& file : candidates)
+    {
+        auto path = file.getFullPathName();
+
+        if (rowByPath.contains(path) || queuedPaths.contains(path))
+            continue;
+
+        queuedPaths.set(path, true);
+        missing.push_back(file);
+    }
+
+    if (missing.empty())
+        return;
+
+    DBG("Recommender - Analysing " + String((int) missing.size()) + " new tracks");
+    numPending += (int) missing.size();
+    pool.addJob(new AnalysisJob(*this, std::move(missing)), true);
+}
+
+bool Recommender::collectResults()
+{
+    Array<std::pair<File, TrackAnalysis>> arrived;
+
+    {
+        const ScopedLock sl(resultsLock);
+        arrived.swapWith(results);
+    }
+
+    for (auto& row : arrived)
+    {
+        queuedPaths.remove(row.first.getFullPathName());
+        setFeatures(row.first, row.second);
+    }
+
+    appendToCache(arrived);
+    return !arrived.isEmpty();
+}
+
+int Recommender::getNumPending() const
+{
+    return numPending.load();
+}
+
+size_t Recommender::getUsedBytes() const
+{
+    auto bytesPerRow = MemoryBudget::bytesPerPath + 4 * sizeof(float) + sizeof(int8);
+    return files.size() * bytesPerRow + distances.capacity() * sizeof(float);
+}
+
+//==============================================================================
+void Recommender::setFeatures(const File& file, const TrackAnalysis& analysis)
+{
+    auto row = indexOf(file);
+
+    if (row < 0)
+    {
+        row = (int) files.size();
+        files.push_back(file);
+        log2Bpm.push_back(0.0f);
+        hasBpm.push_back(0.0f);
+        keys.push_back(-1);
+        loudness.push_back(0.0f);
+        energies.push_back(0.0f);
+        rowByPath.set(file.getFullPathName(), row);
+    }
+
+    auto i = (size_t) row;
+    log2Bpm[i] = analysis.bpm > 0.0 ? (float) std::log2(analysis.bpm) : 0.0f;
+    hasBpm[i] = analysis.bpm > 0.0 ? 1.0f : 0.0f;
+    keys[i] = (int8) analysis.key;
+    loudness[i] = (float) analysis.loudnessDb;
+    energies[i] = (float) analysis.energy;
+}
+
+int Recommender::indexOf(const File& file) const
+{
+    auto path = file.getFullPathName();
+    return rowByPath.contains(path) ? rowByPath[path] : -1;
+}
+
+TrackAnalysis Recommender::getFeatures(int index) const
+{
+    TrackAnalysis analysis;
+
+    if (isPositiveAndBelow(index, getNumTracks()))
+    {
+        auto i = (size_t) index;
+        analysis.bpm = hasBpm[i] > 0.0f ? std::exp2((double) log2Bpm[i]) : 0.0;
+        analysis.key = keys[i];
+        analysis.loudnessDb = loudness[i];
+        analysis.energy = energies[i];
+    }
+
+    return analysis;
+}
+
+//==============================================================================
+Array<Recommender::Match> Recommender::findNearest(const TrackAnalysis& reference, const File& exclude, int maxResults)
+{
+    TRACE_SPAN("Recommender::findNearest");
+
+    Array<Match> matches;
+    auto numTracks = getNumTracks();
+
+    if (numTracks == 0 || maxResults <= 0)
+        return matches;
+
+    distances.resize((size_t) numTracks);
+
+    // the key term is a lookup into the reference's row of the cost table, indexed by key + 1
+    float keyCosts[25];
+    for (int key = -1; key < 24; ++key)
+        keyCosts[key + 1] = keyCost(reference.key, key);
+
+    // without a reference tempo every track is in range and tempo doesn't count
+    auto tempoWeight = reference.bpm > 0.0 ? 1.0f : 0.0f;
+    auto referenceLog2Bpm = reference.bpm > 0.0 ? (float) std::log2(reference.bpm) : 0.0f;
+    auto referenceLoudness = (float) reference.loudnessDb;
+    auto referenceEnergy = (float) reference.energy;
+
+    const auto* bpmColumn = log2Bpm.data();
+    const auto* hasBpmColumn = hasBpm.data();
+    const auto* keyColumn = keys.data();
+    const auto* loudnessColumn = loudness.data();
+    const auto* energyColumn = energies.data();
+    auto* out = distances.data();
+
+    // one branch-free pass down the columns
+    for (int i = 0; i < numTracks; ++i)
+    {
+        // half and double time count as the same tempo
+        auto octaves = bpmColumn[i] - referenceLog2Bpm;
+        auto tempoOffset = std::abs(octaves - std::round(octaves));
+        auto tempo = tempoOffset / tempoTolerance;
+        auto tempoTerm = tempo * tempo + (tempoOffset > maxTempoDifference ? outOfRange : 0.0f);
+        tempoTerm = tempoWeight * (hasBpmColumn[i] * tempoTerm + (1.0f - hasBpmColumn[i]) * unknownTempoCost);
+
+        auto level = (loudnessColumn[i] - referenceLoudness) / loudnessTolerance;
+        auto energy = (energyColumn[i] - referenceEnergy) / energyTolerance;
+
+        out[i] = tempoTerm + keyCosts[keyColumn[i] + 1] + level * level + energy * energy;
+    }
+
+    auto excluded = indexOf(exclude);
+    if (excluded >= 0)
+        out[excluded] = std::numeric_limits<float>::max();
+
+    // keep the best few in a max-heap; most rows are turned away by one comparison with its top
+    std::vector<std::pair<float, int>> heap;
+    heap.reserve((size_t) maxResults + 1);
+
+    for (int i = 0; i < numTracks; ++i)
+    {
+        if (out[i] >= outOfRange)
+            continue;
+
+        if ((int) heap.size() < maxResults)
+        {
+            heap.push_back({ out[i], i });
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (out[i] < heap.front().first)
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = { out[i], i };
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    for (auto& entry : heap)
+        matches.add({ entry.second, entry.first });
+
+    return matches;
+}
+
+//==============================================================================
+void Recommender::benchmark()
+{
+    const int numTracks = 1000000;
+    const int numQueries = 100;
+    const int maxResults = 20;
+
+    std::cout << "Recommender, " << numTracks << " tracks, best " << maxResults << " of each" << std::endl;
+
+    // the rows are made up in place, so neither the library nor its analysis comes into it
+    Recommender recommender;
+    recommender.rowByPath.clear();
+    recommender.files.assign((size_t) numTracks, File());
+    recommender.log2Bpm.resize((size_t) numTracks);
+    recommender.hasBpm.resize((size_t) numTracks);
+    recommender.keys.resize((size_t) numTracks);
+    recommender.loudness.resize((size_t) numTracks);
+    recommender.energies.resize((size_t) numTracks);
+
+    Random random(20261027);
+
+    for (size_t i = 0; i < (size_t) numTracks; ++i)
+    {
+        recommender.log2Bpm[i] = (float) std::log2(TrackAnalyser::minBpm + (TrackAnalyser::maxBpm - TrackAnalyser::minBpm) * random.nextDouble());
+        recommender.hasBpm[i] = random.nextInt(20) == 0 ? 0.0f : 1.0f;
+        recommender.keys[i] = (int8) (random.nextInt(25) - 1);
+        recommender.loudness[i] = -20.0f + 14.0f * random.nextFloat();
+        recommender.energies[i] = random.nextFloat();
+    }
+
+    auto makeReference = [&random]
+    {
+        TrackAnalysis reference;
+        reference.bpm = TrackAnalyser::minBpm + (TrackAnalyser::maxBpm - TrackAnalyser::minBpm) * random.nextDouble();
+        reference.key = random.nextInt(24);
+        reference.loudnessDb = -20.0 + 14.0 * random.nextDouble();
+        reference.energy = random.nextDouble();
+        return reference;
+    };
+
+    // the first query sizes the scratch space, as the first one in the app does
+    recommender.findNearest(makeReference(), {}, maxResults);
+
+    int64 totalTicks = 0, worstTicks = 0;
+    auto numFound = 0;
+
+    for (int query = 0; query < numQueries; ++query)
+    {
+        auto reference = makeReference();
+        auto start = Time::getHighResolutionTicks();
+        numFound += recommender.findNearest(reference, {}, maxResults).size();
+        auto ticks = Time::getHighResolutionTicks() - start;
+
+        totalTicks += ticks;
+        worstTicks = jmax(worstTicks, ticks);
+    }
+
+    std::cout << "  " << String(Time::highResolutionTicksToSeconds(totalTicks) * 1000.0 / numQueries, 2) << " ms per query, "
+              << String(Time::highResolutionTicksToSeconds(worstTicks) * 1000.0, 2) << " ms at worst, "
+              << numFound / numQueries << " matches each" << std::endl;
+}
+
+//==============================================================================
+void Recommender::loadCache()
+{
+    if (!cacheFile.existsAsFile())
+        return;
+
+    StringArray lines;
+    cacheFile.readLines(lines);
+
+    for (auto& line : lines)
+    {
+        auto fields = StringArray::fromTokens(line, "\t", {});
+
+        if (fields.size() != 5)
+            continue;
+
+        TrackAnalysis analysis;
+        analysis.bpm = fields[1].getDoubleValue();
+        analysis.key = fields[2].getIntValue();
+        analysis.loudnessDb = fields[3].getDoubleValue();
+        analysis.energy = fields[4].getDoubleValue();
+        setFeatures(File(fields[0]), analysis);
+    }
+}
+
+void Recommender::appendToCache(const Array<std::pair<File, TrackAnalysis>>& rows)
+{
+    if (rows.isEmpty())
+        return;
+
+    String data;
+
+    for (auto& row : rows)
+        data << row.first.getFullPathName() << "\t" << row.second.bpm << "\t" << row.second.key << "\t"
+             << row.second.loudnessDb << "\t" << row.second.energy << "\n";
+
+    cacheFile.appendText(data);
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    Recommender.h
+    Created: 21 Oct 2026 10:22:48am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "TrackAnalyser.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    Ranks library tracks by how well they would follow a reference track.
+
+    Every analysed track is one row of a compact feature matrix stored column
+    by column: log2 of the tempo, the key, the loudness and the energy. A
+    query is a single branch-free pass down those columns that the compiler
+    can vectorise, followed by a pass that keeps the best few in a small heap.
+    OtoDecksHeadless --bench-recommender times it over a million tracks.
+
+    The distance counts half and double time as the same tempo and rejects
+    anything more than 8% away. Keys are compared on the Camelot wheel, so the
+    same key, the relative major or minor and the neighbouring keys all score
+    well.
+
+    Library tracks are analysed on a background thread, and only the ones not
+    already in the feature cache are analysed. Results are moved into the
+    matrix on the message thread by collectResults(), and the cache is a text
+    file next to the library list. The matrix counts towards the memory
+    budget but is never evicted.
+*/
+class Recommender : private MemoryBudget::Consumer
+{
+public:
+    struct Match
+    {
+        int index;
+        float distance;
+    };
+
+    Recommender();
+    ~Recommender();
+
+    /** analyses, in the background, any of these files that have no features yet */
+    void analyseMissing(const std::vector<File>& files);
+    /** message thread: moves finished analyses into the matrix; true if any arrived */
+    bool collectResults();
+    int getNumPending() const;
+
+    /** adds or replaces a track's row */
+    void setFeatures(const File& file, const TrackAnalysis& analysis);
+    /** the row for this file, or -1 */
+    int indexOf(const File& file) const;
+    /** the stored features for a row, as an analysis with only those fields filled in */
+    TrackAnalysis getFeatures(int index) const;
+
+    int getNumTracks() const { return (int) files.size(); }
+    const File& getFile(int index) const { return files[(size_t) index]; }
+
+    /** the closest tracks to the reference, best first, leaving out the reference file */
+    Array<Match> findNearest(const TrackAnalysis& reference, const File& exclude, int maxResults);
+
+    /** the matrix, the path lookup and the query scratch space, roughly */
+    size_t getUsedBytes() const override;
+
+    /** times findNearest over a million made-up tracks and prints the cost of a query */
+    static void benchmark();
+
+private:
+    class AnalysisJob;
+
+    void loadCache();
+    void appendToCache(const Array<std::pair<File, TrackAnalysis>>& rows);
+
+    // the feature matrix, one vector per column
+    std::vector<File> files;
+    std::vector<float> log2Bpm;
+    std::vector<float> hasBpm;       // 1 or 0, so the scan needs no branch
+    std::vector<int8> keys;
+    std::vector<float> loudness;
+    std::vector<float> energies;
+    HashMap<String, int> rowByPath;
+
+    // scratch space reused between queries
+    std::vector<float> distances;
+
+    File cacheFile;
+    AudioFormatManager formatManager;
+    ThreadPool pool{ 1 };
+
+    CriticalSection resultsLock;
+    Array<std::pair<File, TrackAnalysis>> results;
+    HashMap<String, bool> queuedPaths;
+    std::atomic<int> numPending{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Recommender)
+};
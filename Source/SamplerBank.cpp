@@ -0,0 +1,499 @@
+/*
+  ==============================================================================
+
+    SamplerBank.cpp
+    Created: 25 Oct 2026 5:12:09pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SamplerBank.h"
+#include "Tracer.h"
+
+namespace
+{
+    const int fadeOutSamples = 256;
+
+    size_t getSampleBytes(int64 numFrames)
+    {
+        return (size_t) numFrames * 2 * sizeof(float);
+    }
+}
+
+//==============================================================================
+/** decodes one pad's file on the pool thread and hands it back under the lock */
+class SamplerBank::DecodeJob : public ThreadPoolJob
+{
+public:
+    DecodeJob(SamplerBank& _owner, int _pad, const File& _file, std::unique_ptr<AudioFormatReader> _reader)
+        : ThreadPoolJob("Sampler decode"), owner(_owner), pad(_pad), file(_file), reader(std::move(_reader))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        TRACE_SPAN("SamplerBank::decode");
+
+        auto sample = std::make_unique<Sample>();
+        auto length = (int) reader->lengthInSamples;
+
+        sample->file = file;
+        sample->sampleRate = reader->sampleRate;
+        sample->audio.setSize(2, length);
+
+        // a mono file is read into both channels; an empty sample tells the pad it failed
+        if (!reader->read(&sample->audio, 0, length, 0, true, true))
+            sample->audio.setSize(2, 0);
+
+        if (shouldExit())
+            return jobHasFinished;
+
+        const ScopedLock sl(owner.resultsLock);
+        owner.results.push_back({ pad, std::move(sample) });
+        return jobHasFinished;
+    }
+
+private:
+    SamplerBank& owner;
+    const int pad;
+    const File file;
+    std::unique_ptr<AudioFormatReader> reader;
+};
+
+//==============================================================================
+SamplerBank::SamplerBank(AudioFormatManager& _formatManager, MasterClock& _clock)
+    : MemoryBudget::Consumer("Sampler pads", MemoryBudget::Cost::decode),
+      formatManager(_formatManager),
+      clock(_clock)
+{
+    addToBudget();
+}
+
+SamplerBank::~SamplerBank()
+{
+    removeFromBudget();
+    pool.removeAllJobs(true, 5000);
+}
+
+bool SamplerBank::loadPad(int pad, const File& file)
+{
+    if (!isPositiveAndBelow(pad, numPads))
+        return false;
+
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0)
+    {
+        DBG("SamplerBank - Can't read " + file.getFileName());
+        return false;
+    }
+
+    if (reader->lengthInSamples > (int64) (maxSampleSeconds * reader->sampleRate))
+    {
+        DBG("SamplerBank - " + file.getFileName() + " is longer than " + String(maxSampleSeconds) + " seconds");
+        return false;
+    }
+
+    // the whole sample lives in memory, so it has to fit alongside everything pinned
+    if (!MemoryBudget::getInstance().makeRoom(getSampleBytes(reader->lengthInSamples), MemoryBudget::Cost::decode, this))
+    {
+        DBG("SamplerBank - No room in the memory budget for " + file.getFileName());
+        return false;
+    }
+
+    pads[pad].loading = file;
+    pool.addJob(new DecodeJob(*this, pad, file, std::move(reader)), true);
+    return true;
+}
+
+void SamplerBank::clearPad(int pad)
+{
+    if (!isPositiveAndBelow(pad, numPads))
+        return;
+
+    auto& target = pads[pad];
+    target.loading = File();
+    target.sample = nullptr;
+    retire(std::move(target.owned));
+}
+
+bool SamplerBank::collectLoaded()
+{
+    std::vector<std::pair<int, std::unique_ptr<Sample>>> arrived;
+
+    {
+        const ScopedLock sl(resultsLock);
+        arrived.swap(results);
+    }
+
+    auto changed = false;
+
+    for (auto& result : arrived)
+    {
+        auto& target = pads[result.first];
+
+        // cleared or loaded with something else while it was decoding
+        if (result.second->file != target.loading)
+            continue;
+
+        target.loading = File();
+        changed = true;
+
+        if (result.second->audio.getNumSamples() == 0)
+        {
+            DBG("SamplerBank - Couldn't decode " + result.second->file.getFileName());
+            continue;
+        }
+
+        retire(std::move(target.owned));
+        target.owned = std::move(result.second);
+        target.sample = target.owned.get();
+    }
+
+    // free whatever the audio thread has had a whole block to let go of
+    auto rendered = blocksRendered.load();
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [rendered](const std::pair<std::unique_ptr<Sample>, int64>& entry)
+                                 {
+                                     return entry.second <= rendered;
+                                 }),
+                  retired.end());
+
+    return changed;
+}
+
+void SamplerBank::retire(std::unique_ptr<Sample> sample)
+{
+    if (sample != nullptr)
+        retired.push_back({ std::move(sample), blocksRendered.load() + 2 });
+}
+
+bool SamplerBank::isLoaded(int pad) const
+{
+    return isPositiveAndBelow(pad, numPads) && pads[pad].owned != nullptr;
+}
+
+bool SamplerBank::isLoading(int pad) const
+{
+    return isPositiveAndBelow(pad, numPads) && pads[pad].loading != File();
+}
+
+File SamplerBank::getFile(int pad) const
+{
+    if (!isPositiveAndBelow(pad, numPads))
+        return {};
+
+    if (pads[pad].loading != File())
+        return pads[pad].loading;
+
+    return pads[pad].owned != nullptr ? pads[pad].owned->file : File();
+}
+
+bool SamplerBank::isSounding(int pad) const
+{
+    return isPositiveAndBelow(pad, numPads) && ((soundingPads.load() >> pad) & 1) != 0;
+}
+
+void SamplerBank::setMode(int pad, Mode mode)
+{
+    if (isPositiveAndBelow(pad, numPads))
+        pads[pad].mode = (int) mode;
+}
+
+SamplerBank::Mode SamplerBank::getMode(int pad) const
+{
+    return isPositiveAndBelow(pad, numPads) ? (Mode) pads[pad].mode.load() : Mode::oneShot;
+}
+
+void SamplerBank::setPadGain(int pad, float gain)
+{
+    if (isPositiveAndBelow(pad, numPads))
+        pads[pad].gain = jmax(0.0f, gain);
+}
+
+bool SamplerBank::trigger(int pad)
+{
+    if (!isPositiveAndBelow(pad, numPads) && pad != stopAllPads)
+        return false;
+
+    if (triggerFifo.getFreeSpace() < 1)
+        return false;
+
+    int start1, size1, start2, size2;
+    triggerFifo.prepareToWrite(1, start1, size1, start2, size2);
+    triggers[size1 > 0 ? start1 : start2] = pad;
+    triggerFifo.finishedWrite(1);
+    return true;
+}
+
+void SamplerBank::stopAll()
+{
+    trigger(stopAllPads);
+}
+
+size_t SamplerBank::getUsedBytes() const
+{
+    size_t total = 0;
+
+    for (auto& pad : pads)
+        if (pad.owned != nullptr)
+            total += getSampleBytes(pad.owned->audio.getNumSamples());
+
+    for (auto& entry : retired)
+        total += getSampleBytes(entry.first->audio.getNumSamples());
+
+    return total;
+}
+
+//==============================================================================
+void SamplerBank::prepareToPlay(int, double sampleRate)
+{
+    outputSampleRate = sampleRate;
+
+    for (auto& voice : voices)
+        voice.sample = nullptr;
+
+    for (auto& voice : fadingVoices)
+        voice.sample = nullptr;
+}
+
+void SamplerBank::releaseResources()
+{
+}
+
+void SamplerBank::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    bufferToFill.clearActiveBufferRegion();
+    applyTriggers();
+
+    uint32 sounding = 0;
+
+    auto render = [&](Voice& voice)
+    {
+        if (voice.sample == nullptr)
+            return;
+
+        // a pad cleared or reloaded drops its voices without touching the old sample again
+        if (pads[voice.pad].sample.load() != voice.sample)
+        {
+            voice.sample = nullptr;
+            return;
+        }
+
+        renderVoice(voice, *bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
+        if (voice.sample != nullptr)
+            sounding |= 1u << voice.pad;
+    };
+
+    for (auto& voice : voices)
+        render(voice);
+
+    for (auto& voice : fadingVoices)
+        render(voice);
+
+    soundingPads = sounding;
+    ++blocksRendered;
+}
+
+void SamplerBank::applyTriggers()
+{
+    auto numReady = triggerFifo.getNumReady();
+
+    if (numReady == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    triggerFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    // every trigger in this block lands on the same step of the grid
+    auto delay = samplesToGrid();
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        auto pad = triggers[i < size1 ? start1 + i : start2 + i - size1];
+
+        if (pad == stopAllPads)
+        {
+            for (auto& voice : voices)
+                fadeOut(voice);
+
+            continue;
+        }
+
+        auto* sample = pads[pad].sample.load();
+
+        if (sample == nullptr)
+            continue;
+
+        auto loop = (Mode) pads[pad].mode.load() == Mode::loop;
+
+        if (loop)
+        {
+            // a second press stops the loop, on the grid like the first
+            auto stopped = false;
+
+            for (auto& voice : voices)
+            {
+                if (voice.sample == nullptr || voice.pad != pad || !voice.loop || voice.stopDelay >= 0 || voice.fadeRemaining > 0)
+                    continue;
+
+                if (voice.startDelay > 0)
+                    voice.sample = nullptr;     // never started, so nothing to fade
+                else
+                    voice.stopDelay = delay;
+
+                stopped = true;
+            }
+
+            if (stopped)
+                continue;
+        }
+
+        auto& voice = allocateVoice();
+        voice.sample = sample;
+        voice.pad = pad;
+        voice.position = 0.0;
+        voice.increment = sample->sampleRate / outputSampleRate;
+        voice.loop = loop;
+        voice.startDelay = delay;
+        voice.stopDelay = -1;
+        voice.fadeRemaining = 0;
+        voice.age = nextAge++;
+    }
+
+    triggerFifo.finishedRead(size1 + size2);
+}
+
+int SamplerBank::samplesToGrid() const
+{
+    auto beats = quantise.load();
+
+    if (beats <= 0.0)
+        return 0;
+
+    // the clock is at the start of this block, as the mixer renders between its begin and end
+    auto position = clock.getBeatPosition();
+    auto next = std::ceil(position / beats) * beats;
+    auto samplesPerBeat = 60.0 / jmax(1.0, clock.getTempo()) * outputSampleRate;
+
+    return jmax(0, roundToInt((next - position) * samplesPerBeat));
+}
+
+SamplerBank::Voice& SamplerBank::allocateVoice()
+{
+    Voice* steal = nullptr;
+
+    for (auto& voice : voices)
+    {
+        if (voice.sample == nullptr)
+            return voice;
+
+        // one already fading out goes first, then the oldest
+        auto fading = voice.fadeRemaining > 0;
+
+        if (steal == nullptr
+            || (fading && steal->fadeRemaining == 0)
+            || (fading == (steal->fadeRemaining > 0) && nextAge - voice.age > nextAge - steal->age))
+            steal = &voice;
+    }
+
+    // the voice taken over carries on from a spare slot just long enough to fade out; with
+    // every spare in use, the one nearest the end of its fade makes way
+    if (steal->startDelay == 0)
+    {
+        auto* spare = &fadingVoices[0];
+
+        for (auto& voice : fadingVoices)
+        {
+            if (voice.sample == nullptr)
+            {
+                spare = &voice;
+                break;
+            }
+
+            if (voice.fadeRemaining < spare->fadeRemaining)
+                spare = &voice;
+        }
+
+        *spare = *steal;
+        fadeOut(*spare);
+    }
+
+    return *steal;
+}
+
+void SamplerBank::fadeOut(Voice& voice)
+{
+    if (voice.sample == nullptr || voice.fadeRemaining > 0)
+        return;
+
+    if (voice.startDelay > 0)
+    {
+        voice.sample = nullptr;     // never started, so nothing to fade
+        return;
+    }
+
+    voice.stopDelay = -1;
+    voice.fadeRemaining = fadeOutSamples;
+}
+
+void SamplerBank::renderVoice(Voice& voice, AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    auto skip = jmin(numSamples, voice.startDelay);
+    voice.startDelay -= skip;
+
+    auto& audio = voice.sample->audio;
+    auto length = audio.getNumSamples();
+    auto* left = audio.getReadPointer(0);
+    auto* right = audio.getReadPointer(1);
+    auto gain = pads[voice.pad].gain.load();
+
+    auto stereo = buffer.getNumChannels() > 1;
+    auto* outLeft = buffer.getWritePointer(0, startSample);
+    auto* outRight = stereo ? buffer.getWritePointer(1, startSample) : nullptr;
+
+    for (int i = skip; i < numSamples; ++i)
+    {
+        if (voice.stopDelay >= 0 && voice.stopDelay-- == 0)
+            voice.fadeRemaining = fadeOutSamples;
+
+        auto index = (int) voice.position;
+        auto next = index + 1 < length ? index + 1 : (voice.loop ? 0 : index);
+        auto fraction = (float) (voice.position - index);
+        auto level = gain * (voice.fadeRemaining > 0 ? (float) voice.fadeRemaining / fadeOutSamples : 1.0f);
+
+        auto l = left[index] + fraction * (left[next] - left[index]);
+        auto r = right[index] + fraction * (right[next] - right[index]);
+
+        if (stereo)
+        {
+            outLeft[i] += level * l;
+            outRight[i] += level * r;
+        }
+        else
+        {
+            outLeft[i] += level * 0.5f * (l + r);
+        }
+
+        if (voice.fadeRemaining > 0 && --voice.fadeRemaining == 0)
+        {
+            voice.sample = nullptr;
+            return;
+        }
+
+        voice.position += voice.increment;
+
+        if (voice.position >= length)
+        {
+            if (!voice.loop)
+            {
+                voice.sample = nullptr;
+                return;
+            }
+
+            voice.position -= length;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    SamplerBank.h
+    Created: 25 Oct 2026 5:12:09pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MasterClock.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    Sixteen pads of one-shots and loops, played from memory.
+
+    A pad's file is decoded whole on a background thread when it is loaded,
+    and nothing is read from disk after that. The samples count towards the
+    memory budget, pinned, and a load that won't fit is refused.
+
+    Voices come from a fixed pool made up front, so nothing is allocated on
+    the audio thread. A trigger takes a free voice, or else takes over the
+    oldest one, which fades out from a spare slot instead of being cut.
+    A one-shot always starts a fresh voice from the top; pressing a loop pad
+    again stops its loop.
+
+    Triggers go through a lock-free FIFO and are picked up at the start of the
+    next block, so a pad sounds one block after it is hit. With quantising on,
+    the voice waits for the next step of the master clock's beat grid, to the
+    sample.
+
+    The bank is added to the DJMixer as a deck of its own, so it goes through
+    the EQ and is summed with the decks in the same pass.
+
+    A replaced sample is kept until the audio thread has moved on from it, and
+    freed on the message thread.
+*/
+class SamplerBank : public AudioSource,
+                    private MemoryBudget::Consumer
+{
+public:
+    static constexpr int numPads = 16;
+    static constexpr int numVoices = 32;
+    static constexpr double maxSampleSeconds = 60.0;
+
+    enum class Mode { oneShot, loop };
+
+    SamplerBank(AudioFormatManager& formatManager, MasterClock& clock);
+    ~SamplerBank() override;
+
+    /** message thread: starts decoding the file into the pad; false if it can't be
+        read, is too long, or won't fit in the memory budget */
+    bool loadPad(int pad, const File& file);
+    /** message thread: stops the pad and frees its sample */
+    void clearPad(int pad);
+    /** message thread: hands finished decodes to their pads and frees samples the audio
+        thread has let go of; true if a pad changed */
+    bool collectLoaded();
+
+    bool isLoaded(int pad) const;
+    bool isLoading(int pad) const;
+    File getFile(int pad) const;
+    /** true while one of the pad's voices is playing or waiting for its beat */
+    bool isSounding(int pad) const;
+
+    void setMode(int pad, Mode mode);
+    Mode getMode(int pad) const;
+    void setPadGain(int pad, float gain);
+
+    /** in beats: 0 plays straight away, 1 waits for the next beat, 4 for the next bar */
+    void setQuantise(double beats) { quantise = jmax(0.0, beats); }
+    double getQuantise() const { return quantise.load(); }
+
+    /** message thread only: fires a pad; false if the FIFO is full */
+    bool trigger(int pad);
+    /** message thread only: fades every voice out from the start of the next block */
+    void stopAll();
+
+    /** the decoded samples; all pinned */
+    size_t getUsedBytes() const override;
+
+    //==============================================================================
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+private:
+    struct Sample
+    {
+        File file;
+        AudioBuffer<float> audio;   // always two channels
+        double sampleRate = 44100.0;
+    };
+
+    struct Pad
+    {
+        std::atomic<const Sample*> sample{ nullptr };
+        std::atomic<int> mode{ (int) Mode::oneShot };
+        std::atomic<float> gain{ 1.0f };
+
+        // message thread only
+        std::unique_ptr<Sample> owned;
+        File loading;
+    };
+
+    struct Voice
+    {
+        const Sample* sample = nullptr;  // nullptr when free
+        int pad = 0;
+        double position = 0.0;           // in the sample's frames
+        double increment = 1.0;
+        bool loop = false;
+        int startDelay = 0;              // samples to wait for the beat grid
+        int stopDelay = -1;              // samples until a loop fades out, -1 while it plays on
+        int fadeRemaining = 0;           // through the fade out, once it has begun
+        uint32 age = 0;
+    };
+
+    static constexpr int stopAllPads = -1;
+    static constexpr int numFadeVoices = 8;
+
+    class DecodeJob;
+
+    /** audio thread: starts or stops voices for the triggers that have arrived */
+    void applyTriggers();
+    /** audio thread: how long until the next step of the beat grid */
+    int samplesToGrid() const;
+    Voice& allocateVoice();
+    /** audio thread: fades a playing voice out, and frees one still waiting for the grid */
+    static void fadeOut(Voice& voice);
+    void renderVoice(Voice& voice, AudioBuffer<float>& buffer, int startSample, int numSamples);
+    void retire(std::unique_ptr<Sample> sample);
+
+    AudioFormatManager& formatManager;
+    MasterClock& clock;
+
+    Pad pads[numPads];
+    std::atomic<double> quantise{ 0.0 };
+
+    // triggers from the message thread, a pad index or stopAllPads
+    AbstractFifo triggerFifo{ 256 };
+    int triggers[256];
+
+    // audio thread only
+    Voice voices[numVoices];
+    Voice fadingVoices[numFadeVoices];  // voices taken over by a new trigger, fading out
+    uint32 nextAge = 0;
+    double outputSampleRate = 44100.0;
+
+    std::atomic<uint32> soundingPads{ 0 };
+    std::atomic<int64> blocksRendered{ 0 };
+
+    // replaced samples, with the block count after which the audio thread can't be using them
+    std::vector<std::pair<std::unique_ptr<Sample>, int64>> retired;
+
+    ThreadPool pool{ 1 };
+    CriticalSection resultsLock;
+    std::vector<std::pair<int, std::unique_ptr<Sample>>> results;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplerBank)
+};
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    SamplerCheck.cpp
+    Created: 27 Oct 2026 4:47:25pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SamplerCheck.h"
+#include "SamplerBank.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 48000.0;
+    const int blockSize = 64;
+    const int sampleLength = 48000;             // a second, longer than anything rendered from one trigger
+    const float level = 1.0f / 64.0f;           // so every voice together is at -6 dB
+    const float tolerance = 1.0e-6f;
+    const int loadTimeoutMs = 5000;
+    const int quantiseAfterBlocks = 100;        // part way through the first beat
+
+    const int levelPad = 0;
+    const int silentPad = 1;
+
+    /** a 32 bit float stereo WAV of one constant value, which reads back exactly */
+    File writeConstantSample(const File& file, float value)
+    {
+        file.deleteFile();
+
+        WavAudioFormat wav;
+        std::unique_ptr<FileOutputStream> stream(new FileOutputStream(file));
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+
+        if (writer == nullptr)
+            return {};
+
+        stream.release(); // the writer owns it now
+
+        AudioBuffer<float> buffer(2, sampleLength);
+        for (int channel = 0; channel < 2; ++channel)
+            FloatVectorOperations::fill(buffer.getWritePointer(channel), value, sampleLength);
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, sampleLength);
+        return file;
+    }
+
+    /** decodes the file into the pad, handing it over on this thread as the message thread would */
+    bool loadPad(SamplerBank& bank, int pad, const File& file)
+    {
+        if (!bank.loadPad(pad, file))
+            return false;
+
+        auto endTime = Time::getMillisecondCounter() + (uint32) loadTimeoutMs;
+
+        while (!bank.isLoaded(pad) && Time::getMillisecondCounter() < endTime)
+        {
+            bank.collectLoaded();
+            Thread::sleep(5);
+        }
+
+        return bank.isLoaded(pad);
+    }
+
+    /** renders blocks between the clock's begin and end, as the mixer does, keeping the left channel */
+    void render(SamplerBank& bank, MasterClock& clock, int numBlocks, std::vector<float>& output)
+    {
+        AudioBuffer<float> block(2, blockSize);
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            clock.beginBlock(blockSize);
+            bank.getNextAudioBlock(AudioSourceChannelInfo(&block, 0, blockSize));
+            clock.endBlock(blockSize);
+
+            for (int n = 0; n < blockSize; ++n)
+                output.push_back(block.getSample(0, n));
+        }
+    }
+
+    /** the biggest jump between neighbouring samples from here on, the one before included */
+    float largestStep(const std::vector<float>& output, size_t from)
+    {
+        auto largest = 0.0f;
+
+        for (auto i = jmax((size_t) 1, from); i < output.size(); ++i)
+            largest = jmax(largest, std::abs(output[i] - output[i - 1]));
+
+        return largest;
+    }
+}
+
+//==============================================================================
+int SamplerCheck::run()
+{
+    std::cout << "OtoDecks sampler check, " << SamplerBank::numVoices << " voices" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto folder = File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks sampler check");
+    folder.deleteRecursively();
+    folder.createDirectory();
+
+    MasterClock clock;
+    clock.prepareToPlay(sampleRate);
+
+    SamplerBank bank(formatManager, clock);
+    bank.prepareToPlay(blockSize, sampleRate);
+
+    CheckResults results;
+
+    if (!results.expect(loadPad(bank, levelPad, writeConstantSample(folder.getChildFile("level.wav"), level))
+                            && loadPad(bank, silentPad, writeConstantSample(folder.getChildFile("silent.wav"), 0.0f)),
+                        "couldn't load the test samples from " + folder.getFullPathName()))
+    {
+        folder.deleteRecursively();
+        return results.finish();
+    }
+
+    std::vector<float> output;
+    const auto allVoices = (float) SamplerBank::numVoices * level;
+
+    // every voice on the level pad, then one more trigger has to take the oldest over
+    for (int i = 0; i < SamplerBank::numVoices; ++i)
+        bank.trigger(levelPad);
+
+    render(bank, clock, 4, output);
+    results.expect(std::abs(output.back() - allVoices) < tolerance, "not every voice started");
+
+    auto stealFrom = output.size();
+    bank.trigger(silentPad);
+    render(bank, clock, 8, output);
+
+    auto step = largestStep(output, stealFrom);
+    std::cout << "  voice taken over: largest step " << step << ", one voice is " << level << std::endl;
+    results.expect(step < level / 16.0f, "the voice taken over was cut instead of faded");
+    results.expect(std::abs(output.back() - (allVoices - level)) < tolerance, "the voice taken over never stopped");
+
+    // stop all fades every voice at once
+    auto stopFrom = output.size();
+    bank.stopAll();
+    render(bank, clock, 8, output);
+
+    step = largestStep(output, stopFrom);
+    std::cout << "  stop all: largest step " << step << " from " << allVoices - level << std::endl;
+    results.expect(step < (allVoices - level) / 16.0f, "stop all cut the voices instead of fading them");
+    results.expect(std::abs(output.back()) < tolerance && !bank.isSounding(levelPad) && !bank.isSounding(silentPad),
+                   "stop all left a voice playing");
+
+    // quantised to the beat, a trigger part way through one waits for the next, to the sample
+    bank.setQuantise(1.0);
+    render(bank, clock, quantiseAfterBlocks - (int) (output.size() / blockSize), output);
+
+    auto samplesPerBeat = roundToInt(60.0 / clock.getTempo() * sampleRate);
+    auto triggeredAt = (int) output.size();
+    auto expectedOnset = (triggeredAt / samplesPerBeat + 1) * samplesPerBeat;
+
+    bank.trigger(levelPad);
+    render(bank, clock, (expectedOnset - triggeredAt) / blockSize + 4, output);
+
+    auto onset = -1;
+    for (auto i = (size_t) triggeredAt; i < output.size() && onset < 0; ++i)
+        if (std::abs(output[i]) > tolerance)
+            onset = (int) i;
+
+    std::cout << "  quantised trigger at sample " << triggeredAt << " started at " << onset
+              << ", the next beat is at " << expectedOnset << std::endl;
+    results.expect(onset == expectedOnset, "the quantised trigger didn't start on the next beat");
+
+    bank.stopAll();
+    render(bank, clock, 8, output);
+    bank.releaseResources();
+    folder.deleteRecursively();
+
+    return results.finish();
+}
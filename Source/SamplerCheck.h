@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    SamplerCheck.h
+    Created: 27 Oct 2026 4:47:25pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of the sampler's voices, started with --sampler-check.
+
+    The bank is rendered offline against a free-running master clock. One pad
+    holds a constant level and another silence, so the output is flat while
+    the voices play and any step in it is a voice being cut. Every voice is
+    started on the level pad, then the silent pad takes over the oldest voice,
+    then everything is stopped: the output has to ramp down each time rather
+    than jump. With quantising on, a trigger part way through a beat must
+    start on the next beat of the clock, to the sample.
+*/
+class SamplerCheck
+{
+public:
+    /** runs every part, printing progress; returns the process exit code */
+    static int run();
+};
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    SamplerPanel.cpp
+    Created: 25 Oct 2026 6:03:44pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SamplerPanel.h"
+
+namespace
+{
+    const int gridSize = 4;
+    const int padGap = 4;
+    const int refreshHz = 30;
+
+    struct QuantiseStep
+    {
+        const char* name;
+        double beats;
+    };
+
+    const QuantiseStep quantiseSteps[] = { { "Off", 0.0 }, { "1/4 beat", 0.25 }, { "1/2 beat", 0.5 },
+                                           { "Beat", 1.0 }, { "Bar", 4.0 } };
+}
+
+SamplerPanel::SamplerPanel(SamplerBank& _bank) : bank(_bank)
+{
+    for (int i = 0; i < (int) std::size(quantiseSteps); ++i)
+        quantiseBox.addItem(String("Quantise: ") + quantiseSteps[i].name, i + 1);
+
+    quantiseBox.setSelectedId(1, dontSendNotification);
+    quantiseBox.onChange = [this] { bank.setQuantise(quantiseSteps[quantiseBox.getSelectedItemIndex()].beats); };
+    addAndMakeVisible(quantiseBox);
+
+    stopButton.setColour(TextButton::buttonColourId, Colour::fromRGB(90, 10, 70));
+    stopButton.onClick = [this] { bank.stopAll(); };
+    addAndMakeVisible(stopButton);
+
+    startTimerHz(refreshHz);
+}
+
+SamplerPanel::~SamplerPanel()
+{
+}
+
+void SamplerPanel::paint(Graphics& g)
+{
+    ColourGradient gradient(Colours::darkslateblue, 0.0f, 0.0f, Colours::midnightblue, getWidth(), getHeight(), false);
+    g.setGradientFill(gradient);
+    g.fillAll();
+
+    g.setColour(Colours::darkgrey);
+    g.drawRect(getLocalBounds(), 1);
+
+    g.setFont(11.0f);
+
+    for (int pad = 0; pad < SamplerBank::numPads; ++pad)
+    {
+        auto bounds = getPadBounds(pad).toFloat();
+        auto loop = bank.getMode(pad) == SamplerBank::Mode::loop;
+        auto base = loop ? Colours::teal.darker() : Colour::fromRGB(90, 10, 70);
+
+        if (!bank.isLoaded(pad))
+            base = Colours::darkgrey.darker();
+
+        g.setColour(((litPads >> pad) & 1) != 0 ? Colours::orange : base);
+        g.fillRoundedRectangle(bounds, 4.0f);
+
+        if (((failedPads >> pad) & 1) != 0)
+        {
+            g.setColour(Colours::red);
+            g.drawRoundedRectangle(bounds.reduced(1.0f), 4.0f, 2.0f);
+        }
+
+        auto name = bank.isLoading(pad) ? "Loading..." : bank.getFile(pad).getFileNameWithoutExtension();
+        g.setColour(Colours::white);
+        g.drawText(String(pad + 1) + (loop ? "  LOOP" : ""), bounds.reduced(4.0f), Justification::topLeft, false);
+        g.drawFittedText(name, bounds.reduced(4.0f).toNearestInt(), Justification::bottomLeft, 2);
+    }
+}
+
+void SamplerPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(6);
+    auto controls = bounds.removeFromBottom(24);
+
+    stopButton.setBounds(controls.removeFromRight(60));
+    controls.removeFromRight(padGap);
+    quantiseBox.setBounds(controls);
+
+    bounds.removeFromBottom(padGap);
+    grid = bounds;
+}
+
+Rectangle<int> SamplerPanel::getPadBounds(int pad) const
+{
+    auto width = (grid.getWidth() - (gridSize - 1) * padGap) / gridSize;
+    auto height = (grid.getHeight() - (gridSize - 1) * padGap) / gridSize;
+
+    return { grid.getX() + (pad % gridSize) * (width + padGap), grid.getY() + (pad / gridSize) * (height + padGap),
+             width, height };
+}
+
+int SamplerPanel::padAt(Point<int> position) const
+{
+    for (int pad = 0; pad < SamplerBank::numPads; ++pad)
+        if (getPadBounds(pad).contains(position))
+            return pad;
+
+    return -1;
+}
+
+void SamplerPanel::mouseDown(const MouseEvent& event)
+{
+    auto pad = padAt(event.getPosition());
+
+    if (pad < 0)
+        return;
+
+    // on the way down, as a pad should be
+    if (event.mods.isPopupMenu())
+        showPadMenu(pad);
+    else
+        bank.trigger(pad);
+}
+
+void SamplerPanel::showPadMenu(int pad)
+{
+    auto loop = bank.getMode(pad) == SamplerBank::Mode::loop;
+
+    PopupMenu menu;
+    menu.addItem("Load...", [this, pad]
+    {
+        fileChooser = std::make_unique<FileChooser>("Load pad " + String(pad + 1), File(), "*.wav;*.mp3;*.aiff;*.flac");
+        fileChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles,
+            [this, pad](const FileChooser& chooser)
+            {
+                if (chooser.getResult().existsAsFile())
+                    loadPad(pad, chooser.getResult());
+            });
+    });
+    menu.addItem("One-shot", true, !loop, [this, pad] { bank.setMode(pad, SamplerBank::Mode::oneShot); repaint(); });
+    menu.addItem("Loop", true, loop, [this, pad] { bank.setMode(pad, SamplerBank::Mode::loop); repaint(); });
+    menu.addSeparator();
+    menu.addItem("Clear", bank.isLoaded(pad) || bank.isLoading(pad), false, [this, pad] { bank.clearPad(pad); repaint(); });
+
+    menu.showMenuAsync(PopupMenu::Options().withTargetScreenArea(localAreaToGlobal(getPadBounds(pad))));
+}
+
+void SamplerPanel::loadPad(int pad, const File& file)
+{
+    // refused when unreadable, too long, or over the memory budget
+    if (bank.loadPad(pad, file))
+        failedPads &= ~(1u << pad);
+    else
+        failedPads |= 1u << pad;
+
+    repaint();
+}
+
+bool SamplerPanel::isInterestedInFileDrag(const StringArray& files)
+{
+    return files.size() == 1;
+}
+
+void SamplerPanel::filesDropped(const StringArray& files, int x, int y)
+{
+    auto pad = padAt({ x, y });
+
+    if (pad >= 0 && files.size() == 1)
+        loadPad(pad, File(files[0]));
+}
+
+void SamplerPanel::timerCallback()
+{
+    uint32 lit = 0;
+
+    for (int pad = 0; pad < SamplerBank::numPads; ++pad)
+        if (bank.isSounding(pad))
+            lit |= 1u << pad;
+
+    if (bank.collectLoaded() || lit != litPads)
+    {
+        litPads = lit;
+        repaint();
+    }
+}
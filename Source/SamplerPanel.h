@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    SamplerPanel.h
+    Created: 25 Oct 2026 6:03:44pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SamplerBank.h"
+
+//==============================================================================
+/*
+    A 4x4 grid of SamplerBank pads beside the decks.
+
+    A pad fires as the mouse goes down. Right-click a pad to load a file, switch
+    it between one-shot and loop, or clear it; a file dropped on a pad loads
+    into it. The quantise box snaps triggers to the master clock's beat grid,
+    and STOP cuts everything.
+
+    Pads light up while their voices sound. Finished loads are picked up on the
+    panel's timer.
+*/
+class SamplerPanel : public Component,
+                     public FileDragAndDropTarget,
+                     private Timer
+{
+public:
+    SamplerPanel(SamplerBank& bank);
+    ~SamplerPanel();
+
+    void paint(Graphics&) override;
+    void resized() override;
+    void mouseDown(const MouseEvent&) override;
+
+    bool isInterestedInFileDrag(const StringArray& files) override;
+    void filesDropped(const StringArray& files, int x, int y) override;
+
+private:
+    void timerCallback() override;
+    /** the pad under this point, or -1 */
+    int padAt(Point<int> position) const;
+    Rectangle<int> getPadBounds(int pad) const;
+    void showPadMenu(int pad);
+    void loadPad(int pad, const File& file);
+
+    SamplerBank& bank;
+    ComboBox quantiseBox;
+    TextButton stopButton{"STOP"};
+    Rectangle<int> grid;
+
+    std::unique_ptr<FileChooser> fileChooser;
+    uint32 litPads = 0;     // what was painted, to repaint only when it changes
+    uint32 failedPads = 0;  // loads refused, shown until the pad is next loaded
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplerPanel)
+};
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    SessionCheck.cpp
+    Created: 27 Oct 2026 4:12:53pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SessionCheck.h"
+#include "SessionSnapshot.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 44100.0;
+    const int blockSize = 256;
+    const double trackSeconds = 4.0;
+    const double bufferedSeconds = 1.0;
+    const int restoreTimeoutMs = 2000;      // from the restore starting to a second of audio decoded
+    const int analysisTimeoutMs = 10000;
+    const double tolerance = 1.0e-6;
+
+    /** a stereo tone with a little noise, long enough to cue into and buffer a second past */
+    File writeTestTrack(const File& file)
+    {
+        file.deleteFile();
+
+        WavAudioFormat wav;
+        std::unique_ptr<FileOutputStream> stream(new FileOutputStream(file));
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 16, {}, 0));
+
+        if (writer == nullptr)
+            return {};
+
+        stream.release(); // the writer owns it now
+
+        auto numSamples = (int) (trackSeconds * sampleRate);
+        AudioBuffer<float> buffer(2, numSamples);
+        Random random(20261027);
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < 2; ++channel)
+                buffer.setSample(channel, i, 0.4f * (float) std::sin(MathConstants<double>::twoPi * 330.0 * i / sampleRate)
+                                                 + 0.05f * (random.nextFloat() - 0.5f));
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        return file;
+    }
+
+    /** a state that touches every field, with an analysis no real run of the tone would find */
+    SessionSnapshot::State makeState(const File& track)
+    {
+        SessionSnapshot::DeckState deck;
+        deck.track = URL(track);
+        deck.positionSeconds = 1.5;
+        deck.speed = 1.1;
+        deck.gain = 0.8;
+        deck.hotCues = { 0.5, -1.0, 2.25, -1.0 };
+
+        for (int i = 0; i < StemReader::maxStems; ++i)
+        {
+            deck.stemGains.add(i == 1 ? 0.5f : 1.0f);
+            deck.stemMuted.add(i == 2);
+        }
+
+        deck.analysis.bpm = 123.0;
+        deck.analysis.firstBeatSeconds = 0.25;
+        deck.analysis.cueInSeconds = 0.1;
+        deck.analysis.introEndSeconds = 0.75;
+        deck.analysis.outroStartSeconds = 3.0;
+        deck.analysis.cueOutSeconds = 3.9;
+        deck.analysis.key = 7;
+        deck.analysis.loudnessDb = -12.5;
+        deck.analysis.energy = 0.4;
+
+        SessionSnapshot::State state;
+        state.decks.push_back(deck);
+        state.decks.push_back({});
+        state.crossfader = 0.25f;
+        state.autoDJQueue.add(track);
+        return state;
+    }
+
+    bool near(double a, double b)
+    {
+        return std::abs(a - b) < tolerance;
+    }
+
+    bool sameAnalysis(const TrackAnalysis& a, const TrackAnalysis& b)
+    {
+        return near(a.bpm, b.bpm) && near(a.firstBeatSeconds, b.firstBeatSeconds)
+            && near(a.cueInSeconds, b.cueInSeconds) && near(a.introEndSeconds, b.introEndSeconds)
+            && near(a.outroStartSeconds, b.outroStartSeconds) && near(a.cueOutSeconds, b.cueOutSeconds)
+            && a.key == b.key && near(a.loudnessDb, b.loudnessDb) && near(a.energy, b.energy);
+    }
+
+    //==============================================================================
+    void checkRoundTrip(CheckResults& results, const File& snapshotFile, const SessionSnapshot::State& saved,
+                        SessionSnapshot::State& loaded)
+    {
+        // something that isn't a snapshot, for the rename to replace whole
+        snapshotFile.replaceWithText("not a snapshot");
+
+        {
+            SessionSnapshot snapshot(snapshotFile);
+            results.expect(!snapshot.load(loaded), "a file that isn't a snapshot was loaded");
+
+            // the writer thread may or may not get to it first; the destructor writes what's left
+            snapshot.save(saved);
+        }
+
+        auto leftOver = snapshotFile.getParentDirectory().findChildFiles(File::findFiles, false, "*_temp*");
+        std::cout << "  wrote " << snapshotFile.getSize() << " bytes, " << leftOver.size() << " temporary files left" << std::endl;
+        results.expect(leftOver.isEmpty(), "the temporary file was left beside the snapshot");
+
+        SessionSnapshot reader(snapshotFile);
+
+        if (!results.expect(reader.load(loaded), "the snapshot couldn't be read back"))
+            return;
+
+        if (!results.expect(loaded.decks.size() == saved.decks.size(), "the decks didn't come back"))
+            return;
+
+        auto& before = saved.decks[0];
+        auto& after = loaded.decks[0];
+
+        results.expect(after.track == before.track, "the track changed");
+        results.expect(near(after.positionSeconds, before.positionSeconds), "the position changed");
+        results.expect(near(after.speed, before.speed) && near(after.gain, before.gain), "the speed or gain changed");
+        results.expect(after.hotCues == before.hotCues, "the hot cues changed");
+        results.expect(after.stemGains == before.stemGains && after.stemMuted == before.stemMuted, "the stems changed");
+        results.expect(sameAnalysis(after.analysis, before.analysis), "the analysis changed");
+        results.expect(loaded.decks[1].track.isEmpty() && !loaded.decks[1].analysis.hasMixPoints(), "the empty deck isn't empty");
+        results.expect(near(loaded.crossfader, saved.crossfader), "the crossfader changed");
+        results.expect(loaded.autoDJQueue == saved.autoDJQueue, "the Auto DJ queue changed");
+    }
+
+    void checkRestore(CheckResults& results, AudioFormatManager& formatManager, const SessionSnapshot::DeckState& deck)
+    {
+        DJAudioPlayer player(formatManager);
+        player.prepareToPlay(blockSize, sampleRate);
+
+        auto started = Time::getMillisecondCounter();
+        auto restored = SessionSnapshot::restore(player, deck);
+        auto remainingMs = restoreTimeoutMs - (int) (Time::getMillisecondCounter() - started);
+        auto buffered = restored && remainingMs > 0 && player.waitUntilBuffered(bufferedSeconds, remainingMs);
+
+        std::cout << "  restored and a second buffered after " << (Time::getMillisecondCounter() - started) << " ms" << std::endl;
+
+        if (results.expect(restored, "the deck couldn't be restored"))
+        {
+            results.expect(buffered, "a second of audio wasn't buffered within " + String(restoreTimeoutMs) + " ms");
+            results.expect(std::abs(player.getCurrentPosition() - deck.positionSeconds) < 1.0 / sampleRate,
+                           "the deck isn't cued at its old position");
+            results.expect(!player.isPlaying(), "the restored deck is playing");
+            results.expect(near(player.getSpeedSetting(), deck.speed) && near(player.getGain(), deck.gain),
+                           "the speed or gain wasn't restored");
+            results.expect(std::abs(player.getHotCue(0) - deck.hotCues[0]) < 1.0 / sampleRate && !player.hasHotCue(1),
+                           "the hot cues weren't restored");
+
+            // whatever the background analysis found is dropped, now or when it finishes
+            auto endTime = Time::getMillisecondCounter() + (uint32) analysisTimeoutMs;
+            while (player.isAnalysing() && Time::getMillisecondCounter() < endTime)
+                Thread::sleep(10);
+
+            results.expect(!player.isAnalysing(), "the background analysis never stopped");
+            results.expect(sameAnalysis(player.getAnalysis(), deck.analysis), "the saved analysis was overwritten");
+        }
+
+        player.releaseResources();
+    }
+}
+
+//==============================================================================
+int SessionCheck::run()
+{
+    std::cout << "OtoDecks session snapshot check" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto folder = File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks session check");
+    folder.deleteRecursively();
+    folder.createDirectory();
+
+    auto track = writeTestTrack(folder.getChildFile("track.wav"));
+    CheckResults results;
+
+    if (!results.expect(track.existsAsFile(), "couldn't write the test track to " + folder.getFullPathName()))
+        return results.finish();
+
+    auto saved = makeState(track);
+    SessionSnapshot::State loaded;
+
+    std::cout << "Round trip" << std::endl;
+    checkRoundTrip(results, folder.getChildFile("session.json"), saved, loaded);
+
+    if (!loaded.decks.empty())
+    {
+        std::cout << "Restore" << std::endl;
+        checkRestore(results, formatManager, loaded.decks[0]);
+    }
+
+    folder.deleteRecursively();
+    return results.finish();
+}
@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    SessionCheck.h
+    Created: 27 Oct 2026 4:12:53pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of the session snapshot, started with --session-check.
+
+    A deck's state is saved over a file that isn't a snapshot, through the
+    writer thread and the rename beside it, and read back. Every value has to
+    survive the JSON round trip, and no temporary file may be left behind.
+    The state is then restored onto a fresh deck, which must have a second of
+    audio decoded at its old position within two seconds of the restore
+    starting, and must keep the saved analysis once its own has stopped.
+*/
+class SessionCheck
+{
+public:
+    /** runs the round trip and the restore, printing progress; returns the process exit code */
+    static int run();
+};
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    SessionRecorder.cpp
+    Created: 20 Oct 2026 11:02:26am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SessionRecorder.h"
+
+namespace
+{
+    const int bitsPerSample = 24;
+    // how much audio can back up while the disk is busy
+    const double fifoSeconds = 4.0;
+}
+
+SessionRecorder::SessionRecorder()
+{
+    writerThread.startThread();
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    stop();
+    writerThread.stopThread(2000);
+}
+
+void SessionRecorder::prepareToPlay(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+}
+
+File SessionRecorder::getDefaultFile(Format format)
+{
+    auto folder = File::getSpecialLocation(File::userMusicDirectory).getChildFile("OtoDecks Sessions");
+    folder.createDirectory();
+
+    auto name = "session-" + Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S");
+    return folder.getNonexistentChildFile(name, format == Format::flac ? ".flac" : ".wav");
+}
+
+bool SessionRecorder::start(const File& file, Format format)
+{
+    stop();
+
+    if (sampleRate <= 0.0)
+    {
+        DBG("SessionRecorder::start audio device isn't running");
+        return false;
+    }
+
+    file.deleteFile();
+    std::unique_ptr<FileOutputStream> stream(file.createOutputStream());
+
+    if (stream == nullptr)
+    {
+        DBG("SessionRecorder::start can't write to " + file.getFullPathName());
+        return false;
+    }
+
+    WavAudioFormat wavFormat;
+    FlacAudioFormat flacFormat;
+    AudioFormat& audioFormat = format == Format::flac ? static_cast<AudioFormat&>(flacFormat)
+                                                      : static_cast<AudioFormat&>(wavFormat);
+
+    auto* writer = audioFormat.createWriterFor(stream.get(), sampleRate, 2, bitsPerSample, {}, 0);
+
+    if (writer == nullptr)
+    {
+        DBG("SessionRecorder::start no writer for " + file.getFullPathName());
+        return false;
+    }
+
+    stream.release(); // the writer owns it now
+
+    recordedSamples = 0;
+    droppedBlocks = 0;
+    currentFile = file;
+
+    threadedWriter.reset(new AudioFormatWriter::ThreadedWriter(writer, writerThread, (int) (sampleRate * fifoSeconds)));
+    activeWriter = threadedWriter.get();
+    return true;
+}
+
+void SessionRecorder::stop()
+{
+    activeWriter = nullptr;
+
+    // let a callback that already picked up the writer finish with it
+    while (writing.load())
+        Thread::yield();
+
+    // deleting the ThreadedWriter flushes what's left in its FIFO
+    threadedWriter.reset();
+}
+
+void SessionRecorder::process(const AudioSourceChannelInfo& bufferToFill)
+{
+    writing = true;
+
+    if (auto* writer = activeWriter.load())
+    {
+        const float* channels[2];
+        auto numChannels = bufferToFill.buffer->getNumChannels();
+
+        for (int channel = 0; channel < 2; ++channel)
+            channels[channel] = bufferToFill.buffer->getReadPointer(jmin(channel, numChannels - 1),
+                                                                     bufferToFill.startSample);
+
+        if (writer->write(channels, bufferToFill.numSamples))
+            recordedSamples += bufferToFill.numSamples;
+        else
+            ++droppedBlocks;
+    }
+
+    writing = false;
+}
+
+double SessionRecorder::getRecordedSeconds() const
+{
+    return sampleRate > 0.0 ? (double) recordedSamples.load() / sampleRate : 0.0;
+}
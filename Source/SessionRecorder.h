@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    SessionRecorder.h
+    Created: 20 Oct 2026 11:02:26am
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Records the master output to a WAV or FLAC file.
+
+    The audio thread only pushes samples into the ThreadedWriter's fixed FIFO;
+    encoding and disk writes happen on the recorder's own thread. If the FIFO
+    is full because the disk has stalled, the block is counted as dropped
+    instead of waiting, so memory stays flat however long the set runs.
+*/
+class SessionRecorder
+{
+public:
+    enum class Format { wav, flac };
+
+    SessionRecorder();
+    ~SessionRecorder();
+
+    void prepareToPlay(double sampleRate);
+
+    /** begins a new recording, stopping any current one; returns false if the file can't be written */
+    bool start(const File& file, Format format);
+    /** stops and flushes the current recording */
+    void stop();
+    bool isRecording() const { return activeWriter.load() != nullptr; }
+
+    /** push a block of the master output; called from the audio thread */
+    void process(const AudioSourceChannelInfo& bufferToFill);
+
+    double getRecordedSeconds() const;
+    int getNumDroppedBlocks() const { return droppedBlocks.load(); }
+    File getFile() const { return currentFile; }
+
+    /** a fresh file name in the user's music folder */
+    static File getDefaultFile(Format format);
+
+private:
+    TimeSliceThread writerThread{ "Session recorder" };
+    std::unique_ptr<AudioFormatWriter::ThreadedWriter> threadedWriter;
+    std::atomic<AudioFormatWriter::ThreadedWriter*> activeWriter{ nullptr };
+    std::atomic<bool> writing{ false };
+
+    double sampleRate = 0.0;
+    std::atomic<int64> recordedSamples{ 0 };
+    std::atomic<int> droppedBlocks{ 0 };
+    File currentFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionRecorder)
+};
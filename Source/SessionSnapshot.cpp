@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+    SessionSnapshot.cpp
+    Created: 24 Oct 2026 4:12:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SessionSnapshot.h"
+#include "Tracer.h"
+
+namespace
+{
+    const int formatVersion = 1;
+
+    var toVar(const TrackAnalysis& analysis)
+    {
+        auto* object = new DynamicObject();
+        object->setProperty("bpm", analysis.bpm);
+        object->setProperty("firstBeat", analysis.firstBeatSeconds);
+        object->setProperty("cueIn", analysis.cueInSeconds);
+        object->setProperty("introEnd", analysis.introEndSeconds);
+        object->setProperty("outroStart", analysis.outroStartSeconds);
+        object->setProperty("cueOut", analysis.cueOutSeconds);
+        object->setProperty("key", analysis.key);
+        object->setProperty("loudness", analysis.loudnessDb);
+        object->setProperty("energy", analysis.energy);
+        return var(object);
+    }
+
+    TrackAnalysis analysisFromVar(const var& object)
+    {
+        TrackAnalysis analysis;
+        analysis.bpm = object.getProperty("bpm", 0.0);
+        analysis.firstBeatSeconds = object.getProperty("firstBeat", 0.0);
+        analysis.cueInSeconds = object.getProperty("cueIn", 0.0);
+        analysis.introEndSeconds = object.getProperty("introEnd", 0.0);
+        analysis.outroStartSeconds = object.getProperty("outroStart", 0.0);
+        analysis.cueOutSeconds = object.getProperty("cueOut", 0.0);
+        analysis.key = object.getProperty("key", -1);
+        analysis.loudnessDb = object.getProperty("loudness", -100.0);
+        analysis.energy = object.getProperty("energy", 0.0);
+        return analysis;
+    }
+
+    var toVar(const SessionSnapshot::DeckState& deck)
+    {
+        auto* object = new DynamicObject();
+        object->setProperty("track", deck.track.toString(false));
+        object->setProperty("position", deck.positionSeconds);
+        object->setProperty("speed", deck.speed);
+        object->setProperty("gain", deck.gain);
+        object->setProperty("sync", deck.sync);
+        object->setProperty("master", deck.master);
+
+        Array<var> hotCues, stemGains, stemMuted;
+        for (auto cue : deck.hotCues)     hotCues.add(cue);
+        for (auto gain : deck.stemGains)  stemGains.add(gain);
+        for (auto muted : deck.stemMuted) stemMuted.add(muted);
+
+        object->setProperty("hotCues", hotCues);
+        object->setProperty("stemGains", stemGains);
+        object->setProperty("stemMuted", stemMuted);
+        object->setProperty("queued", deck.queued.toString(false));
+
+        if (deck.analysis.hasMixPoints())
+            object->setProperty("analysis", toVar(deck.analysis));
+
+        return var(object);
+    }
+
+    SessionSnapshot::DeckState deckFromVar(const var& object)
+    {
+        SessionSnapshot::DeckState deck;
+        deck.track = URL(object.getProperty("track", {}).toString());
+        deck.positionSeconds = object.getProperty("position", 0.0);
+        deck.speed = object.getProperty("speed", 1.0);
+        deck.gain = object.getProperty("gain", 1.0);
+        deck.sync = object.getProperty("sync", false);
+        deck.master = object.getProperty("master", false);
+
+        if (auto* hotCues = object.getProperty("hotCues", {}).getArray())
+            for (auto& cue : *hotCues)
+                deck.hotCues.add(cue);
+
+        if (auto* stemGains = object.getProperty("stemGains", {}).getArray())
+            for (auto& gain : *stemGains)
+                deck.stemGains.add(gain);
+
+        if (auto* stemMuted = object.getProperty("stemMuted", {}).getArray())
+            for (auto& muted : *stemMuted)
+                deck.stemMuted.add(muted);
+
+        deck.queued = URL(object.getProperty("queued", {}).toString());
+
+        if (object.hasProperty("analysis"))
+            deck.analysis = analysisFromVar(object.getProperty("analysis", {}));
+
+        return deck;
+    }
+}
+
+//==============================================================================
+File SessionSnapshot::getDefaultFile()
+{
+    return File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("otodecks_session.json");
+}
+
+SessionSnapshot::SessionSnapshot(const File& snapshotFile)
+    : Thread("Session snapshot"), file(snapshotFile)
+{
+    startThread(Thread::Priority::low);
+}
+
+SessionSnapshot::~SessionSnapshot()
+{
+    signalThreadShouldExit();
+    stateSaved.signal();
+    stopThread(4000);
+
+    writePending();
+}
+
+SessionSnapshot::DeckState SessionSnapshot::capture(const DJAudioPlayer& player)
+{
+    DeckState deck;
+    deck.track = player.getLoadedURL();
+    deck.positionSeconds = player.getCurrentPosition();
+    deck.speed = player.getSpeedSetting();
+    deck.gain = player.getGain();
+    deck.sync = player.isSyncEnabled();
+    deck.master = player.isMaster();
+    deck.queued = player.getQueuedURL();
+
+    for (int i = 0; i < CueWindowSource::maxCues; ++i)
+        deck.hotCues.add(player.getHotCue(i));
+
+    for (int i = 0; i < StemReader::maxStems; ++i)
+    {
+        deck.stemGains.add(player.getStemGain(i));
+        deck.stemMuted.add(player.isStemMuted(i));
+    }
+
+    if (player.hasMixPoints())
+        deck.analysis = player.getAnalysis();
+
+    return deck;
+}
+
+bool SessionSnapshot::restore(DJAudioPlayer& player, const DeckState& deck)
+{
+    TRACE_SPAN("SessionSnapshot::restore");
+
+    if (deck.track.isEmpty())
+        return false;
+
+    player.loadURL(deck.track);
+
+    if (!player.isLoaded() || player.getLoadedURL() != deck.track)
+    {
+        DBG("SessionSnapshot - Couldn't reload " + deck.track.toString(false));
+        return false;
+    }
+
+    if (deck.analysis.hasMixPoints())
+        player.setAnalysis(deck.analysis);
+
+    player.setSpeed(deck.speed);
+    player.setGain(deck.gain);
+
+    for (int i = 0; i < deck.hotCues.size(); ++i)
+        player.setHotCueAt(i, deck.hotCues[i]);
+
+    for (int i = 0; i < jmin(deck.stemGains.size(), deck.stemMuted.size()); ++i)
+    {
+        player.setStemGain(i, deck.stemGains[i]);
+        player.setStemMuted(i, deck.stemMuted[i]);
+    }
+
+    // the read-ahead starts decoding here now, not when play is pressed
+    player.cueAt(deck.positionSeconds);
+
+    player.setSyncEnabled(deck.sync);
+    if (deck.master)
+        player.makeMaster();
+
+    if (!deck.queued.isEmpty())
+        player.queueNext(deck.queued);
+
+    return true;
+}
+
+//==============================================================================
+void SessionSnapshot::save(const State& state)
+{
+    {
+        const ScopedLock sl(pendingLock);
+        pending = state;
+        hasPending = true;
+    }
+
+    stateSaved.signal();
+}
+
+bool SessionSnapshot::load(State& state) const
+{
+    TRACE_SPAN("SessionSnapshot::load");
+
+    if (!file.existsAsFile())
+        return false;
+
+    auto parsed = JSON::parse(file);
+
+    if (!parsed.isObject() || (int) parsed.getProperty("version", 0) != formatVersion)
+    {
+        DBG("SessionSnapshot - Ignoring unreadable " + file.getFullPathName());
+        return false;
+    }
+
+    state = {};
+    state.crossfader = parsed.getProperty("crossfader", 0.5f);
+
+    if (auto* decks = parsed.getProperty("decks", {}).getArray())
+        for (auto& deck : *decks)
+            state.decks.push_back(deckFromVar(deck));
+
+    if (auto* queue = parsed.getProperty("autoDJQueue", {}).getArray())
+        for (auto& path : *queue)
+            state.autoDJQueue.add(File(path.toString()));
+
+    return true;
+}
+
+void SessionSnapshot::run()
+{
+    while (!threadShouldExit())
+    {
+        stateSaved.wait(-1);
+
+        if (threadShouldExit())
+            return;
+
+        writePending();
+
+        // saves in between only replace the pending state, so a busy set writes once per interval
+        for (auto waited = 0; waited < writeIntervalMs && !threadShouldExit(); waited += 50)
+            wait(50);
+    }
+}
+
+void SessionSnapshot::writePending()
+{
+    State state;
+
+    {
+        const ScopedLock sl(pendingLock);
+
+        if (!hasPending)
+            return;
+
+        state = pending;
+        hasPending = false;
+    }
+
+    TRACE_SPAN("SessionSnapshot::write");
+
+    auto* object = new DynamicObject();
+    object->setProperty("version", formatVersion);
+    object->setProperty("crossfader", state.crossfader);
+
+    Array<var> decks, queue;
+    for (auto& deck : state.decks)           decks.add(toVar(deck));
+    for (auto& track : state.autoDJQueue)    queue.add(track.getFullPathName());
+
+    object->setProperty("decks", decks);
+    object->setProperty("autoDJQueue", queue);
+
+    auto json = JSON::toString(var(object));
+
+    if (json == lastWritten)
+        return;
+
+    // written beside the snapshot and renamed over it, never half written in place
+    TemporaryFile temp(file);
+
+    if (temp.getFile().replaceWithText(json) && temp.overwriteTargetFileWithTemporary())
+        lastWritten = json;
+    else
+        DBG("SessionSnapshot - Couldn't write " + file.getFullPathName());
+}
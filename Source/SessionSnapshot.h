@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    SessionSnapshot.h
+    Created: 24 Oct 2026 4:12:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJAudioPlayer.h"
+
+//==============================================================================
+/*
+    What the decks and mixer were doing, kept on disk so a restart after a
+    crash carries on where the set left off.
+
+    The message thread captures the state, which only reads a few values, and
+    hands it over; a thread of the snapshot's own turns it into JSON and
+    writes it, at most once every few seconds and only when it has changed.
+    The file is replaced by a rename, so a crash part way through a write
+    leaves the previous snapshot whole.
+
+    A restored deck reloads its track and is cued at its old position, with
+    the read-ahead and the hot cue windows decoding from there straight away.
+    Its analysis comes back from the snapshot rather than being run again,
+    and a remote track reads from the block cache it was streamed into.
+*/
+class SessionSnapshot : private Thread
+{
+public:
+    struct DeckState
+    {
+        URL track;
+        double positionSeconds = 0.0;
+        double speed = 1.0;
+        double gain = 1.0;
+        bool sync = false;
+        bool master = false;
+        Array<double> hotCues;      // seconds, -1 where there's no cue
+        Array<float> stemGains;
+        Array<bool> stemMuted;
+        URL queued;
+        TrackAnalysis analysis;     // empty until the analysis had finished
+    };
+
+    struct State
+    {
+        std::vector<DeckState> decks;
+        float crossfader = 0.5f;
+        Array<File> autoDJQueue;
+    };
+
+    /** Documents/otodecks_session.json */
+    static File getDefaultFile();
+
+    explicit SessionSnapshot(const File& snapshotFile = getDefaultFile());
+    /** writes the last state saved, however recently the one before it was written */
+    ~SessionSnapshot() override;
+
+    /** message thread: what a deck is doing now */
+    static DeckState capture(const DJAudioPlayer& player);
+    /** loads the deck's track and puts it back as it was, stopped; false if the track is gone */
+    static bool restore(DJAudioPlayer& player, const DeckState& deck);
+
+    /** hands the state to the writer thread; cheap enough to call on every timer tick */
+    void save(const State& state);
+    /** reads the last snapshot written; false if there isn't one */
+    bool load(State& state) const;
+
+    const File& getFile() const { return file; }
+
+    static constexpr int writeIntervalMs = 2000;
+
+private:
+    void run() override;
+    /** writes the pending state if it differs from the last one written */
+    void writePending();
+
+    const File file;
+    WaitableEvent stateSaved;
+
+    CriticalSection pendingLock;
+    State pending;
+    bool hasPending = false;
+
+    String lastWritten; // writer thread only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionSnapshot)
+};
@@ -0,0 +1,395 @@
+/*
+  ==============================================================================
+
+    SnippetCache.cpp
+    Created: 22 Oct 2026 5:03:12pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SnippetCache.h"
+#include "StemReader.h"
+#include "Tracer.h"
+
+namespace
+{
+    const double introSeconds = 6.0;
+    const double pointSeconds = 3.0;
+    const double snippetPoints[] = { 0.3, 0.5, 0.7, 0.85 };
+
+    // faster tracks get shorter snippets, so every track fits the same reservation
+    const double maxSnippetRate = 48000.0;
+    const size_t bytesPerTrack = (size_t) ((introSeconds + pointSeconds * numElementsInArray(snippetPoints)) * maxSnippetRate)
+                               * 2 * sizeof(int16);
+
+    const int chunkSamples = 8192;
+}
+
+//==============================================================================
+class SnippetCache::SnippetJob : public ThreadPoolJob
+{
+public:
+    SnippetJob(SnippetCache& _owner, const File& _file, int _id)
+        : ThreadPoolJob("Snippets " + _file.getFileName()), owner(_owner), file(_file), id(_id)
+    {
+    }
+
+    ~SnippetJob() override
+    {
+        // every job reports back exactly once, so its reservation is always returned
+        owner.jobFinished({ id, file.getFullPathName(), std::move(snippets) });
+    }
+
+    int getId() const { return id; }
+
+    JobStatus runJob() override
+    {
+        TRACE_SPAN("SnippetCache decode");
+
+        std::unique_ptr<AudioFormatReader> reader(StemReader::createReaderFor(owner.formatManager, URL(file), true));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return jobHasFinished;
+
+        auto decoded = std::make_shared<TrackSnippets>();
+        decoded->file = file;
+        decoded->sampleRate = reader->sampleRate;
+        decoded->lengthInSamples = reader->lengthInSamples;
+
+        auto scale = jmin(1.0, maxSnippetRate / reader->sampleRate);
+        size_t numFrames = 0;
+
+        auto addSnippet = [&](int64 start, double seconds)
+        {
+            // the points are in order, so a short track just gets fewer, shorter snippets
+            if (!decoded->snippets.empty())
+                start = jmax(start, decoded->snippets.back().start + decoded->snippets.back().length);
+
+            auto length = (int) jmin<int64>((int64) (seconds * reader->sampleRate * scale), reader->lengthInSamples - start);
+
+            if (length > 0)
+            {
+                decoded->snippets.push_back({ start, length, numFrames });
+                numFrames += (size_t) length;
+            }
+        };
+
+        addSnippet(0, introSeconds);
+        for (auto point : snippetPoints)
+            addSnippet((int64) (point * (double) reader->lengthInSamples), pointSeconds);
+
+        decoded->samples.malloc(numFrames * 2);
+        decoded->numBytes = numFrames * 2 * sizeof(int16);
+        AudioBuffer<float> chunk(2, chunkSamples);
+
+        for (auto& snippet : decoded->snippets)
+        {
+            for (int done = 0; done < snippet.length; done += chunkSamples)
+            {
+                // scrolled away
+                if (shouldExit())
+                    return jobHasFinished;
+
+                auto numToRead = jmin(chunkSamples, snippet.length - done);
+                reader->read(&chunk, 0, numToRead, snippet.start + done, true, true);
+
+                auto* out = decoded->samples.get() + 2 * (snippet.offset + (size_t) done);
+                auto* left = chunk.getReadPointer(0);
+                auto* right = chunk.getReadPointer(1);
+
+                for (int i = 0; i < numToRead; ++i)
+                {
+                    out[2 * i] = (int16) jlimit(-32767, 32767, roundToInt(left[i] * 32767.0f));
+                    out[2 * i + 1] = (int16) jlimit(-32767, 32767, roundToInt(right[i] * 32767.0f));
+                }
+            }
+        }
+
+        snippets = std::move(decoded);
+        return jobHasFinished;
+    }
+
+private:
+    SnippetCache& owner;
+    File file;
+    int id;
+    std::shared_ptr<TrackSnippets> snippets;
+};
+
+//==============================================================================
+int SnippetCache::TrackSnippets::findNearest(double relativePosition, int& offsetInSnippet) const
+{
+    auto target = (int64) (jlimit(0.0, 1.0, relativePosition) * (double) lengthInSamples);
+    auto nearest = -1;
+    int64 nearestDistance = 0;
+    offsetInSnippet = 0;
+
+    for (int i = 0; i < (int) snippets.size(); ++i)
+    {
+        auto& snippet = snippets[(size_t) i];
+
+        if (target >= snippet.start && target < snippet.start + snippet.length)
+        {
+            offsetInSnippet = (int) (target - snippet.start);
+            return i;
+        }
+
+        auto distance = std::abs(snippet.start - target);
+        if (nearest < 0 || distance < nearestDistance)
+        {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+
+    return nearest;
+}
+
+//==============================================================================
+SnippetCache::SnippetCache(AudioFormatManager& _formatManager, size_t _maxBytes)
+    : MemoryBudget::Consumer("Library snippets", MemoryBudget::Cost::decode),
+      formatManager(_formatManager),
+      maxBytes(_maxBytes)
+{
+    addToBudget();
+}
+
+SnippetCache::~SnippetCache()
+{
+    removeFromBudget();
+    pool.removeAllJobs(true, 4000);
+    cancelPendingUpdate();
+}
+
+void SnippetCache::setWanted(const std::vector<File>& files)
+{
+    StringArray newWanted;
+    for (auto& file : files)
+        newWanted.add(file.getFullPathName());
+
+    if (newWanted == wanted)
+        return;
+
+    wanted = newWanted;
+
+    // forget the jobs for rows that have gone, then stop them in the pool
+    for (auto it = activeJobs.begin(); it != activeJobs.end();)
+        it = wanted.contains(it->first) ? std::next(it) : activeJobs.erase(it);
+
+    struct Unwanted : public ThreadPool::JobSelector
+    {
+        Unwanted(const std::map<String, int>& _activeJobs) : activeJobs(_activeJobs) {}
+
+        bool isJobSuitable(ThreadPoolJob* job) override
+        {
+            auto* snippetJob = dynamic_cast<SnippetJob*>(job);
+            if (snippetJob == nullptr)
+                return false;
+
+            for (auto& active : activeJobs)
+                if (active.second == snippetJob->getId())
+                    return false;
+
+            return true;
+        }
+
+        const std::map<String, int>& activeJobs;
+    };
+
+    Unwanted unwanted(activeJobs);
+    pool.removeAllJobs(true, 0, &unwanted);
+
+    startWantedJobs();
+}
+
+void SnippetCache::request(const File& file)
+{
+    auto path = file.getFullPathName();
+
+    if (cache.count(path) != 0 || activeJobs.count(path) != 0)
+        return;
+
+    wanted.removeString(path);
+    wanted.insert(0, path);
+
+    if (makeRoom(bytesPerTrack, 0))
+        startJob(file);
+}
+
+std::shared_ptr<const SnippetCache::TrackSnippets> SnippetCache::find(const File& file)
+{
+    auto entry = cache.find(file.getFullPathName());
+
+    if (entry == cache.end())
+        return nullptr;
+
+    entry->second.lastUsed = ++useCounter;
+    return entry->second.snippets;
+}
+
+void SnippetCache::startWantedJobs()
+{
+    for (int i = 0; i < wanted.size(); ++i)
+    {
+        if (cache.count(wanted[i]) != 0 || activeJobs.count(wanted[i]) != 0)
+            continue;
+
+        // everything after this is wanted less, so it won't fit either
+        if (!makeRoom(bytesPerTrack, i))
+            break;
+
+        startJob(File(wanted[i]));
+    }
+}
+
+void SnippetCache::startJob(const File& file)
+{
+    auto id = ++nextJobId;
+    activeJobs[file.getFullPathName()] = id;
+    reservations[id] = bytesPerTrack;
+    reservedBytes += bytesPerTrack;
+
+    auto* job = new SnippetJob(*this, file, id);
+    pool.addJob(job, true);
+
+    // a track asked for directly goes ahead of the rows still queued
+    if (wanted.indexOf(file.getFullPathName()) == 0)
+        pool.moveJobToFront(job);
+}
+
+bool SnippetCache::makeRoom(size_t numBytes, int rank)
+{
+    while (usedBytes + reservedBytes + numBytes > maxBytes)
+        if (evictOne(rank) == 0)
+            return false;
+
+    // then under the app's budget, pushing out what's cheaper to get back before our own
+    auto& budget = MemoryBudget::getInstance();
+
+    while (!budget.makeRoom(numBytes, MemoryBudget::Cost::decode, this))
+        if (evictOne(rank) == 0)
+            return false;
+
+    return true;
+}
+
+size_t SnippetCache::evictOne(int rank)
+{
+    // tracks that aren't wanted go first, least recently used first, then the least wanted ones
+    auto victim = cache.end();
+    auto victimRank = rank;
+    uint32 victimUse = 0;
+
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+        auto index = wanted.indexOf(it->first);
+        auto itemRank = index < 0 ? wanted.size() : index;
+
+        // a preview still holding them would keep the memory anyway
+        if (itemRank <= rank || it->second.snippets.use_count() > 1)
+            continue;
+
+        if (victim == cache.end() || itemRank > victimRank
+            || (itemRank == victimRank && it->second.lastUsed < victimUse))
+        {
+            victim = it;
+            victimRank = itemRank;
+            victimUse = it->second.lastUsed;
+        }
+    }
+
+    if (victim == cache.end())
+        return 0;
+
+    auto freed = victim->second.snippets->numBytes;
+    usedBytes -= freed;
+    cache.erase(victim);
+    return freed;
+}
+
+size_t SnippetCache::getEvictableBytes() const
+{
+    size_t evictable = 0;
+
+    for (auto& entry : cache)
+        if (entry.second.snippets.use_count() == 1)
+            evictable += entry.second.snippets->numBytes;
+
+    return evictable;
+}
+
+size_t SnippetCache::evict(size_t numBytes)
+{
+    size_t freed = 0;
+
+    while (freed < numBytes)
+    {
+        auto freedNow = evictOne(-1);
+
+        if (freedNow == 0)
+            break;
+
+        freed += freedNow;
+    }
+
+    return freed;
+}
+
+//==============================================================================
+void SnippetCache::jobFinished(Result result)
+{
+    {
+        const ScopedLock sl(resultLock);
+        results.push_back(std::move(result));
+    }
+
+    triggerAsyncUpdate();
+}
+
+void SnippetCache::handleAsyncUpdate()
+{
+    std::vector<Result> finished;
+
+    {
+        const ScopedLock sl(resultLock);
+        finished.swap(results);
+    }
+
+    auto freedAny = false;
+
+    for (auto& result : finished)
+    {
+        auto reservation = reservations.find(result.jobId);
+        if (reservation != reservations.end())
+        {
+            reservedBytes -= reservation->second;
+            reservations.erase(reservation);
+            freedAny = true;
+        }
+
+        // a cancelled job may still have finished; its row has gone, so it isn't kept
+        auto active = activeJobs.find(result.path);
+        if (active == activeJobs.end() || active->second != result.jobId)
+            continue;
+
+        activeJobs.erase(active);
+
+        if (result.snippets == nullptr)
+            continue;
+
+        // it used no more than it reserved, so it fits
+        usedBytes += result.snippets->numBytes;
+        cache[result.path] = { result.snippets, ++useCounter };
+
+        DBG("SnippetCache - " + result.snippets->file.getFileName() + ", "
+            + String((double) getUsedBytes() / (1024.0 * 1024.0), 1) + " MB in use");
+
+        if (onTrackCached)
+            onTrackCached(result.snippets->file);
+    }
+
+    // the freed reservations may make room further down the list
+    if (freedAny)
+        startWantedJobs();
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    SnippetCache.h
+    Created: 22 Oct 2026 5:03:12pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    Short decoded stretches of library tracks, for previewing without loading
+    a deck: the intro and a few points scattered through the rest.
+
+    The library says which tracks it wants, the visible rows first and then
+    the ones either side, and a low priority background thread decodes them
+    in that order. Scrolling away cancels work on rows that have gone, even
+    part way through a track.
+
+    Memory is strictly capped, by this cache's own limit and by the memory
+    budget it shares with the rest of the app. Every job reserves its worst
+    case before it starts, snippets are kept as 16 bit stereo, and tracks
+    nobody wants any more are evicted least recently used first. What doesn't
+    fit isn't started. Snippets a preview is playing are pinned.
+*/
+class SnippetCache : private AsyncUpdater,
+                     private MemoryBudget::Consumer
+{
+public:
+    /** a track's snippets, interleaved 16 bit stereo one after another */
+    struct TrackSnippets
+    {
+        struct Snippet
+        {
+            int64 start = 0;     // in the track
+            int length = 0;
+            size_t offset = 0;   // frames into samples
+        };
+
+        File file;
+        double sampleRate = 44100.0;
+        int64 lengthInSamples = 0;
+        std::vector<Snippet> snippets;
+        HeapBlock<int16> samples;
+        size_t numBytes = 0;
+
+        /** the snippet holding this point of the track, or the one starting nearest it,
+            and how far into it to start */
+        int findNearest(double relativePosition, int& offsetInSnippet) const;
+    };
+
+    SnippetCache(AudioFormatManager& formatManager, size_t maxBytes = 64 * 1024 * 1024);
+    ~SnippetCache() override;
+
+    /** Message thread. The tracks worth having, most wanted first. Jobs for anything
+        else are cancelled, and tracks past what fits under the cap aren't started.
+    */
+    void setWanted(const std::vector<File>& files);
+    /** message thread: start this track ahead of everything else, if it isn't cached */
+    void request(const File& file);
+    /** message thread: the track's snippets, or nullptr until they are decoded */
+    std::shared_ptr<const TrackSnippets> find(const File& file);
+
+    /** memory held by cached snippets plus what running jobs have reserved */
+    size_t getUsedBytes() const override { return usedBytes + reservedBytes; }
+    /** cached snippets that no preview is playing */
+    size_t getEvictableBytes() const override;
+    /** message thread: unwanted tracks first, then the least wanted */
+    size_t evict(size_t numBytes) override;
+
+    /** called on the message thread when a track's snippets are ready */
+    std::function<void(const File&)> onTrackCached;
+
+private:
+    class SnippetJob;
+
+    struct Entry
+    {
+        std::shared_ptr<const TrackSnippets> snippets;
+        uint32 lastUsed = 0;
+    };
+
+    struct Result
+    {
+        int jobId;
+        String path;
+        std::shared_ptr<TrackSnippets> snippets;   // nullptr if cancelled or unreadable
+    };
+
+    /** from the job, as it's deleted: run, cancelled or never started */
+    void jobFinished(Result result);
+    void handleAsyncUpdate() override;
+
+    /** down the wanted list, for as long as the cap allows */
+    void startWantedJobs();
+    void startJob(const File& file);
+    /** evict tracks until numBytes more would fit under both limits: unwanted ones first,
+        least recently used first, then wanted ones ranked after rank; false if it still won't */
+    bool makeRoom(size_t numBytes, int rank);
+    /** evicts the track makeRoom would pick next; how much that freed, 0 if there was none */
+    size_t evictOne(int rank);
+
+    AudioFormatManager& formatManager;
+    const size_t maxBytes;
+    ThreadPool pool{ 1, 0, Thread::Priority::low };
+
+    std::map<String, Entry> cache;
+    std::map<String, int> activeJobs;      // path to the job decoding it, while still wanted
+    std::map<int, size_t> reservations;    // job to the bytes it may use, until it's gone
+    StringArray wanted;
+    size_t usedBytes = 0;
+    size_t reservedBytes = 0;
+    uint32 useCounter = 0;
+    int nextJobId = 0;
+
+    CriticalSection resultLock;
+    std::vector<Result> results;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnippetCache)
+};
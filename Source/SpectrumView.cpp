@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    SpectrumView.cpp
+    Created: 23 Oct 2026 3:41:05pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "SpectrumView.h"
+#include "Tracer.h"
+
+namespace
+{
+    const double lowestHz = 20.0;
+    const double highestHz = 20000.0;
+    const float floorDb = -90.0f;
+    const float topDb = 0.0f;
+    const float fallDbPerSecond = 40.0f;
+}
+
+SpectrumView::SpectrumView()
+    : history(fftSize, true), fftData(fftSize * 2, true), levels(numBins)
+{
+    for (int bin = 0; bin < numBins; ++bin)
+        levels[bin] = floorDb;
+
+    setOpaque(true);
+}
+
+SpectrumView::~SpectrumView()
+{
+}
+
+void SpectrumView::pushSamples(const AudioBuffer<float>& samples, int numSamples, double newSampleRate)
+{
+    if (!isShowing())
+        return;
+
+    sampleRate = newSampleRate;
+
+    // only the newest fftSize samples can matter
+    auto start = jmax(0, numSamples - fftSize);
+    auto* left = samples.getReadPointer(0, start);
+    auto* right = samples.getReadPointer(jmin(1, samples.getNumChannels() - 1), start);
+
+    for (int i = 0; i < numSamples - start; ++i)
+    {
+        history[historyPosition] = 0.5f * (left[i] + right[i]);
+        historyPosition = (historyPosition + 1) % fftSize;
+    }
+
+    hasNewSamples = true;
+}
+
+//==============================================================================
+void SpectrumView::update()
+{
+    if (!isShowing())
+        return;
+
+    TRACE_SPAN("SpectrumView::update");
+
+    auto now = Time::getMillisecondCounterHiRes() * 0.001;
+    auto fall = fallDbPerSecond * (float) (lastUpdateTime > 0.0 ? jmin(0.25, now - lastUpdateTime) : 0.0);
+    lastUpdateTime = now;
+
+    if (hasNewSamples)
+    {
+        // oldest first
+        auto tailLength = fftSize - historyPosition;
+        FloatVectorOperations::copy(fftData, history + historyPosition, tailLength);
+        FloatVectorOperations::copy(fftData + tailLength, history, historyPosition);
+
+        window.multiplyWithWindowingTable(fftData, (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData);
+        hasNewSamples = false;
+    }
+    else
+    {
+        FloatVectorOperations::clear(fftData, numBins);
+    }
+
+    // a full scale sine through the Hann window peaks at a quarter of fftSize
+    auto scale = 4.0f / (float) fftSize;
+
+    for (int bin = 0; bin < numBins; ++bin)
+        levels[bin] = jmax(levels[bin] - fall, Decibels::gainToDecibels(fftData[bin] * scale, floorDb));
+
+    // one point per pixel column, the loudest of the bins under it
+    auto width = getWidth();
+    curve.clear();
+    curve.preallocateSpace(3 * (width + 3));
+    curve.startNewSubPath(0.0f, (float) getHeight());
+
+    auto binsPerHz = fftSize / sampleRate;
+
+    for (int x = 0; x < width; ++x)
+    {
+        auto firstBin = jlimit(1, numBins - 1, (int) (xToFrequency((float) x) * binsPerHz));
+        auto lastBin = jlimit(firstBin, numBins - 1, (int) (xToFrequency((float) x + 1.0f) * binsPerHz));
+        auto db = levels[firstBin];
+
+        for (int bin = firstBin + 1; bin <= lastBin; ++bin)
+            db = jmax(db, levels[bin]);
+
+        curve.lineTo((float) x, levelToY(db));
+    }
+
+    curve.lineTo((float) width, (float) getHeight());
+    curve.closeSubPath();
+
+    repaint();
+}
+
+float SpectrumView::frequencyToX(double frequency) const
+{
+    return (float) (getWidth() * std::log(frequency / lowestHz) / std::log(highestHz / lowestHz));
+}
+
+double SpectrumView::xToFrequency(float x) const
+{
+    return lowestHz * std::pow(highestHz / lowestHz, (double) x / jmax(1, getWidth()));
+}
+
+float SpectrumView::levelToY(float db) const
+{
+    return jmap(jlimit(floorDb, topDb, db), floorDb, topDb, (float) getHeight(), 0.0f);
+}
+
+//==============================================================================
+void SpectrumView::paint(Graphics& g)
+{
+    TRACE_SPAN("SpectrumView::paint");
+
+    if (grid.isValid())
+        g.drawImageAt(grid, 0, 0);
+    else
+        g.fillAll(Colours::black);
+
+    g.setColour(Colours::cyan.withAlpha(0.3f));
+    g.fillPath(curve);
+    g.setColour(Colours::cyan);
+    g.strokePath(curve, PathStrokeType(1.0f));
+}
+
+void SpectrumView::resized()
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    grid = Image(Image::RGB, getWidth(), getHeight(), true);
+    Graphics g(grid);
+    g.fillAll(Colours::black);
+    g.setFont(10.0f);
+
+    for (auto db = topDb - 20.0f; db > floorDb; db -= 20.0f)
+    {
+        auto y = levelToY(db);
+        g.setColour(Colours::darkgrey.withAlpha(0.5f));
+        g.drawHorizontalLine((int) y, 0.0f, (float) getWidth());
+        g.setColour(Colours::grey);
+        g.drawText(String((int) db), 2, (int) y - 11, 30, 10, Justification::left);
+    }
+
+    for (auto hz : { 50.0, 100.0, 200.0, 500.0, 1000.0, 2000.0, 5000.0, 10000.0 })
+    {
+        auto x = frequencyToX(hz);
+        g.setColour(Colours::darkgrey.withAlpha(0.5f));
+        g.drawVerticalLine((int) x, 0.0f, (float) getHeight());
+        g.setColour(Colours::grey);
+        g.drawText(hz >= 1000.0 ? String((int) (hz / 1000.0)) + "k" : String((int) hz),
+                   (int) x + 2, getHeight() - 12, 30, 10, Justification::left);
+    }
+
+    g.setColour(Colours::darkgrey);
+    g.drawRect(getLocalBounds(), 1);
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    SpectrumView.h
+    Created: 23 Oct 2026 3:41:05pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    FFT spectrum of the master, on a log frequency scale.
+
+    It is fed on the message thread by LevelMeters, which reads the master's
+    MeterTap, and does nothing while it's hidden. At most one transform is done
+    per display frame, with an FFT plan, window table, buffers and path that
+    are made once; the grid is drawn into an image only when the size changes.
+*/
+class SpectrumView : public Component
+{
+public:
+    SpectrumView();
+    ~SpectrumView();
+
+    /** message thread: the newest samples of the signal, mixed to mono here */
+    void pushSamples(const AudioBuffer<float>& samples, int numSamples, double sampleRate);
+
+    void paint(Graphics&) override;
+    void resized() override;
+
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2;
+
+private:
+    /** once per display frame: transform what has arrived and rebuild the curve */
+    void update();
+    float frequencyToX(double frequency) const;
+    double xToFrequency(float x) const;
+    float levelToY(float db) const;
+
+    dsp::FFT fft{ fftOrder };
+    dsp::WindowingFunction<float> window{ (size_t) fftSize, dsp::WindowingFunction<float>::hann };
+
+    HeapBlock<float> history;   // ring of the last fftSize samples
+    int historyPosition = 0;
+    bool hasNewSamples = false;
+    double sampleRate = 44100.0;
+
+    HeapBlock<float> fftData;
+    HeapBlock<float> levels;    // smoothed dB per bin
+    double lastUpdateTime = 0.0;
+
+    Path curve;
+    Image grid;
+
+    VBlankAttachment vblank{ this, [this] { update(); } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumView)
+};
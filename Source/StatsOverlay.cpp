@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    StatsOverlay.cpp
+    Created: 25 Oct 2026 2:36:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "StatsOverlay.h"
+#include "MemoryBudget.h"
+
+namespace
+{
+    const int refreshHz = 4;
+    const float fontHeight = 12.0f;
+    const int lineHeight = 15;
+    const int margin = 8;
+
+    String toMegabytes(int64 numBytes)
+    {
+        return String((double) numBytes / (1024.0 * 1024.0), 1) + " MB";
+    }
+}
+
+StatsOverlay::StatsOverlay(DJMixer& _mixer) : mixer(_mixer)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+StatsOverlay::~StatsOverlay()
+{
+}
+
+int StatsOverlay::getIdealHeight() const
+{
+    return jmax(1, lines.size()) * lineHeight + 2 * margin;
+}
+
+void StatsOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(refreshHz);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void StatsOverlay::timerCallback()
+{
+    auto& budget = MemoryBudget::getInstance();
+    lines.clearQuick();
+
+    lines.add("Audio load   " + String(roundToInt(mixer.getProcessingLoad() * 100.0)) + "%");
+    lines.add("Memory       " + toMegabytes((int64) budget.getUsedBytes()) + " of " + toMegabytes((int64) budget.getLimit()));
+    lines.add("Evicted      " + toMegabytes(budget.getEvictedBytes()));
+    lines.add({});
+
+    for (auto& usage : budget.getUsage())
+    {
+        auto pinned = usage.usedBytes - jmin(usage.usedBytes, usage.evictableBytes);
+
+        lines.add(usage.subsystem.paddedRight(' ', 18) + toMegabytes((int64) usage.usedBytes).paddedLeft(' ', 10)
+                  + (pinned > 0 ? "  " + toMegabytes((int64) pinned) + " pinned" : String())
+                  + "  (" + MemoryBudget::getCostName(usage.cost) + ")");
+    }
+
+    // grows upwards, as it sits on the status bar
+    if (getHeight() != getIdealHeight())
+        setBounds(getBounds().withTop(getBottom() - getIdealHeight()));
+
+    repaint();
+}
+
+void StatsOverlay::paint(Graphics& g)
+{
+    g.setColour(Colours::black.withAlpha(0.75f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 6.0f);
+
+    g.setColour(Colours::white);
+    g.setFont(Font(Font::getDefaultMonospacedFontName(), fontHeight, Font::plain));
+
+    auto area = getLocalBounds().reduced(margin);
+
+    for (auto& line : lines)
+        g.drawText(line, area.removeFromTop(lineHeight), Justification::centredLeft, false);
+}
@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    StatsOverlay.h
+    Created: 25 Oct 2026 2:36:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DJMixer.h"
+
+//==============================================================================
+/*
+    A small panel over the library with what the engine is using: the audio
+    callback's load, and the memory budget's total, limit and evictions with
+    each subsystem's share and how much of it could be evicted.
+
+    It reads everything four times a second while it's visible, and lets
+    clicks through to what's underneath.
+*/
+class StatsOverlay : public Component,
+                     private Timer
+{
+public:
+    explicit StatsOverlay(DJMixer& mixer);
+    ~StatsOverlay();
+
+    /** the height the current lines need; it keeps its bottom edge where it is when that changes */
+    int getIdealHeight() const;
+
+    void paint(Graphics&) override;
+    void visibilityChanged() override;
+
+private:
+    void timerCallback() override;
+
+    DJMixer& mixer;
+    StringArray lines;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StatsOverlay)
+};
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    StemReader.cpp
+    Created: 22 Oct 2026 2:37:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "StemReader.h"
+#include "HttpTrackStream.h"
+
+namespace
+{
+    const char* const stemNames[] = { "drums", "bass", "melody", "vocals" };
+
+    // enough for a few seconds of each sibling per disk read
+    const int siblingBufferBytes = 1 << 20;
+}
+
+//==============================================================================
+AudioFormatReader* StemReader::createReaderFor(AudioFormatManager& formatManager, const URL& url, bool mixDown)
+{
+    auto siblings = url.isLocalFile() ? findSiblingStems(url.getLocalFile()) : Array<File>();
+
+    if (!siblings.isEmpty())
+    {
+        OwnedArray<AudioFormatReader> stemReaders;
+
+        for (auto& sibling : siblings)
+        {
+            std::unique_ptr<FileInputStream> fileStream(sibling.createInputStream());
+            if (fileStream == nullptr)
+                break;
+
+            std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(
+                std::make_unique<BufferedInputStream>(fileStream.release(), siblingBufferBytes, true)));
+
+            if (reader == nullptr || (!stemReaders.isEmpty() && reader->sampleRate != stemReaders[0]->sampleRate))
+                break;
+
+            stemReaders.add(reader.release());
+        }
+
+        if (stemReaders.size() == siblings.size())
+            return new StemReader(stemReaders, mixDown);
+
+        DBG("StemReader - Couldn't read the stems next to " + url.getFileName() + ", playing it on its own");
+    }
+
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(HttpTrackStream::createInputStreamFor(url)));
+
+    if (reader != nullptr && mixDown && getNumStems((int) reader->numChannels) > 1)
+    {
+        OwnedArray<AudioFormatReader> stemReaders;
+        stemReaders.add(reader.release());
+        return new StemReader(stemReaders, true);
+    }
+
+    return reader.release();
+}
+
+Array<File> StemReader::findSiblingStems(const File& file)
+{
+    auto name = file.getFileNameWithoutExtension();
+
+    if (!name.containsChar('.'))
+        return {};
+
+    auto trackName = name.upToLastOccurrenceOf(".", false, false);
+    auto stemName = name.fromLastOccurrenceOf(".", false, false);
+
+    auto isStem = false;
+    for (auto* candidate : stemNames)
+        isStem = isStem || stemName.equalsIgnoreCase(candidate);
+
+    if (trackName.isEmpty() || !isStem)
+        return {};
+
+    Array<File> siblings;
+
+    for (auto* candidate : stemNames)
+    {
+        auto sibling = file.getSiblingFile(trackName + "." + candidate + file.getFileExtension());
+        if (!sibling.existsAsFile())
+            return {};
+
+        siblings.add(sibling);
+    }
+
+    return siblings;
+}
+
+int StemReader::getNumStems(int numChannels)
+{
+    return numChannels >= 4 ? jmin(maxStems, numChannels / 2) : 1;
+}
+
+String StemReader::getStemName(int stem)
+{
+    return isPositiveAndBelow(stem, maxStems) ? String(stemNames[stem]).toUpperCase() : String();
+}
+
+//==============================================================================
+StemReader::StemReader(OwnedArray<AudioFormatReader>& stemReaders, bool _mixDown)
+    : AudioFormatReader(nullptr, "Stems"),
+      mixDown(_mixDown)
+{
+    sampleRate = stemReaders[0]->sampleRate;
+    bitsPerSample = 32;
+    usesFloatingPointData = true;
+    lengthInSamples = stemReaders[0]->lengthInSamples;
+
+    auto totalChannels = 0;
+
+    while (!stemReaders.isEmpty() && totalChannels < 2 * maxStems)
+    {
+        auto* reader = stemReaders.removeAndReturn(0);
+
+        // a single stem file is read as one stereo pair, a multi-channel one as all its pairs
+        auto channelsToRead = stemReaders.isEmpty() && readers.isEmpty()
+                            ? 2 * getNumStems((int) reader->numChannels) : 2;
+        channelsToRead = jmin(channelsToRead, 2 * maxStems - totalChannels);
+
+        lengthInSamples = jmin(lengthInSamples, reader->lengthInSamples);
+        readers.add(reader);
+        readerChannels.add(channelsToRead);
+        totalChannels += channelsToRead;
+    }
+
+    stemReaders.clear();
+    numChannels = (unsigned int) (mixDown ? 2 : totalChannels);
+}
+
+StemReader::~StemReader()
+{
+}
+
+bool StemReader::readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                             int64 startSampleInFile, int numSamples)
+{
+    auto channel = 0;
+
+    for (int i = 0; i < readers.size(); ++i)
+    {
+        scratch.setSize(readerChannels[i], numSamples, false, false, true);
+        readers[i]->read(&scratch, 0, numSamples, startSampleInFile, true, true);
+
+        for (int readerChannel = 0; readerChannel < readerChannels[i]; ++readerChannel, ++channel)
+        {
+            // mixed down, every stem's left lands on channel 0 and its right on channel 1
+            auto destChannel = mixDown ? channel % 2 : channel;
+
+            if (destChannel >= numDestChannels || destChannels[destChannel] == nullptr)
+                continue;
+
+            auto* dest = reinterpret_cast<float*>(destChannels[destChannel]) + startOffsetInDestBuffer;
+            auto* source = scratch.getReadPointer(readerChannel);
+
+            if (destChannel != channel)
+                FloatVectorOperations::add(dest, source, numSamples);
+            else
+                FloatVectorOperations::copy(dest, source, numSamples);
+        }
+    }
+
+    return true;
+}
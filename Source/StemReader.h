@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    StemReader.h
+    Created: 22 Oct 2026 2:37:51pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Reads a stem track as one multi-channel reader: each stem is a stereo pair,
+    drums on channels 0-1, then bass, melody and vocals.
+
+    A stem track is either one file with a pair of channels per stem, or four
+    sibling files named Track.drums.wav, Track.bass.wav, Track.melody.wav and
+    Track.vocals.wav, any of which loads the set. Siblings are read through
+    large buffers, so streaming four files costs about as many disk reads as
+    streaming one.
+
+    The deck plays the stems separately and mixes them itself. Everything else
+    that reads a stem track, like the analysis, asks for it mixed down to
+    stereo.
+*/
+class StemReader : public AudioFormatReader
+{
+public:
+    static constexpr int maxStems = 4;
+
+    /** A reader for the track at url: its sibling stems side by side if it is one of a
+        set, otherwise the file's own reader. With mixDown, a stem track is summed to
+        stereo. nullptr if it can't be read.
+    */
+    static AudioFormatReader* createReaderFor(AudioFormatManager& formatManager, const URL& url, bool mixDown = false);
+
+    /** the whole set if file is one of a set of sibling stems, otherwise empty */
+    static Array<File> findSiblingStems(const File& file);
+
+    /** how many stems a track with this many channels holds; 1 for an ordinary track */
+    static int getNumStems(int numChannels);
+    static String getStemName(int stem);
+
+    ~StemReader() override;
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     int64 startSampleInFile, int numSamples) override;
+
+private:
+    /** takes ownership of the readers, which must all be at the same sample rate */
+    StemReader(OwnedArray<AudioFormatReader>& stemReaders, bool mixDown);
+
+    OwnedArray<AudioFormatReader> readers;
+    Array<int> readerChannels;
+    const bool mixDown;
+    AudioBuffer<float> scratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StemReader)
+};
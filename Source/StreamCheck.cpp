@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+    StreamCheck.cpp
+    Created: 24 Oct 2026 2:27:40pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "StreamCheck.h"
+#include "HttpTrackStream.h"
+#include "CheckResults.h"
+
+namespace
+{
+    const double sampleRate = 44100.0;
+    const double trackSeconds = 30.0;
+    const int latencyMs = 40;           // added to every request, like a server across town
+    const double maxStartMs = 500.0;
+    const int numRandomReads = 200;
+    const int samplesToCompare = 4096;
+
+    /** a 16 bit stereo WAV of a slow sweep, in memory */
+    MemoryBlock makeTestTrack()
+    {
+        MemoryBlock content;
+        WavAudioFormat wav;
+        std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(new MemoryOutputStream(content, false),
+                                                                      sampleRate, 2, 16, {}, 0));
+        auto numSamples = (int) (trackSeconds * sampleRate);
+        AudioBuffer<float> buffer(2, numSamples);
+        auto phase = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            phase += MathConstants<double>::twoPi * (100.0 + 2000.0 * i / numSamples) / sampleRate;
+            buffer.setSample(0, i, 0.5f * (float) std::sin(phase));
+            buffer.setSample(1, i, 0.5f * (float) std::cos(phase));
+        }
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        writer.reset(); // writes the header lengths
+        return content;
+    }
+
+    //==============================================================================
+    /** answers one request at a time, like a small media server would */
+    class StandInServer : public Thread
+    {
+    public:
+        StandInServer(const MemoryBlock& _content, bool _supportsRanges)
+            : Thread("Stand-in media server"), content(_content), supportsRanges(_supportsRanges)
+        {
+        }
+
+        ~StandInServer() override
+        {
+            signalThreadShouldExit();
+            listener.close();
+            stopThread(2000);
+        }
+
+        bool start()
+        {
+            if (!listener.createListener(0, "127.0.0.1"))
+                return false;
+
+            startThread();
+            return true;
+        }
+
+        URL getURL(const String& name) const
+        {
+            return URL("http://127.0.0.1:" + String(listener.getBoundPort()) + "/" + name);
+        }
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                std::unique_ptr<StreamingSocket> client(listener.waitForNextConnection());
+
+                if (client != nullptr)
+                    respond(*client);
+            }
+        }
+
+        std::atomic<int> numRequests{ 0 };
+
+    private:
+        void respond(StreamingSocket& client)
+        {
+            String request;
+
+            while (!request.endsWith("\r\n\r\n"))
+            {
+                char c = 0;
+
+                if (request.length() > 8192 || client.waitUntilReady(true, 2000) != 1 || client.read(&c, 1, true) != 1)
+                    return;
+
+                request += c;
+            }
+
+            ++numRequests;
+            Thread::sleep(latencyMs);
+
+            auto size = (int64) content.getSize();
+            int64 start = 0, end = size - 1;
+            auto partial = false;
+
+            for (auto& line : StringArray::fromLines(request))
+            {
+                if (supportsRanges && line.startsWithIgnoreCase("Range:"))
+                {
+                    auto range = line.fromFirstOccurrenceOf("bytes=", false, true);
+                    start = range.upToFirstOccurrenceOf("-", false, false).getLargeIntValue();
+
+                    auto last = range.fromFirstOccurrenceOf("-", false, false).trim();
+                    end = last.isEmpty() ? size - 1 : jmin(size - 1, last.getLargeIntValue());
+                    partial = start <= end;
+                }
+            }
+
+            String header(partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n");
+            header << "Content-Length: " << String(end - start + 1) << "\r\n";
+
+            if (partial)
+                header << "Content-Range: bytes " << String(start) << "-" << String(end) << "/" << String(size) << "\r\n";
+
+            header << "Accept-Ranges: " << (supportsRanges ? "bytes" : "none") << "\r\n"
+                   << "Content-Type: audio/wav\r\nConnection: close\r\n\r\n";
+
+            if (client.write(header.toRawUTF8(), (int) header.getNumBytesAsUTF8()) < 0)
+                return;
+
+            // the client hangs up part way when it has been asked for something else
+            for (auto position = start; position <= end && !threadShouldExit();)
+            {
+                auto numBytes = (int) jmin((int64) 16384, end + 1 - position);
+
+                if (client.write(static_cast<const char*>(content.getData()) + position, numBytes) < 0)
+                    return;
+
+                position += numBytes;
+            }
+        }
+
+        const MemoryBlock& content;
+        const bool supportsRanges;
+        StreamingSocket listener;
+    };
+
+    //==============================================================================
+    double millisecondsSince(double start)
+    {
+        return Time::getMillisecondCounterHiRes() - start;
+    }
+
+    /** the decoded samples at start match the original's */
+    bool samplesMatch(AudioFormatReader& streamed, AudioFormatReader& original, int64 start)
+    {
+        AudioBuffer<float> a(2, samplesToCompare), b(2, samplesToCompare);
+        streamed.read(&a, 0, samplesToCompare, start, true, true);
+        original.read(&b, 0, samplesToCompare, start, true, true);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < samplesToCompare; ++i)
+                if (a.getSample(channel, i) != b.getSample(channel, i))
+                    return false;
+
+        return true;
+    }
+
+    /** first audio, then a seek near the end, both decoded through the stream */
+    void checkPlayback(CheckResults& results, AudioFormatManager& formatManager, const URL& url,
+                       const MemoryBlock& content, bool expectFastStart)
+    {
+        auto started = Time::getMillisecondCounterHiRes();
+
+        std::unique_ptr<AudioFormatReader> streamed(formatManager.createReaderFor(HttpTrackStream::createInputStreamFor(url)));
+        std::unique_ptr<AudioFormatReader> original(formatManager.createReaderFor(std::make_unique<MemoryInputStream>(content, false)));
+
+        if (!results.expect(streamed != nullptr && original != nullptr, "couldn't open " + url.toString(false)))
+            return;
+
+        auto startMatches = samplesMatch(*streamed, *original, 0);
+        auto startMs = millisecondsSince(started);
+        std::cout << "  first audio after " << String(startMs, 1) << " ms" << std::endl;
+
+        results.expect(startMatches, "the first samples differ");
+        results.expect(!expectFastStart || startMs <= maxStartMs, "took longer than " + String(maxStartMs) + " ms to start");
+
+        auto seeked = Time::getMillisecondCounterHiRes();
+        auto seekMatches = samplesMatch(*streamed, *original, (int64) (streamed->lengthInSamples * 0.9));
+        std::cout << "  seek to 90% after " << String(millisecondsSince(seeked), 1) << " ms" << std::endl;
+
+        results.expect(seekMatches, "the samples after the seek differ");
+    }
+
+    /** random reads through one stream, every byte compared */
+    void checkRandomReads(CheckResults& results, const URL& url, const MemoryBlock& content)
+    {
+        auto stream = HttpTrackStream::createInputStreamFor(url);
+
+        if (!results.expect(stream != nullptr && stream->getTotalLength() == (int64) content.getSize(),
+                            "the stream has the wrong length"))
+            return;
+
+        Random random(20261024);
+        HeapBlock<char> buffer(1 << 17);
+        auto* original = static_cast<const char*>(content.getData());
+
+        for (int i = 0; i < numRandomReads; ++i)
+        {
+            auto position = random.nextInt64() % (int64) content.getSize();
+            position = position < 0 ? -position : position;
+            auto numBytes = 1 + random.nextInt(1 << 17);
+
+            stream->setPosition(position);
+            auto numRead = stream->read(buffer, numBytes);
+            auto expected = (int) jmin((int64) numBytes, (int64) content.getSize() - position);
+
+            if (!results.expect(numRead == expected && memcmp(buffer, original + position, (size_t) numRead) == 0,
+                                "read " + String(i) + " at " + String(position) + " differs"))
+                return;
+        }
+
+        std::cout << "  " << numRandomReads << " random reads match" << std::endl;
+    }
+}
+
+//==============================================================================
+int StreamCheck::run()
+{
+    std::cout << "OtoDecks stream check" << std::endl;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto content = makeTestTrack();
+    CheckResults results;
+    auto name = "check-" + String::toHexString(Random::getSystemRandom().nextInt64()) + ".wav";
+
+    URL cachedURL;
+    auto requestsToFill = 0;
+
+    for (auto supportsRanges : { true, false })
+    {
+        std::cout << (supportsRanges ? "With range requests" : "Without range support") << std::endl;
+
+        StandInServer server(content, supportsRanges);
+
+        if (!results.expect(server.start(), "couldn't start the stand-in server"))
+            return results.finish();
+
+        auto url = server.getURL(name);
+        checkPlayback(results, formatManager, url, content, supportsRanges);
+        checkRandomReads(results, url, content);
+
+        if (supportsRanges)
+        {
+            // read to the end, so every block is on disk for the cache check
+            auto stream = HttpTrackStream::createInputStreamFor(url);
+            MemoryBlock all;
+
+            results.expect(stream != nullptr && stream->readIntoMemoryBlock(all) == content.getSize(),
+                           "couldn't read the whole track");
+
+            cachedURL = url;
+            requestsToFill = server.numRequests;
+        }
+        else
+        {
+            HttpTrackStream::removeFromCache(url);
+        }
+
+        std::cout << "  " << server.numRequests.load() << " requests" << std::endl;
+    }
+
+    // the servers have gone, so only the cache can answer now
+    std::cout << "From the disk cache, " << requestsToFill << " requests to fill it" << std::endl;
+    checkRandomReads(results, cachedURL, content);
+    HttpTrackStream::removeFromCache(cachedURL);
+
+    return results.finish();
+}
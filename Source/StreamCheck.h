@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    StreamCheck.h
+    Created: 24 Oct 2026 2:27:40pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Headless check of HttpTrackStream, started with --stream-check.
+
+    A stand-in media server on 127.0.0.1 serves a generated WAV track with a
+    delay on every request, with range support and then without. Against each,
+    the check times how long until the first block of audio is decoded and
+    how long a seek to near the end takes, and compares the bytes of random
+    reads and the decoded samples with the original. It then stops the server
+    and reads the track again from the disk cache alone.
+*/
+class StreamCheck
+{
+public:
+    /** runs every part, printing progress; returns the process exit code */
+    static int run();
+};
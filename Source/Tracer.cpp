@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    Tracer.cpp
+    Created: 21 Oct 2026 5:12:30pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "Tracer.h"
+
+std::atomic<bool> Tracer::enabled{ false };
+
+namespace
+{
+    const size_t maxEventsPerThread = 1 << 20;
+
+    struct Event
+    {
+        const char* name;
+        int64 startTicks;
+        int64 endTicks;
+    };
+
+    /** one per thread that has recorded anything; owned by the registry so it outlives the thread */
+    struct ThreadLog
+    {
+        int id = 0;
+        String threadName;
+        SpinLock lock;
+        std::vector<Event> events;
+    };
+
+    struct Registry
+    {
+        CriticalSection lock;
+        OwnedArray<ThreadLog> logs;
+        int64 startTicks = 0;
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadLog& getThreadLog()
+    {
+        thread_local ThreadLog* log = nullptr;
+
+        if (log == nullptr)
+        {
+            auto& registry = getRegistry();
+            const ScopedLock sl(registry.lock);
+
+            log = registry.logs.add(new ThreadLog());
+            log->id = registry.logs.size();
+
+            if (MessageManager::existsAndIsCurrentThread())
+                log->threadName = "Message thread";
+            else if (auto* thread = Thread::getCurrentThread())
+                log->threadName = thread->getThreadName();
+            else
+                log->threadName = "Thread " + String(log->id);
+        }
+
+        return *log;
+    }
+
+    double ticksToMicroseconds(int64 ticks)
+    {
+        return Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+    }
+}
+
+//==============================================================================
+void Tracer::start()
+{
+    auto& registry = getRegistry();
+    const ScopedLock sl(registry.lock);
+
+    for (auto* log : registry.logs)
+    {
+        const SpinLock::ScopedLockType logLock(log->lock);
+        log->events.clear();
+    }
+
+    registry.startTicks = Time::getHighResolutionTicks();
+    enabled = true;
+    DBG("Tracer - Recording");
+}
+
+bool Tracer::stopAndWrite(const File& file)
+{
+    enabled = false;
+
+    auto& registry = getRegistry();
+    const ScopedLock sl(registry.lock);
+    MemoryOutputStream json;
+    auto first = true;
+
+    auto separator = [&]
+    {
+        json << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (auto* log : registry.logs)
+    {
+        const SpinLock::ScopedLockType logLock(log->lock);
+
+        separator();
+        json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << log->id
+             << ",\"args\":{\"name\":" << JSON::toString(log->threadName) << "}}";
+
+        for (auto& event : log->events)
+        {
+            separator();
+            json << "{\"name\":" << JSON::toString(String(event.name))
+                 << ",\"cat\":\"otodecks\",\"ph\":\"X\",\"pid\":1,\"tid\":" << log->id
+                 << ",\"ts\":" << String(ticksToMicroseconds(event.startTicks - registry.startTicks), 1)
+                 << ",\"dur\":" << String(ticksToMicroseconds(event.endTicks - event.startTicks), 1) << "}";
+        }
+
+        log->events.clear();
+    }
+
+    json << "\n]}\n";
+
+    auto written = file.replaceWithText(json.toString());
+    DBG("Tracer - " + String(written ? "Wrote " : "Couldn't write ") + file.getFullPathName());
+    return written;
+}
+
+void Tracer::record(const char* name, int64 startTicks, int64 endTicks)
+{
+    if (!isEnabled())
+        return;
+
+    auto& log = getThreadLog();
+    const SpinLock::ScopedLockType sl(log.lock);
+
+    if (log.events.size() < maxEventsPerThread)
+        log.events.push_back({ name, startTicks, endTicks });
+}
+
+File Tracer::getDefaultFile()
+{
+    auto folder = File::getSpecialLocation(File::userMusicDirectory).getChildFile("OtoDecks Sessions");
+    folder.createDirectory();
+
+    auto name = "trace-" + Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S");
+    return folder.getNonexistentChildFile(name, ".json");
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    Tracer.h
+    Created: 21 Oct 2026 5:12:30pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+// set to 0 to compile every TRACE_SPAN and TRACE_SPAN_SINCE away
+#ifndef OTODECKS_TRACING
+ #define OTODECKS_TRACING 1
+#endif
+
+//==============================================================================
+/*
+    Records timed spans from any thread and writes them as a Chrome trace,
+    which chrome://tracing and ui.perfetto.dev open with one row per thread.
+
+    While recording is off a span costs one relaxed atomic load. While it is on,
+    each thread appends to its own log behind its own spin lock, so threads
+    never wait on each other; the lock only matters while the trace is written.
+
+    Start it with --trace [file] on the command line, or toggle it with
+    Ctrl+Shift+T in the running app.
+*/
+class Tracer
+{
+public:
+    /** clears anything recorded and starts recording */
+    static void start();
+    /** stops recording and writes the trace; false if the file couldn't be written */
+    static bool stopAndWrite(const File& file);
+
+    static bool isEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /** adds a span that began and ended at these high resolution ticks; the name must be a literal */
+    static void record(const char* name, int64 startTicks, int64 endTicks);
+
+    /** a new file for a trace, next to the session recordings */
+    static File getDefaultFile();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+//==============================================================================
+/** times the scope it lives in, when the tracer is recording */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* _name) noexcept
+        : name(_name), startTicks(Tracer::isEnabled() ? Time::getHighResolutionTicks() : 0)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (startTicks != 0)
+            Tracer::record(name, startTicks, Time::getHighResolutionTicks());
+    }
+
+private:
+    const char* name;
+    int64 startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceSpan)
+};
+
+/** TRACE_SPAN times the enclosing scope; TRACE_SPAN_SINCE ends a span here that began at
+    startTicks, for work that finishes somewhere other than where it started */
+#if OTODECKS_TRACING
+ #define TRACE_SPAN(name) TraceSpan JUCE_JOIN_MACRO(traceSpan, __LINE__) (name)
+ #define TRACE_SPAN_SINCE(name, startTicks) Tracer::record(name, startTicks, Time::getHighResolutionTicks())
+#else
+ #define TRACE_SPAN(name)
+ #define TRACE_SPAN_SINCE(name, startTicks)
+#endif
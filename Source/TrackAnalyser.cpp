@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.cpp
+    Created: 19 Oct 2026 1:05:18pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "TrackAnalyser.h"
+#include "Tracer.h"
+#include "MemoryBudget.h"
+
+namespace
+{
+    const double framesPerSecond = 200.0;   // 5 ms onset resolution
+    const double maxAnalysisSeconds = 240.0;
+
+    const double loudnessBlockSeconds = 0.25;
+    const float audibleLevel = 0.01f;        // -40 dB RMS
+    const float fullLevelRatio = 0.5f;       // -6 dB below the loud part of the track
+
+    // key: a chroma vector summed from one FFT a second, matched against the Krumhansl-Kessler profiles
+    const int keyFftOrder = 12;
+    const int keyBlockInterval = 4;          // every fourth loudness block
+    const double minKeyHz = 55.0, maxKeyHz = 1760.0;
+    const float majorProfile[] = { 6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f, 2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f };
+    const float minorProfile[] = { 6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f, 2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f };
+
+    /** positive log-energy flux between consecutive frames */
+    std::vector<float> buildOnsetEnvelope(AudioFormatReader& reader, int hopSize,
+                                          const std::function<bool()>& shouldExit)
+    {
+        auto numSamples = jmin<int64>(reader.lengthInSamples, (int64) (reader.sampleRate * maxAnalysisSeconds));
+        auto numFrames = (int) (numSamples / hopSize);
+
+        std::vector<float> onsets((size_t) jmax(0, numFrames), 0.0f);
+        AudioBuffer<float> chunk(2, hopSize * 64);
+        MemoryBudget::Tally::Scoped scratch(MemoryBudget::getInstance().getAnalysisScratch(), (onsets.size() + 2 * (size_t) chunk.getNumSamples()) * sizeof(float));
+
+        float previous = 0.0f;
+        int frame = 0;
+
+        for (int64 start = 0; start < numSamples && frame < numFrames; start += chunk.getNumSamples())
+        {
+            if (shouldExit != nullptr && shouldExit())
+                return {};
+
+            auto numToRead = (int) jmin<int64>(chunk.getNumSamples(), numSamples - start);
+            reader.read(&chunk, 0, numToRead, start, true, true);
+
+            for (int offset = 0; offset + hopSize <= numToRead && frame < numFrames; offset += hopSize)
+            {
+                auto* left = chunk.getReadPointer(0, offset);
+                auto* right = chunk.getReadPointer(1, offset);
+
+                float energy = 0.0f;
+                for (int i = 0; i < hopSize; ++i)
+                {
+                    auto mono = 0.5f * (left[i] + right[i]);
+                    energy += mono * mono;
+                }
+
+                auto level = std::log(1.0f + 1000.0f * energy / (float) hopSize);
+                onsets[(size_t) frame++] = jmax(0.0f, level - previous);
+                previous = level;
+            }
+        }
+
+        onsets.resize((size_t) frame);
+        return onsets;
+    }
+
+    /** Pearson correlation of a chroma vector, rotated to a tonic, with a key profile */
+    float keyCorrelation(const float* chroma, const float* profile, int tonic)
+    {
+        float chromaMean = 0.0f, profileMean = 0.0f;
+        for (int i = 0; i < 12; ++i)
+        {
+            chromaMean += chroma[i] / 12.0f;
+            profileMean += profile[i] / 12.0f;
+        }
+
+        float product = 0.0f, chromaSquares = 0.0f, profileSquares = 0.0f;
+        for (int i = 0; i < 12; ++i)
+        {
+            auto c = chroma[(i + tonic) % 12] - chromaMean;
+            auto p = profile[i] - profileMean;
+            product += c * p;
+            chromaSquares += c * c;
+            profileSquares += p * p;
+        }
+
+        return product / jmax(1.0e-9f, std::sqrt(chromaSquares * profileSquares));
+    }
+
+    /** the best matching key for a chroma vector: 0-11 major, 12-23 minor, by tonic pitch class */
+    int findKey(const float* chroma)
+    {
+        auto bestKey = -1;
+        auto bestScore = 0.0f;
+
+        for (int tonic = 0; tonic < 12; ++tonic)
+        {
+            for (int minor = 0; minor < 2; ++minor)
+            {
+                auto score = keyCorrelation(chroma, minor ? minorProfile : majorProfile, tonic);
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestKey = tonic + 12 * minor;
+                }
+            }
+        }
+
+        return bestKey;
+    }
+
+    /** one decoding pass over the whole track: the cue and intro/outro points and the
+        loudness from the RMS of short blocks, and the key from an FFT of some of them */
+    void scanWholeTrack(AudioFormatReader& reader, TrackAnalysis& result,
+                        const std::function<bool()>& shouldExit)
+    {
+        auto blockSize = jmax(1, roundToInt(reader.sampleRate * loudnessBlockSeconds));
+        auto numBlocks = (int) (reader.lengthInSamples / blockSize);
+
+        if (numBlocks < 4)
+            return;
+
+        std::vector<float> levels((size_t) numBlocks, 0.0f);
+        AudioBuffer<float> block(2, blockSize);
+
+        dsp::FFT fft(keyFftOrder);
+        auto fftSize = fft.getSize();
+        dsp::WindowingFunction<float> window((size_t) fftSize, dsp::WindowingFunction<float>::hann);
+        std::vector<float> fftData((size_t) fftSize * 2, 0.0f);
+        float chroma[12] = {};
+
+        // which pitch class each FFT bin falls in, -1 outside the range we listen to
+        std::vector<int> binPitchClass((size_t) fftSize / 2, -1);
+        MemoryBudget::Tally::Scoped scratch(MemoryBudget::getInstance().getAnalysisScratch(),
+                                            (levels.size() + 2 * (size_t) blockSize + fftData.size()) * sizeof(float)
+                                                + binPitchClass.size() * sizeof(int));
+        for (int bin = 1; bin < fftSize / 2; ++bin)
+        {
+            auto hz = bin * reader.sampleRate / fftSize;
+            if (hz >= minKeyHz && hz <= maxKeyHz)
+                binPitchClass[(size_t) bin] = ((roundToInt(12.0 * std::log2(hz / 440.0)) + 69) % 12 + 12) % 12;
+        }
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            if (shouldExit != nullptr && (i & 63) == 0 && shouldExit())
+                return;
+
+            reader.read(&block, 0, blockSize, (int64) i * blockSize, true, true);
+            levels[(size_t) i] = 0.5f * (block.getRMSLevel(0, 0, blockSize) + block.getRMSLevel(1, 0, blockSize));
+
+            if (i % keyBlockInterval != 0 || blockSize < fftSize || levels[(size_t) i] < audibleLevel)
+                continue;
+
+            auto* left = block.getReadPointer(0);
+            auto* right = block.getReadPointer(1);
+            for (int n = 0; n < fftSize; ++n)
+                fftData[(size_t) n] = 0.5f * (left[n] + right[n]);
+
+            window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+            fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+            for (int bin = 1; bin < fftSize / 2; ++bin)
+                if (binPitchClass[(size_t) bin] >= 0)
+                    chroma[binPitchClass[(size_t) bin]] += fftData[(size_t) bin];
+        }
+
+        result.key = findKey(chroma);
+
+        // loudness: the mean power of the audible blocks
+        double power = 0.0;
+        int numAudible = 0;
+        for (auto level : levels)
+        {
+            if (level >= audibleLevel)
+            {
+                power += level * level;
+                ++numAudible;
+            }
+        }
+
+        if (numAudible > 0)
+            result.loudnessDb = Decibels::gainToDecibels(std::sqrt(power / numAudible), -100.0);
+
+        // the level three quarters of the way up stands for the body of the track
+        auto sorted = levels;
+        std::nth_element(sorted.begin(), sorted.begin() + (numBlocks * 3) / 4, sorted.end());
+        auto fullLevel = jmax(audibleLevel, sorted[(size_t) (numBlocks * 3) / 4] * fullLevelRatio);
+
+        auto first = [&](float threshold)
+        {
+            for (int i = 0; i < numBlocks; ++i)
+                if (levels[(size_t) i] >= threshold)
+                    return i;
+            return 0;
+        };
+
+        auto last = [&](float threshold)
+        {
+            for (int i = numBlocks; --i >= 0;)
+                if (levels[(size_t) i] >= threshold)
+                    return i + 1;
+            return numBlocks;
+        };
+
+        auto toSeconds = [&](int blockIndex) { return (double) blockIndex * blockSize / reader.sampleRate; };
+
+        result.cueInSeconds = toSeconds(first(audibleLevel));
+        result.introEndSeconds = toSeconds(first(fullLevel));
+        result.outroStartSeconds = toSeconds(last(fullLevel));
+        result.cueOutSeconds = toSeconds(last(audibleLevel));
+    }
+
+    /** moves a mix point onto the nearest beat of the grid */
+    double snapToBeat(double seconds, const TrackAnalysis& analysis)
+    {
+        auto beatLength = 60.0 / analysis.bpm;
+        return analysis.firstBeatSeconds + std::round((seconds - analysis.firstBeatSeconds) / beatLength) * beatLength;
+    }
+}
+
+TrackAnalysis TrackAnalyser::analyse(AudioFormatReader& reader, std::function<bool()> shouldExit)
+{
+    TRACE_SPAN("TrackAnalyser::analyse");
+
+    TrackAnalysis result;
+
+    if (reader.sampleRate <= 0.0 || reader.lengthInSamples <= 0)
+        return result;
+
+    scanWholeTrack(reader, result, shouldExit);
+
+    auto hopSize = jmax(1, roundToInt(reader.sampleRate / framesPerSecond));
+    auto fps = reader.sampleRate / hopSize;
+    auto onsets = buildOnsetEnvelope(reader, hopSize, shouldExit);
+    MemoryBudget::Tally::Scoped scratch(MemoryBudget::getInstance().getAnalysisScratch(), onsets.size() * sizeof(float));
+
+    // energy: onset flux per second, squashed into 0-1
+    if (!onsets.empty())
+    {
+        auto flux = std::accumulate(onsets.begin(), onsets.end(), 0.0) / (double) onsets.size() * fps;
+        result.energy = flux / (1.0 + flux);
+    }
+
+    auto minLag = (int) std::floor(fps * 60.0 / maxBpm);
+    auto maxLag = (int) std::ceil(fps * 60.0 / minBpm);
+    auto numFrames = (int) onsets.size();
+
+    if (numFrames < maxLag * 4)
+        return result;
+
+    // tempo: strongest autocorrelation lag in range, refined with a parabola
+    std::vector<double> correlation((size_t) maxLag + 2, 0.0);
+    for (int lag = minLag - 1; lag <= maxLag + 1; ++lag)
+    {
+        double sum = 0.0;
+        for (int i = 0; i + lag < numFrames; ++i)
+            sum += onsets[(size_t) i] * onsets[(size_t) (i + lag)];
+
+        correlation[(size_t) lag] = sum / (numFrames - lag);
+    }
+
+    auto bestLag = minLag;
+    for (int lag = minLag; lag <= maxLag; ++lag)
+        if (correlation[(size_t) lag] > correlation[(size_t) bestLag])
+            bestLag = lag;
+
+    auto before = correlation[(size_t) bestLag - 1];
+    auto peak = correlation[(size_t) bestLag];
+    auto after = correlation[(size_t) bestLag + 1];
+    auto curvature = before - 2.0 * peak + after;
+    auto period = (double) bestLag + (curvature != 0.0 ? 0.5 * (before - after) / curvature : 0.0);
+
+    // phase: the offset whose beat positions collect the most onset energy
+    auto bestOffset = 0;
+    auto bestScore = -1.0;
+    for (int offset = 0; offset < bestLag; ++offset)
+    {
+        double score = 0.0;
+        for (double beat = offset; beat < numFrames; beat += period)
+            score += onsets[(size_t) beat];
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestOffset = offset;
+        }
+    }
+
+    result.bpm = 60.0 * fps / period;
+    result.firstBeatSeconds = bestOffset / fps;
+
+    if (result.hasMixPoints())
+    {
+        result.introEndSeconds = jmax(result.cueInSeconds, snapToBeat(result.introEndSeconds, result));
+        result.outroStartSeconds = jmin(result.cueOutSeconds, snapToBeat(result.outroStartSeconds, result));
+    }
+
+    return result;
+}
+
+int TrackAnalyser::getCamelotNumber(int key)
+{
+    // minor keys sit on the same number as their relative major, three semitones up
+    auto majorTonic = key < 12 ? key : (key - 12 + 3) % 12;
+    return (majorTonic * 7 + 7) % 12 + 1;
+}
+
+String TrackAnalyser::getCamelotName(int key)
+{
+    if (!isPositiveAndBelow(key, 24))
+        return "--";
+
+    return String(getCamelotNumber(key)) + (key < 12 ? "B" : "A");
+}
+
+//==============================================================================
+TrackAnalysisJob::TrackAnalysisJob(AudioFormatReader* _reader,
+                                   std::function<void(const TrackAnalysis&)> _onFinished)
+    : ThreadPoolJob("Track analysis"),
+      reader(_reader),
+      onFinished(std::move(_onFinished))
+{
+}
+
+ThreadPoolJob::JobStatus TrackAnalysisJob::runJob()
+{
+    auto analysis = TrackAnalyser::analyse(*reader, [this] { return shouldExit(); });
+
+    if (!shouldExit() && onFinished != nullptr)
+        onFinished(analysis);
+
+    return jobHasFinished;
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.h
+    Created: 19 Oct 2026 1:05:18pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/** what we know about a track once it has been analysed */
+struct TrackAnalysis
+{
+    double bpm = 0.0;
+    double firstBeatSeconds = 0.0;   // anchor of the beat grid
+
+    // mix points for automatic transitions, found from the loudness of the whole track
+    double cueInSeconds = 0.0;       // first audible sound
+    double introEndSeconds = 0.0;    // the track reaches full level
+    double outroStartSeconds = 0.0;  // the track starts to drop away
+    double cueOutSeconds = 0.0;      // last audible sound
+
+    // features for matching tracks against each other
+    int key = -1;                    // 0-11 major, 12-23 minor, by tonic pitch class; -1 unknown
+    double loudnessDb = -100.0;      // mean RMS level of the audible parts
+    double energy = 0.0;             // 0-1, how busy the onsets are
+
+    bool hasBeatGrid() const { return bpm > 0.0; }
+    bool hasMixPoints() const { return cueOutSeconds > 0.0; }
+};
+
+//==============================================================================
+/*
+    Offline analysis of a whole track: an onset envelope is built from short
+    energy frames, the tempo comes from its autocorrelation and the grid anchor
+    from the offset that best lines up with the onsets. The intro and outro
+    come from a coarse loudness profile of the whole track and are snapped to
+    the grid when there is one; the key comes from a chroma vector gathered in
+    the same pass.
+*/
+class TrackAnalyser
+{
+public:
+    /** runs on the calling thread; shouldExit is polled between chunks */
+    static TrackAnalysis analyse(AudioFormatReader& reader,
+                                 std::function<bool()> shouldExit = nullptr);
+
+    static constexpr double minBpm = 70.0;
+    static constexpr double maxBpm = 180.0;
+
+    /** a key index as a Camelot wheel code such as "8A", or "--" when unknown */
+    static String getCamelotName(int key);
+    /** the key's position on the Camelot wheel, 1-12 */
+    static int getCamelotNumber(int key);
+};
+
+//==============================================================================
+/*
+    Runs TrackAnalyser on a ThreadPool and hands the result to a callback on
+    the pool thread. The job owns its reader.
+*/
+class TrackAnalysisJob : public ThreadPoolJob
+{
+public:
+    TrackAnalysisJob(AudioFormatReader* reader,
+                     std::function<void(const TrackAnalysis&)> onFinished);
+
+    JobStatus runJob() override;
+
+private:
+    std::unique_ptr<AudioFormatReader> reader;
+    std::function<void(const TrackAnalysis&)> onFinished;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackAnalysisJob)
+};
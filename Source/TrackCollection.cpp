@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    TrackCollection.cpp
+    Created: 23 Oct 2026 5:06:39pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "TrackCollection.h"
+#include "Tracer.h"
+
+File TrackCollection::getDefaultFile()
+{
+    return File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("music_library.txt");
+}
+
+TrackCollection::TrackCollection(const File& _libraryFile) : libraryFile(_libraryFile)
+{
+}
+
+void TrackCollection::load()
+{
+    TRACE_SPAN("TrackCollection::load");
+
+    tracks.clear();
+
+    if (!libraryFile.existsAsFile())
+        return;
+
+    StringArray lines;
+    libraryFile.readLines(lines);
+
+    for (const auto& line : lines)
+    {
+        if (line.trim().isEmpty())
+            continue;
+
+        File track(line.trim());
+
+        if (track.existsAsFile())
+            tracks.push_back(track);
+        else
+            DBG("❌ Skipping invalid file: " + track.getFullPathName());
+    }
+}
+
+bool TrackCollection::save() const
+{
+    TRACE_SPAN("TrackCollection::save");
+
+    String data;
+
+    for (const auto& track : tracks)
+        data += track.getFullPathName() + "\n";
+
+    return libraryFile.replaceWithText(data);
+}
+
+int TrackCollection::add(const Array<File>& files)
+{
+    auto numAdded = 0;
+
+    for (const auto& file : files)
+    {
+        auto exists = std::any_of(tracks.begin(), tracks.end(), [&file](const File& existingFile)
+        {
+            return existingFile.getFullPathName() == file.getFullPathName();
+        });
+
+        if (!exists)
+        {
+            tracks.push_back(file);
+            ++numAdded;
+        }
+    }
+
+    return numAdded;
+}
+
+bool TrackCollection::remove(const File& track)
+{
+    auto end = std::remove(tracks.begin(), tracks.end(), track);
+
+    if (end == tracks.end())
+        return false;
+
+    tracks.erase(end, tracks.end());
+    return true;
+}
+
+std::vector<File> TrackCollection::search(const String& text) const
+{
+    auto searchText = text.trim();
+
+    if (searchText.isEmpty())
+        return tracks;
+
+    std::vector<File> found;
+
+    for (const auto& track : tracks)
+        if (track.getFileNameWithoutExtension().containsIgnoreCase(searchText))
+            found.push_back(track);
+
+    return found;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    TrackCollection.h
+    Created: 23 Oct 2026 5:06:39pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    The library's list of tracks, kept in a text file with one full path per
+    line. MusicLibrary shows and edits it; batch tools can read it without a
+    window.
+*/
+class TrackCollection
+{
+public:
+    /** Documents/music_library.txt */
+    static File getDefaultFile();
+
+    explicit TrackCollection(const File& libraryFile = getDefaultFile());
+
+    /** reads the list, leaving out tracks that no longer exist */
+    void load();
+    /** writes the list back; false if the file couldn't be written */
+    bool save() const;
+
+    /** adds the tracks that aren't in the list yet; returns how many were */
+    int add(const Array<File>& files);
+    /** false if the track wasn't in the list */
+    bool remove(const File& track);
+
+    const std::vector<File>& getTracks() const { return tracks; }
+    /** the tracks whose name contains the text, or all of them for empty text */
+    std::vector<File> search(const String& text) const;
+
+    const File& getLibraryFile() const { return libraryFile; }
+
+private:
+    File libraryFile;
+    std::vector<File> tracks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackCollection)
+};
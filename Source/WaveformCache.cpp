@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    WaveformCache.cpp
+    Created: 24 Oct 2026 4:47:23pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#include "WaveformCache.h"
+#include "Tracer.h"
+
+WaveformCache::WaveformCache(int _maxThumbsInMemory)
+    : AudioThumbnailCache(_maxThumbsInMemory),
+      MemoryBudget::Consumer("Waveforms", MemoryBudget::Cost::reload),
+      folder(File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecks Waveform Cache")),
+      maxThumbsInMemory(_maxThumbsInMemory)
+{
+    folder.createDirectory();
+    addToBudget();
+}
+
+WaveformCache::~WaveformCache()
+{
+    removeFromBudget();
+}
+
+File WaveformCache::getFileFor(int64 hashCode) const
+{
+    return folder.getChildFile(String::toHexString(hashCode) + ".thumb");
+}
+
+void WaveformCache::saveNewlyFinishedThumbnail(const AudioThumbnailBase& thumbnail, int64 hashCode)
+{
+    TRACE_SPAN("WaveformCache::save");
+
+    // written beside it and renamed, so a reader never sees half a file
+    TemporaryFile temp(getFileFor(hashCode));
+
+    {
+        FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+            return;
+
+        thumbnail.saveTo(out);
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        return;
+
+    trimFolder();
+
+    // the file holds what the base class keeps in memory, byte for byte
+    const ScopedLock sl(sizesLock);
+    auto numBytes = (size_t) getFileFor(hashCode).getSize();
+
+    for (auto it = sizes.begin(); it != sizes.end(); ++it)
+    {
+        if (it->first == hashCode)
+        {
+            usedBytes -= (int64) it->second;
+            sizes.erase(it);
+            break;
+        }
+    }
+
+    sizes.push_back({ hashCode, numBytes });
+    usedBytes += (int64) numBytes;
+
+    if ((int) sizes.size() > maxThumbsInMemory)
+    {
+        usedBytes -= (int64) sizes.front().second;
+        sizes.erase(sizes.begin());
+    }
+}
+
+size_t WaveformCache::evict(size_t numBytes)
+{
+    size_t freed = 0;
+
+    while (freed < numBytes)
+    {
+        std::pair<int64, size_t> oldest;
+
+        {
+            const ScopedLock sl(sizesLock);
+
+            if (sizes.empty())
+                break;
+
+            oldest = sizes.front();
+            sizes.erase(sizes.begin());
+            usedBytes -= (int64) oldest.second;
+        }
+
+        // outside our lock, as the base class calls saveNewlyFinishedThumbnail holding its own
+        removeThumb(oldest.first);
+        freed += oldest.second;
+    }
+
+    return freed;
+}
+
+bool WaveformCache::loadNewThumb(AudioThumbnailBase& thumbnail, int64 hashCode)
+{
+    TRACE_SPAN("WaveformCache::load");
+
+    auto file = getFileFor(hashCode);
+    FileInputStream in(file);
+
+    if (!in.openedOk() || !thumbnail.loadFrom(in))
+        return false;
+
+    file.setLastModificationTime(Time::getCurrentTime()); // used again, so kept longer
+    return true;
+}
+
+void WaveformCache::trimFolder()
+{
+    auto files = folder.findChildFiles(File::findFiles, false, "*.thumb");
+
+    if (files.size() <= maxFiles)
+        return;
+
+    std::sort(files.begin(), files.end(), [](const File& a, const File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (int i = 0; i < files.size() - maxFiles; ++i)
+        files.getReference(i).deleteFile();
+}
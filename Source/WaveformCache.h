@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    WaveformCache.h
+    Created: 24 Oct 2026 4:47:23pm
+    Author:  aftab
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MemoryBudget.h"
+
+//==============================================================================
+/*
+    An AudioThumbnailCache that also keeps every finished waveform on disk,
+    one small file each in the temp folder, so a track's waveform is back as
+    soon as it's loaded again, after a restart too, instead of being rebuilt
+    from a full read of the track.
+
+    Files are written from the cache's own thread as each thumbnail finishes
+    and read on the message thread when one is asked for that isn't in
+    memory. The folder is kept to maxFiles, least recently used first.
+
+    What's held in memory is counted in the memory budget as the cheapest
+    kind to evict, since every thumbnail in it is also on disk.
+*/
+class WaveformCache : public AudioThumbnailCache,
+                      private MemoryBudget::Consumer
+{
+public:
+    explicit WaveformCache(int maxThumbsInMemory);
+    ~WaveformCache() override;
+
+    static constexpr int maxFiles = 500;
+
+    size_t getUsedBytes() const override { return (size_t) usedBytes.load(); }
+    size_t getEvictableBytes() const override { return getUsedBytes(); }
+    /** oldest first */
+    size_t evict(size_t numBytes) override;
+
+protected:
+    void saveNewlyFinishedThumbnail(const AudioThumbnailBase& thumbnail, int64 hashCode) override;
+    bool loadNewThumb(AudioThumbnailBase& thumbnail, int64 hashCode) override;
+
+private:
+    File getFileFor(int64 hashCode) const;
+    void trimFolder();
+
+    const File folder;
+    const int maxThumbsInMemory;
+
+    // the base class's entries as we last saw them stored, oldest first; it drops the
+    // oldest itself once it holds maxThumbsInMemory
+    CriticalSection sizesLock;
+    std::vector<std::pair<int64, size_t>> sizes;
+    std::atomic<int64> usedBytes{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformCache)
+};